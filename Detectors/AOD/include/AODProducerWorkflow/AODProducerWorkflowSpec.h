@@ -160,6 +160,7 @@ class AODProducerWorkflowDPL : public Task
   int mTruncate{1};
   int mRecoOnly{0};
   bool mFillSVertices{false};
+  int mNThreads{1};
   TStopwatch mTimer;
 
   std::shared_ptr<DataRequest> mDataRequest;
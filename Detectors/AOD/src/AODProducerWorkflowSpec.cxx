@@ -40,9 +40,14 @@
 #include "FT0Base/Geometry.h"
 #include "TMath.h"
 #include "MathUtils/Utils.h"
+#include <array>
+#include <functional>
 #include <map>
 #include <unordered_map>
 #include <vector>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::framework;
 using namespace o2::math_utils::detail;
@@ -346,6 +351,7 @@ void AODProducerWorkflowDPL::init(InitContext& ic)
   mTFNumber = ic.options().get<int64_t>("aod-timeframe-id");
   mRecoOnly = ic.options().get<int>("reco-mctracks-only");
   mTruncate = ic.options().get<int>("enable-truncation");
+  mNThreads = std::max(1, ic.options().get<int>("threads"));
 
   if (mTFNumber == -1L) {
     LOG(INFO) << "TFNumber will be obtained from CCDB";
@@ -556,232 +562,21 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
             dummyTime,
             dummyTime);
 
-  // TODO: figure out collision weight
-  // keep track event/source id for each mc-collision
-  std::vector<std::pair<int, int>> mccolid_to_eventandsource;
-
-  float mcColWeight = 1.;
-  // filling mcCollision table
-  int index = 0;
-  int mccolindex = 0;
-  for (auto& rec : mcRecords) {
-    auto time = rec.getTimeNS();
-    uint64_t globalBC = rec.toLong();
-    auto item = bcsMap.find(globalBC);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(FATAL) << "Error: could not find a corresponding BC ID for MC collision; BC = " << globalBC << ", index = " << index;
-    }
-    auto& colParts = mcParts[index];
-    for (auto colPart : colParts) {
-      auto eventID = colPart.entryID;
-      auto sourceID = colPart.sourceID;
-      // FIXME:
-      // use generators' names for generatorIDs (?)
-      short generatorID = sourceID;
-      auto& header = mcReader.getMCEventHeader(sourceID, eventID);
-      mcCollisionsCursor(0,
-                         bcID,
-                         generatorID,
-                         truncateFloatFraction(header.GetX(), mCollisionPosition),
-                         truncateFloatFraction(header.GetY(), mCollisionPosition),
-                         truncateFloatFraction(header.GetZ(), mCollisionPosition),
-                         truncateFloatFraction(time, mCollisionPosition),
-                         truncateFloatFraction(mcColWeight, mCollisionPosition),
-                         header.GetB());
-      mccolid_to_eventandsource.emplace_back(std::pair<int, int>(eventID, sourceID));
-    }
-    index++;
-  }
-
-  // vector of FT0 amplitudes
-  int nFT0Channels = o2::ft0::Geometry::Nchannels;
-  int nFT0ChannelsAside = o2::ft0::Geometry::NCellsA * 4;
-  std::vector<float> vAmplitudes(nFT0Channels, 0.);
-  // filling FT0 table
-  for (auto& ft0RecPoint : ft0RecPoints) {
-    const auto channelData = ft0RecPoint.getBunchChannelData(ft0ChData);
-    // TODO: switch to calibrated amplitude
-    for (auto& channel : channelData) {
-      vAmplitudes[channel.ChId] = channel.QTCAmpl; // amplitude, mV
-    }
-    float aAmplitudesA[nFT0ChannelsAside];
-    float aAmplitudesC[133];
-    for (int i = 0; i < nFT0Channels; i++) {
-      if (i < nFT0ChannelsAside) {
-        aAmplitudesA[i] = truncateFloatFraction(vAmplitudes[i], mT0Amplitude);
-      } else {
-        aAmplitudesC[i - nFT0ChannelsAside] = truncateFloatFraction(vAmplitudes[i], mT0Amplitude);
-      }
-    }
-    uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
-    uint64_t bc = globalBC;
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(FATAL) << "Error: could not find a corresponding BC ID for a FT0 rec. point; BC = " << bc;
-    }
-    ft0Cursor(0,
-              bcID,
-              aAmplitudesA,
-              aAmplitudesC,
-              truncateFloatFraction(ft0RecPoint.getCollisionTimeA() / 1E3, mT0Time), // ps to ns
-              truncateFloatFraction(ft0RecPoint.getCollisionTimeC() / 1E3, mT0Time), // ps to ns
-              ft0RecPoint.getTrigger().triggersignals);
-  }
-
-  // filling MC collision labels
-  for (auto& label : primVerLabels) {
-    int32_t mcCollisionID = label.getEventID();
-    uint16_t mcMask = 0; // todo: set mask using normalized weights?
-    mcColLabelsCursor(0, mcCollisionID, mcMask);
-  }
-
-  // filling unassigned tracks first
-  // so that all unassigned tracks are stored in the beginning of the table together
-  auto& trackRefU = primVer2TRefs.back(); // references to unassigned tracks are at the end
-  for (int src = GIndex::NSources; src--;) {
-    int start = trackRefU.getFirstEntryOfSource(src);
-    int end = start + trackRefU.getEntriesOfSource(src);
-    LOG(DEBUG) << "Unassigned tracks: src = " << src << ", start = " << start << ", end = " << end;
-    for (int ti = start; ti < end; ti++) {
-      extraInfoHolder.tpcInnerParam = 0.f;
-      extraInfoHolder.flags = 0;
-      extraInfoHolder.itsClusterMap = 0;
-      extraInfoHolder.tpcNClsFindable = 0;
-      extraInfoHolder.tpcNClsFindableMinusFound = 0;
-      extraInfoHolder.tpcNClsFindableMinusCrossedRows = 0;
-      extraInfoHolder.tpcNClsShared = 0;
-      extraInfoHolder.trdPattern = 0;
-      extraInfoHolder.itsChi2NCl = -999.f;
-      extraInfoHolder.tpcChi2NCl = -999.f;
-      extraInfoHolder.trdChi2 = -999.f;
-      extraInfoHolder.tofChi2 = -999.f;
-      extraInfoHolder.tpcSignal = -999.f;
-      extraInfoHolder.trdSignal = -999.f;
-      extraInfoHolder.tofSignal = -999.f;
-      extraInfoHolder.length = -999.f;
-      extraInfoHolder.tofExpMom = -999.f;
-      extraInfoHolder.trackEtaEMCAL = -999.f;
-      extraInfoHolder.trackPhiEMCAL = -999.f;
-      auto& trackIndex = primVerGIs[ti];
-      if (src == GIndex::Source::ITS && mFillTracksITS) {
-        const auto& track = tracksITS[trackIndex.getIndex()];
-        isStoredITS[trackIndex.getIndex()] = true;
-        // extra info
-        extraInfoHolder.itsClusterMap = track.getPattern();
-        // track
-        addToTracksTable(tracksCursor, tracksCovCursor, track, -1, src);
-        addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
-      }
-      if (src == GIndex::Source::TPC && mFillTracksTPC) {
-        const auto& track = tracksTPC[trackIndex.getIndex()];
-        isStoredTPC[trackIndex.getIndex()] = true;
-        // extra info
-        extraInfoHolder.tpcChi2NCl = track.getNClusters() ? track.getChi2() / track.getNClusters() : 0;
-        extraInfoHolder.tpcSignal = track.getdEdx().dEdxTotTPC;
-        extraInfoHolder.tpcNClsFindable = track.getNClusters();
-        // track
-        addToTracksTable(tracksCursor, tracksCovCursor, track, -1, src);
-        addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
-      }
-      if (src == GIndex::Source::ITSTPC && mFillTracksITSTPC) {
-        const auto& track = tracksITSTPC[trackIndex.getIndex()];
-        auto contributorsGID = recoData.getSingleDetectorRefs(trackIndex);
-        // extra info from sub-tracks
-        if (contributorsGID[GIndex::Source::ITS].isIndexSet()) {
-          isStoredITS[track.getRefITS()] = true;
-          const auto& itsOrig = recoData.getITSTrack(contributorsGID[GIndex::ITS]);
-          extraInfoHolder.itsClusterMap = itsOrig.getPattern();
-        }
-        if (contributorsGID[GIndex::Source::TPC].isIndexSet()) {
-          isStoredTPC[track.getRefTPC()] = true;
-          const auto& tpcOrig = recoData.getTPCTrack(contributorsGID[GIndex::TPC]);
-          extraInfoHolder.tpcChi2NCl = tpcOrig.getNClusters() ? tpcOrig.getChi2() / tpcOrig.getNClusters() : 0;
-          extraInfoHolder.tpcSignal = tpcOrig.getdEdx().dEdxTotTPC;
-          extraInfoHolder.tpcNClsFindable = tpcOrig.getNClusters();
-        }
-        addToTracksTable(tracksCursor, tracksCovCursor, track, -1, src);
-        addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
-      }
-      if (src == GIndex::Source::ITSTPCTOF && mFillTracksITSTPC) {
-        auto contributorsGID = recoData.getSingleDetectorRefs(trackIndex);
-        const auto& track = recoData.getITSTPCTOFTrack(contributorsGID[GIndex::Source::ITSTPCTOF]);
-        const auto& tofMatch = recoData.getTOFMatch(contributorsGID[GIndex::Source::ITSTPCTOF]);
-        extraInfoHolder.tofChi2 = tofMatch.getChi2();
-        const auto& tofInt = tofMatch.getLTIntegralOut();
-        extraInfoHolder.tofSignal = tofInt.getTOF(0); // fixme: what id should be used here?
-        extraInfoHolder.length = tofInt.getL();
-        // extra info from sub-tracks
-        if (contributorsGID[GIndex::Source::ITS].isIndexSet()) {
-          isStoredITS[track.getRefITS()] = true;
-          const auto& itsOrig = recoData.getITSTrack(contributorsGID[GIndex::ITS]);
-          extraInfoHolder.itsClusterMap = itsOrig.getPattern();
-        }
-        if (contributorsGID[GIndex::Source::TPC].isIndexSet()) {
-          isStoredTPC[track.getRefTPC()] = true;
-          const auto& tpcOrig = recoData.getTPCTrack(contributorsGID[GIndex::TPC]);
-          extraInfoHolder.tpcChi2NCl = tpcOrig.getNClusters() ? tpcOrig.getChi2() / tpcOrig.getNClusters() : 0;
-          extraInfoHolder.tpcSignal = tpcOrig.getdEdx().dEdxTotTPC;
-          extraInfoHolder.tpcNClsFindable = tpcOrig.getNClusters();
-        }
-        addToTracksTable(tracksCursor, tracksCovCursor, track, -1, src);
-        addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
-      }
-      if (src == GIndex::Source::MFT && mFillTracksMFT) {
-        const auto& track = tracksMFT[trackIndex.getIndex()];
-        isStoredMFT[trackIndex.getIndex()] = true;
-        addToMFTTracksTable(mftTracksCursor, track, -1);
-      }
-    }
-  }
-
-  // filling collisions table
-  int collisionID = 0;
-  for (auto& vertex : primVertices) {
-    auto& cov = vertex.getCov();
-    auto& timeStamp = vertex.getTimeStamp();
-    double tsTimeStamp = timeStamp.getTimeStamp() * 1E3; // mus to ns
-    uint64_t globalBC = std::round(tsTimeStamp / o2::constants::lhc::LHCBunchSpacingNS);
-    LOG(DEBUG) << globalBC << " " << tsTimeStamp;
-    // collision timestamp in ns wrt the beginning of collision BC
-    tsTimeStamp = globalBC * o2::constants::lhc::LHCBunchSpacingNS - tsTimeStamp;
-    auto item = bcsMap.find(globalBC);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(FATAL) << "Error: could not find a corresponding BC ID for a collision; BC = " << globalBC << ", collisionID = " << collisionID;
-    }
-    // TODO: get real collision time mask
-    int collisionTimeMask = 0;
-    collisionsCursor(0,
-                     bcID,
-                     truncateFloatFraction(vertex.getX(), mCollisionPosition),
-                     truncateFloatFraction(vertex.getY(), mCollisionPosition),
-                     truncateFloatFraction(vertex.getZ(), mCollisionPosition),
-                     truncateFloatFraction(cov[0], mCollisionPositionCov),
-                     truncateFloatFraction(cov[1], mCollisionPositionCov),
-                     truncateFloatFraction(cov[2], mCollisionPositionCov),
-                     truncateFloatFraction(cov[3], mCollisionPositionCov),
-                     truncateFloatFraction(cov[4], mCollisionPositionCov),
-                     truncateFloatFraction(cov[5], mCollisionPositionCov),
-                     vertex.getFlags(),
-                     truncateFloatFraction(vertex.getChi2(), mCollisionPositionCov),
-                     vertex.getNContributors(),
-                     truncateFloatFraction(tsTimeStamp, mCollisionPosition),
-                     truncateFloatFraction(timeStamp.getTimeStampError() * 1E3, mCollisionPositionCov),
-                     collisionTimeMask);
-    auto& trackRef = primVer2TRefs[collisionID];
+  // The tables below are split in groups, each owning its builders and
+  // filled in the same order as in a serial run, so that the content of the
+  // tables does not depend on the number of threads. The MC tables stay in
+  // one group, as the kinematics reader is not thread safe. The MC particles
+  // depend on the isStored flags set while filling the tracks, so the MC
+  // group runs after the tracks in the same task, and only the detector
+  // tables run concurrently to them.
+  auto fillTracks = [&]() {
+    // filling unassigned tracks first
+    // so that all unassigned tracks are stored in the beginning of the table together
+    auto& trackRefU = primVer2TRefs.back(); // references to unassigned tracks are at the end
     for (int src = GIndex::NSources; src--;) {
-      int start = trackRef.getFirstEntryOfSource(src);
-      int end = start + trackRef.getEntriesOfSource(src);
-      LOG(DEBUG) << " ====> Collision " << collisionID << " ; src = " << src << " : ntracks = " << end - start;
-      LOG(DEBUG) << "start = " << start << ", end = " << end;
+      int start = trackRefU.getFirstEntryOfSource(src);
+      int end = start + trackRefU.getEntriesOfSource(src);
+      LOG(DEBUG) << "Unassigned tracks: src = " << src << ", start = " << start << ", end = " << end;
       for (int ti = start; ti < end; ti++) {
         extraInfoHolder.tpcInnerParam = 0.f;
         extraInfoHolder.flags = 0;
@@ -809,7 +604,7 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
           // extra info
           extraInfoHolder.itsClusterMap = track.getPattern();
           // track
-          addToTracksTable(tracksCursor, tracksCovCursor, track, collisionID, src);
+          addToTracksTable(tracksCursor, tracksCovCursor, track, -1, src);
           addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
         }
         if (src == GIndex::Source::TPC && mFillTracksTPC) {
@@ -820,7 +615,7 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
           extraInfoHolder.tpcSignal = track.getdEdx().dEdxTotTPC;
           extraInfoHolder.tpcNClsFindable = track.getNClusters();
           // track
-          addToTracksTable(tracksCursor, tracksCovCursor, track, collisionID, src);
+          addToTracksTable(tracksCursor, tracksCovCursor, track, -1, src);
           addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
         }
         if (src == GIndex::Source::ITSTPC && mFillTracksITSTPC) {
@@ -839,7 +634,7 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
             extraInfoHolder.tpcSignal = tpcOrig.getdEdx().dEdxTotTPC;
             extraInfoHolder.tpcNClsFindable = tpcOrig.getNClusters();
           }
-          addToTracksTable(tracksCursor, tracksCovCursor, track, collisionID, src);
+          addToTracksTable(tracksCursor, tracksCovCursor, track, -1, src);
           addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
         }
         if (src == GIndex::Source::ITSTPCTOF && mFillTracksITSTPC) {
@@ -863,159 +658,395 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
             extraInfoHolder.tpcSignal = tpcOrig.getdEdx().dEdxTotTPC;
             extraInfoHolder.tpcNClsFindable = tpcOrig.getNClusters();
           }
-          addToTracksTable(tracksCursor, tracksCovCursor, track, collisionID, src);
+          addToTracksTable(tracksCursor, tracksCovCursor, track, -1, src);
           addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
         }
         if (src == GIndex::Source::MFT && mFillTracksMFT) {
           const auto& track = tracksMFT[trackIndex.getIndex()];
           isStoredMFT[trackIndex.getIndex()] = true;
-          addToMFTTracksTable(mftTracksCursor, track, collisionID);
+          addToMFTTracksTable(mftTracksCursor, track, -1);
         }
       }
     }
-    collisionID++;
-  }
-
-  // filling BC table
-  // TODO: get real triggerMask
-  uint64_t triggerMask = 1;
-  for (auto& item : bcsMap) {
-    uint64_t bc = item.first;
-    bcCursor(0,
-             runNumber,
-             bc,
-             triggerMask);
-  }
-
-  bcsMap.clear();
-
-  // filling mc particles table
-  TripletsMap_t toStore;
-  fillMCParticlesTable(mcReader, mcParticlesCursor,
-                       tracksITSMCTruth, isStoredITS,
-                       tracksMFTMCTruth, isStoredMFT,
-                       tracksTPCMCTruth, isStoredTPC,
-                       toStore, mccolid_to_eventandsource);
-
-  isStoredITS.clear();
-  isStoredMFT.clear();
-  isStoredTPC.clear();
-
-  // ------------------------------------------------------
-  // filling track labels
 
-  // labelMask (temporary) usage:
-  //   bit 13 -- ITS and TPC labels are not equal
-  //   bit 14 -- isNoise() == true
-  //   bit 15 -- isFake() == true
-  // labelID = std::numeric_limits<uint32_t>::max() -- label is not set
-
-  uint32_t labelID;
-  uint32_t labelITS;
-  uint32_t labelTPC;
-  uint16_t labelMask;
-  uint8_t mftLabelMask;
-
-  // need to go through labels in the same order as for tracks
-  for (auto& trackRef : primVer2TRefs) {
-    for (int src = GIndex::NSources; src--;) {
-      int start = trackRef.getFirstEntryOfSource(src);
-      int end = start + trackRef.getEntriesOfSource(src);
-      for (int ti = start; ti < end; ti++) {
-        auto& trackIndex = primVerGIs[ti];
-        labelID = std::numeric_limits<uint32_t>::max();
-        labelITS = labelID;
-        labelTPC = labelID;
-        labelMask = 0;
-        mftLabelMask = 0;
-        // its labels
-        if (src == GIndex::Source::ITS && mFillTracksITS) {
-          auto& mcTruthITS = tracksITSMCTruth[trackIndex.getIndex()];
-          if (mcTruthITS.isValid()) {
-            labelID = toStore.at(Triplet_t(mcTruthITS.getSourceID(), mcTruthITS.getEventID(), mcTruthITS.getTrackID()));
-          }
-          if (mcTruthITS.isFake()) {
-            labelMask |= (0x1 << 15);
+    // filling collisions table
+    int collisionID = 0;
+    for (auto& vertex : primVertices) {
+      auto& cov = vertex.getCov();
+      auto& timeStamp = vertex.getTimeStamp();
+      double tsTimeStamp = timeStamp.getTimeStamp() * 1E3; // mus to ns
+      uint64_t globalBC = std::round(tsTimeStamp / o2::constants::lhc::LHCBunchSpacingNS);
+      LOG(DEBUG) << globalBC << " " << tsTimeStamp;
+      // collision timestamp in ns wrt the beginning of collision BC
+      tsTimeStamp = globalBC * o2::constants::lhc::LHCBunchSpacingNS - tsTimeStamp;
+      auto item = bcsMap.find(globalBC);
+      int bcID = -1;
+      if (item != bcsMap.end()) {
+        bcID = item->second;
+      } else {
+        LOG(FATAL) << "Error: could not find a corresponding BC ID for a collision; BC = " << globalBC << ", collisionID = " << collisionID;
+      }
+      // TODO: get real collision time mask
+      int collisionTimeMask = 0;
+      collisionsCursor(0,
+                       bcID,
+                       truncateFloatFraction(vertex.getX(), mCollisionPosition),
+                       truncateFloatFraction(vertex.getY(), mCollisionPosition),
+                       truncateFloatFraction(vertex.getZ(), mCollisionPosition),
+                       truncateFloatFraction(cov[0], mCollisionPositionCov),
+                       truncateFloatFraction(cov[1], mCollisionPositionCov),
+                       truncateFloatFraction(cov[2], mCollisionPositionCov),
+                       truncateFloatFraction(cov[3], mCollisionPositionCov),
+                       truncateFloatFraction(cov[4], mCollisionPositionCov),
+                       truncateFloatFraction(cov[5], mCollisionPositionCov),
+                       vertex.getFlags(),
+                       truncateFloatFraction(vertex.getChi2(), mCollisionPositionCov),
+                       vertex.getNContributors(),
+                       truncateFloatFraction(tsTimeStamp, mCollisionPosition),
+                       truncateFloatFraction(timeStamp.getTimeStampError() * 1E3, mCollisionPositionCov),
+                       collisionTimeMask);
+      auto& trackRef = primVer2TRefs[collisionID];
+      for (int src = GIndex::NSources; src--;) {
+        int start = trackRef.getFirstEntryOfSource(src);
+        int end = start + trackRef.getEntriesOfSource(src);
+        LOG(DEBUG) << " ====> Collision " << collisionID << " ; src = " << src << " : ntracks = " << end - start;
+        LOG(DEBUG) << "start = " << start << ", end = " << end;
+        for (int ti = start; ti < end; ti++) {
+          extraInfoHolder.tpcInnerParam = 0.f;
+          extraInfoHolder.flags = 0;
+          extraInfoHolder.itsClusterMap = 0;
+          extraInfoHolder.tpcNClsFindable = 0;
+          extraInfoHolder.tpcNClsFindableMinusFound = 0;
+          extraInfoHolder.tpcNClsFindableMinusCrossedRows = 0;
+          extraInfoHolder.tpcNClsShared = 0;
+          extraInfoHolder.trdPattern = 0;
+          extraInfoHolder.itsChi2NCl = -999.f;
+          extraInfoHolder.tpcChi2NCl = -999.f;
+          extraInfoHolder.trdChi2 = -999.f;
+          extraInfoHolder.tofChi2 = -999.f;
+          extraInfoHolder.tpcSignal = -999.f;
+          extraInfoHolder.trdSignal = -999.f;
+          extraInfoHolder.tofSignal = -999.f;
+          extraInfoHolder.length = -999.f;
+          extraInfoHolder.tofExpMom = -999.f;
+          extraInfoHolder.trackEtaEMCAL = -999.f;
+          extraInfoHolder.trackPhiEMCAL = -999.f;
+          auto& trackIndex = primVerGIs[ti];
+          if (src == GIndex::Source::ITS && mFillTracksITS) {
+            const auto& track = tracksITS[trackIndex.getIndex()];
+            isStoredITS[trackIndex.getIndex()] = true;
+            // extra info
+            extraInfoHolder.itsClusterMap = track.getPattern();
+            // track
+            addToTracksTable(tracksCursor, tracksCovCursor, track, collisionID, src);
+            addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
           }
-          if (mcTruthITS.isNoise()) {
-            labelMask |= (0x1 << 14);
+          if (src == GIndex::Source::TPC && mFillTracksTPC) {
+            const auto& track = tracksTPC[trackIndex.getIndex()];
+            isStoredTPC[trackIndex.getIndex()] = true;
+            // extra info
+            extraInfoHolder.tpcChi2NCl = track.getNClusters() ? track.getChi2() / track.getNClusters() : 0;
+            extraInfoHolder.tpcSignal = track.getdEdx().dEdxTotTPC;
+            extraInfoHolder.tpcNClsFindable = track.getNClusters();
+            // track
+            addToTracksTable(tracksCursor, tracksCovCursor, track, collisionID, src);
+            addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
           }
-          mcTrackLabelCursor(0,
-                             labelID,
-                             labelMask);
-        }
-        // tpc labels
-        if (src == GIndex::Source::TPC && mFillTracksTPC) {
-          auto& mcTruthTPC = tracksTPCMCTruth[trackIndex.getIndex()];
-          if (mcTruthTPC.isValid()) {
-            labelID = toStore.at(Triplet_t(mcTruthTPC.getSourceID(), mcTruthTPC.getEventID(), mcTruthTPC.getTrackID()));
+          if (src == GIndex::Source::ITSTPC && mFillTracksITSTPC) {
+            const auto& track = tracksITSTPC[trackIndex.getIndex()];
+            auto contributorsGID = recoData.getSingleDetectorRefs(trackIndex);
+            // extra info from sub-tracks
+            if (contributorsGID[GIndex::Source::ITS].isIndexSet()) {
+              isStoredITS[track.getRefITS()] = true;
+              const auto& itsOrig = recoData.getITSTrack(contributorsGID[GIndex::ITS]);
+              extraInfoHolder.itsClusterMap = itsOrig.getPattern();
+            }
+            if (contributorsGID[GIndex::Source::TPC].isIndexSet()) {
+              isStoredTPC[track.getRefTPC()] = true;
+              const auto& tpcOrig = recoData.getTPCTrack(contributorsGID[GIndex::TPC]);
+              extraInfoHolder.tpcChi2NCl = tpcOrig.getNClusters() ? tpcOrig.getChi2() / tpcOrig.getNClusters() : 0;
+              extraInfoHolder.tpcSignal = tpcOrig.getdEdx().dEdxTotTPC;
+              extraInfoHolder.tpcNClsFindable = tpcOrig.getNClusters();
+            }
+            addToTracksTable(tracksCursor, tracksCovCursor, track, collisionID, src);
+            addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
           }
-          if (mcTruthTPC.isFake()) {
-            labelMask |= (0x1 << 15);
+          if (src == GIndex::Source::ITSTPCTOF && mFillTracksITSTPC) {
+            auto contributorsGID = recoData.getSingleDetectorRefs(trackIndex);
+            const auto& track = recoData.getITSTPCTOFTrack(contributorsGID[GIndex::Source::ITSTPCTOF]);
+            const auto& tofMatch = recoData.getTOFMatch(contributorsGID[GIndex::Source::ITSTPCTOF]);
+            extraInfoHolder.tofChi2 = tofMatch.getChi2();
+            const auto& tofInt = tofMatch.getLTIntegralOut();
+            extraInfoHolder.tofSignal = tofInt.getTOF(0); // fixme: what id should be used here?
+            extraInfoHolder.length = tofInt.getL();
+            // extra info from sub-tracks
+            if (contributorsGID[GIndex::Source::ITS].isIndexSet()) {
+              isStoredITS[track.getRefITS()] = true;
+              const auto& itsOrig = recoData.getITSTrack(contributorsGID[GIndex::ITS]);
+              extraInfoHolder.itsClusterMap = itsOrig.getPattern();
+            }
+            if (contributorsGID[GIndex::Source::TPC].isIndexSet()) {
+              isStoredTPC[track.getRefTPC()] = true;
+              const auto& tpcOrig = recoData.getTPCTrack(contributorsGID[GIndex::TPC]);
+              extraInfoHolder.tpcChi2NCl = tpcOrig.getNClusters() ? tpcOrig.getChi2() / tpcOrig.getNClusters() : 0;
+              extraInfoHolder.tpcSignal = tpcOrig.getdEdx().dEdxTotTPC;
+              extraInfoHolder.tpcNClsFindable = tpcOrig.getNClusters();
+            }
+            addToTracksTable(tracksCursor, tracksCovCursor, track, collisionID, src);
+            addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
           }
-          if (mcTruthTPC.isNoise()) {
-            labelMask |= (0x1 << 14);
+          if (src == GIndex::Source::MFT && mFillTracksMFT) {
+            const auto& track = tracksMFT[trackIndex.getIndex()];
+            isStoredMFT[trackIndex.getIndex()] = true;
+            addToMFTTracksTable(mftTracksCursor, track, collisionID);
           }
-          mcTrackLabelCursor(0,
-                             labelID,
-                             labelMask);
         }
-        // its-tpc labels and its-tpc-tof labels
-        // todo:
-        //  probably need to store both its and tpc labels
-        //  for now filling only TPC label
-        if ((src == GIndex::Source::ITSTPC || src == GIndex::Source::ITSTPCTOF) && mFillTracksITSTPC) {
-          auto contributorsGID = recoData.getSingleDetectorRefs(trackIndex);
-          auto& mcTruthITS = tracksITSMCTruth[contributorsGID[GIndex::Source::ITS].getIndex()];
-          auto& mcTruthTPC = tracksTPCMCTruth[contributorsGID[GIndex::Source::TPC].getIndex()];
-          // its-contributor label
-          if (contributorsGID[GIndex::Source::ITS].isIndexSet()) {
+      }
+      collisionID++;
+    }
+  };
+
+  auto fillDetectors = [&]() {
+    // vector of FT0 amplitudes
+    int nFT0Channels = o2::ft0::Geometry::Nchannels;
+    int nFT0ChannelsAside = o2::ft0::Geometry::NCellsA * 4;
+    std::vector<float> vAmplitudes(nFT0Channels, 0.);
+    // filling FT0 table
+    for (auto& ft0RecPoint : ft0RecPoints) {
+      const auto channelData = ft0RecPoint.getBunchChannelData(ft0ChData);
+      // TODO: switch to calibrated amplitude
+      for (auto& channel : channelData) {
+        vAmplitudes[channel.ChId] = channel.QTCAmpl; // amplitude, mV
+      }
+      float aAmplitudesA[nFT0ChannelsAside];
+      float aAmplitudesC[133];
+      for (int i = 0; i < nFT0Channels; i++) {
+        if (i < nFT0ChannelsAside) {
+          aAmplitudesA[i] = truncateFloatFraction(vAmplitudes[i], mT0Amplitude);
+        } else {
+          aAmplitudesC[i - nFT0ChannelsAside] = truncateFloatFraction(vAmplitudes[i], mT0Amplitude);
+        }
+      }
+      uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
+      uint64_t bc = globalBC;
+      auto item = bcsMap.find(bc);
+      int bcID = -1;
+      if (item != bcsMap.end()) {
+        bcID = item->second;
+      } else {
+        LOG(FATAL) << "Error: could not find a corresponding BC ID for a FT0 rec. point; BC = " << bc;
+      }
+      ft0Cursor(0,
+                bcID,
+                aAmplitudesA,
+                aAmplitudesC,
+                truncateFloatFraction(ft0RecPoint.getCollisionTimeA() / 1E3, mT0Time), // ps to ns
+                truncateFloatFraction(ft0RecPoint.getCollisionTimeC() / 1E3, mT0Time), // ps to ns
+                ft0RecPoint.getTrigger().triggersignals);
+    }
+
+    // filling MC collision labels
+    for (auto& label : primVerLabels) {
+      int32_t mcCollisionID = label.getEventID();
+      uint16_t mcMask = 0; // todo: set mask using normalized weights?
+      mcColLabelsCursor(0, mcCollisionID, mcMask);
+    }
+
+    // filling BC table
+    // TODO: get real triggerMask
+    uint64_t triggerMask = 1;
+    for (auto& item : bcsMap) {
+      uint64_t bc = item.first;
+      bcCursor(0,
+               runNumber,
+               bc,
+               triggerMask);
+    }
+  };
+
+  auto fillMC = [&]() {
+    // TODO: figure out collision weight
+    // keep track event/source id for each mc-collision
+    std::vector<std::pair<int, int>> mccolid_to_eventandsource;
+
+    float mcColWeight = 1.;
+    // filling mcCollision table
+    int index = 0;
+    int mccolindex = 0;
+    for (auto& rec : mcRecords) {
+      auto time = rec.getTimeNS();
+      uint64_t globalBC = rec.toLong();
+      auto item = bcsMap.find(globalBC);
+      int bcID = -1;
+      if (item != bcsMap.end()) {
+        bcID = item->second;
+      } else {
+        LOG(FATAL) << "Error: could not find a corresponding BC ID for MC collision; BC = " << globalBC << ", index = " << index;
+      }
+      auto& colParts = mcParts[index];
+      for (auto colPart : colParts) {
+        auto eventID = colPart.entryID;
+        auto sourceID = colPart.sourceID;
+        // FIXME:
+        // use generators' names for generatorIDs (?)
+        short generatorID = sourceID;
+        auto& header = mcReader.getMCEventHeader(sourceID, eventID);
+        mcCollisionsCursor(0,
+                           bcID,
+                           generatorID,
+                           truncateFloatFraction(header.GetX(), mCollisionPosition),
+                           truncateFloatFraction(header.GetY(), mCollisionPosition),
+                           truncateFloatFraction(header.GetZ(), mCollisionPosition),
+                           truncateFloatFraction(time, mCollisionPosition),
+                           truncateFloatFraction(mcColWeight, mCollisionPosition),
+                           header.GetB());
+        mccolid_to_eventandsource.emplace_back(std::pair<int, int>(eventID, sourceID));
+      }
+      index++;
+    }
+
+    // filling mc particles table
+    TripletsMap_t toStore;
+    fillMCParticlesTable(mcReader, mcParticlesCursor,
+                         tracksITSMCTruth, isStoredITS,
+                         tracksMFTMCTruth, isStoredMFT,
+                         tracksTPCMCTruth, isStoredTPC,
+                         toStore, mccolid_to_eventandsource);
+
+    // ------------------------------------------------------
+    // filling track labels
+
+    // labelMask (temporary) usage:
+    //   bit 13 -- ITS and TPC labels are not equal
+    //   bit 14 -- isNoise() == true
+    //   bit 15 -- isFake() == true
+    // labelID = std::numeric_limits<uint32_t>::max() -- label is not set
+
+    uint32_t labelID;
+    uint32_t labelITS;
+    uint32_t labelTPC;
+    uint16_t labelMask;
+    uint8_t mftLabelMask;
+
+    // need to go through labels in the same order as for tracks
+    for (auto& trackRef : primVer2TRefs) {
+      for (int src = GIndex::NSources; src--;) {
+        int start = trackRef.getFirstEntryOfSource(src);
+        int end = start + trackRef.getEntriesOfSource(src);
+        for (int ti = start; ti < end; ti++) {
+          auto& trackIndex = primVerGIs[ti];
+          labelID = std::numeric_limits<uint32_t>::max();
+          labelITS = labelID;
+          labelTPC = labelID;
+          labelMask = 0;
+          mftLabelMask = 0;
+          // its labels
+          if (src == GIndex::Source::ITS && mFillTracksITS) {
+            auto& mcTruthITS = tracksITSMCTruth[trackIndex.getIndex()];
             if (mcTruthITS.isValid()) {
-              labelITS = toStore.at(Triplet_t(mcTruthITS.getSourceID(), mcTruthITS.getEventID(), mcTruthITS.getTrackID()));
+              labelID = toStore.at(Triplet_t(mcTruthITS.getSourceID(), mcTruthITS.getEventID(), mcTruthITS.getTrackID()));
+            }
+            if (mcTruthITS.isFake()) {
+              labelMask |= (0x1 << 15);
+            }
+            if (mcTruthITS.isNoise()) {
+              labelMask |= (0x1 << 14);
             }
+            mcTrackLabelCursor(0,
+                               labelID,
+                               labelMask);
           }
-          if (contributorsGID[GIndex::Source::TPC].isIndexSet()) {
+          // tpc labels
+          if (src == GIndex::Source::TPC && mFillTracksTPC) {
+            auto& mcTruthTPC = tracksTPCMCTruth[trackIndex.getIndex()];
             if (mcTruthTPC.isValid()) {
-              labelTPC = toStore.at(Triplet_t(mcTruthTPC.getSourceID(), mcTruthTPC.getEventID(), mcTruthTPC.getTrackID()));
+              labelID = toStore.at(Triplet_t(mcTruthTPC.getSourceID(), mcTruthTPC.getEventID(), mcTruthTPC.getTrackID()));
             }
+            if (mcTruthTPC.isFake()) {
+              labelMask |= (0x1 << 15);
+            }
+            if (mcTruthTPC.isNoise()) {
+              labelMask |= (0x1 << 14);
+            }
+            mcTrackLabelCursor(0,
+                               labelID,
+                               labelMask);
           }
-          labelID = labelTPC;
-          if (mcTruthITS.isFake() || mcTruthTPC.isFake()) {
-            labelMask |= (0x1 << 15);
-          }
-          if (mcTruthITS.isNoise() || mcTruthTPC.isNoise()) {
-            labelMask |= (0x1 << 14);
-          }
-          if (labelITS != labelTPC) {
-            LOG(DEBUG) << "ITS-TPC MCTruth: labelIDs do not match at " << trackIndex.getIndex();
-            labelMask |= (0x1 << 13);
-          }
-          mcTrackLabelCursor(0,
-                             labelID,
-                             labelMask);
-        }
-        // mft labels
-        // todo: move to a separate table
-        if (src == GIndex::Source::MFT && mFillTracksMFT) {
-          auto& mcTruthMFT = tracksMFTMCTruth[trackIndex.getIndex()];
-          if (mcTruthMFT.isValid()) {
-            labelID = toStore.at(Triplet_t(mcTruthMFT.getSourceID(), mcTruthMFT.getEventID(), mcTruthMFT.getTrackID()));
-          }
-          if (mcTruthMFT.isFake()) {
-            mftLabelMask |= (0x1 << 7);
+          // its-tpc labels and its-tpc-tof labels
+          // todo:
+          //  probably need to store both its and tpc labels
+          //  for now filling only TPC label
+          if ((src == GIndex::Source::ITSTPC || src == GIndex::Source::ITSTPCTOF) && mFillTracksITSTPC) {
+            auto contributorsGID = recoData.getSingleDetectorRefs(trackIndex);
+            auto& mcTruthITS = tracksITSMCTruth[contributorsGID[GIndex::Source::ITS].getIndex()];
+            auto& mcTruthTPC = tracksTPCMCTruth[contributorsGID[GIndex::Source::TPC].getIndex()];
+            // its-contributor label
+            if (contributorsGID[GIndex::Source::ITS].isIndexSet()) {
+              if (mcTruthITS.isValid()) {
+                labelITS = toStore.at(Triplet_t(mcTruthITS.getSourceID(), mcTruthITS.getEventID(), mcTruthITS.getTrackID()));
+              }
+            }
+            if (contributorsGID[GIndex::Source::TPC].isIndexSet()) {
+              if (mcTruthTPC.isValid()) {
+                labelTPC = toStore.at(Triplet_t(mcTruthTPC.getSourceID(), mcTruthTPC.getEventID(), mcTruthTPC.getTrackID()));
+              }
+            }
+            labelID = labelTPC;
+            if (mcTruthITS.isFake() || mcTruthTPC.isFake()) {
+              labelMask |= (0x1 << 15);
+            }
+            if (mcTruthITS.isNoise() || mcTruthTPC.isNoise()) {
+              labelMask |= (0x1 << 14);
+            }
+            if (labelITS != labelTPC) {
+              LOG(DEBUG) << "ITS-TPC MCTruth: labelIDs do not match at " << trackIndex.getIndex();
+              labelMask |= (0x1 << 13);
+            }
+            mcTrackLabelCursor(0,
+                               labelID,
+                               labelMask);
           }
-          if (mcTruthMFT.isNoise()) {
-            mftLabelMask |= (0x1 << 6);
+          // mft labels
+          // todo: move to a separate table
+          if (src == GIndex::Source::MFT && mFillTracksMFT) {
+            auto& mcTruthMFT = tracksMFTMCTruth[trackIndex.getIndex()];
+            if (mcTruthMFT.isValid()) {
+              labelID = toStore.at(Triplet_t(mcTruthMFT.getSourceID(), mcTruthMFT.getEventID(), mcTruthMFT.getTrackID()));
+            }
+            if (mcTruthMFT.isFake()) {
+              mftLabelMask |= (0x1 << 7);
+            }
+            if (mcTruthMFT.isNoise()) {
+              mftLabelMask |= (0x1 << 6);
+            }
+            mcMFTTrackLabelCursor(0,
+                                  labelID,
+                                  mftLabelMask);
           }
-          mcMFTTrackLabelCursor(0,
-                                labelID,
-                                mftLabelMask);
         }
       }
     }
+
+    toStore.clear();
+  };
+
+  auto fillTracksAndMC = [&]() {
+    fillTracks();
+    fillMC();
+  };
+  std::array<std::function<void()>, 2> fillers{fillTracksAndMC, fillDetectors};
+#ifdef WITH_OPENMP
+  omp_set_num_threads(std::min(mNThreads, static_cast<int>(fillers.size())));
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (size_t i = 0; i < fillers.size(); i++) {
+    fillers[i]();
   }
 
-  toStore.clear();
+  bcsMap.clear();
+  isStoredITS.clear();
+  isStoredMFT.clear();
+  isStoredTPC.clear();
 
   pc.outputs().snapshot(Output{"TFN", "TFNumber", 0, Lifetime::Timeframe}, tfNumber);
 
@@ -1070,7 +1101,8 @@ DataProcessorSpec getAODProducerWorkflowSpec(GID::mask_t src, bool useMC, bool f
       ConfigParamSpec{"fill-tracks-its-tpc", VariantType::Int, 1, {"Fill ITS-TPC tracks into tracks table"}},
       ConfigParamSpec{"aod-timeframe-id", VariantType::Int64, -1L, {"Set timeframe number"}},
       ConfigParamSpec{"enable-truncation", VariantType::Int, 1, {"Truncation parameter: 1 -- on, != 1 -- off"}},
-      ConfigParamSpec{"reco-mctracks-only", VariantType::Int, 0, {"Store only reconstructed MC tracks and their mothers/daughters. 0 -- off, != 0 -- on"}}}};
+      ConfigParamSpec{"reco-mctracks-only", VariantType::Int, 0, {"Store only reconstructed MC tracks and their mothers/daughters. 0 -- off, != 0 -- on"}},
+      ConfigParamSpec{"threads", VariantType::Int, 1, {"Number of threads filling independent tables"}}}};
 }
 
 } // namespace o2::aodproducer
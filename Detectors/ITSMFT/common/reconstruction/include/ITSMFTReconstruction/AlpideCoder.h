@@ -233,7 +233,7 @@ class AlpideCoder
             nRightCHits = 0; // reset the buffer
           }
 
-          bool rightC = (row & 0x1) ? !(pixID & 0x1) : (pixID & 0x1); // true for right column / lalse for left
+          bool rightC = (row ^ pixID) & 0x1; // true for right column / false for left
 
           // we want to have hits sorted in column/row, so the hits in right column of given double column
           // are first collected in the temporary buffer
@@ -257,16 +257,17 @@ class AlpideCoder
               chipData.setError(ChipStat::WrongDataLongPattern);
             }
 #endif
-            for (int ip = 0; ip < HitMapSize; ip++) {
-              if (hitsPattern & (0x1 << ip)) {
-                uint16_t addr = pixID + ip + 1, rowE = addr >> 1;
-                rightC = ((rowE & 0x1) ? !(addr & 0x1) : (addr & 0x1)); // true for right column / lalse for left
-                // the real columnt is int colE = colD + rightC;
-                if (rightC) { // same as above
-                  rightColHits[nRightCHits++] = rowE;
-                } else {
-                  addHit(chipData, rowE, colD + rightC); // left column hits are added directly to the container
-                }
+            // loop only over the set bits of the hit map, the hit ip is at the address pixID + ip + 1
+            uint32_t hitMap = hitsPattern & MaskHitMap;
+            while (hitMap) {
+              int ip = __builtin_ctz(hitMap);
+              hitMap &= hitMap - 1;
+              uint16_t addr = pixID + ip + 1, rowE = addr >> 1;
+              // right column if the parities of the row and of the address differ, the real column is colD + rightC
+              if ((rowE ^ addr) & 0x1) {
+                rightColHits[nRightCHits++] = rowE;
+              } else {
+                addHit(chipData, rowE, colD); // left column hits are added directly to the container
               }
             }
           }
@@ -39,6 +39,7 @@ class PayLoadSG
   {
     if (n) {
       mBuffer.emplace_back(ptr, n);
+      mTotalSize += n;
     }
   }
 
@@ -96,6 +97,7 @@ class PayLoadSG
   {
     mBuffer.clear();
     mCurrentPieceID = mCurrentEntryInPiece = 0;
+    mTotalSize = 0;
   }
 
   struct SGPiece {
@@ -107,6 +109,9 @@ class PayLoadSG
 
   void setDone() { mCurrentPieceID = mBuffer.size(); }
 
+  ///< total number of bytes referred by the buffer
+  size_t getTotalSize() const { return mTotalSize; }
+
   size_t& currentPieceID() { return mCurrentPieceID; }
   size_t currentPieceID() const { return mCurrentPieceID; }
 
@@ -127,6 +132,7 @@ class PayLoadSG
   std::vector<SGPiece> mBuffer;   // list of pieces to fetch
   size_t mCurrentPieceID = 0;     // current piece
   size_t mCurrentEntryInPiece = 0; // offset within current piece
+  size_t mTotalSize = 0;          //! total size of all pieces, transient cache
 
   ClassDefNV(PayLoadSG, 1);
 };
@@ -15,7 +15,10 @@
 #define ALICEO2_ITSMFT_RAWPIXELDECODER_H_
 
 #include <array>
+#include <memory>
+#include <vector>
 #include <TStopwatch.h>
+#include <TH2F.h>
 #include "Framework/Logger.h"
 #include "ITSMFTReconstruction/ChipMappingITS.h"
 #include "ITSMFTReconstruction/ChipMappingMFT.h"
@@ -86,6 +89,11 @@ class RawPixelDecoder final : public PixelReader
   void setVerbosity(int v);
   int getVerbosity() const { return mVerbosity; }
 
+  void setMonitorLinkDecodeTime(bool v);
+  bool getMonitorLinkDecodeTime() const { return mMonitorLinkDecodeTime; }
+  double getLinkDecodeTimeTF(int i) const { return i < int(mLinkDecodeTimeTF.size()) ? mLinkDecodeTimeTF[i] : 0.; }
+  const TH2F* getLinkDecodeTimeHisto() const { return mLinkDecodeTimeHisto.get(); }
+
   void printReport(bool decstat = true, bool skipNoErr = true) const;
 
   void clearStat();
@@ -97,6 +105,8 @@ class RawPixelDecoder final : public PixelReader
   uint32_t getNPixelsFiredROF() const { return mNPixelsFiredROF; }
   size_t getNChipsFired() const { return mNChipsFired; }
   size_t getNPixelsFired() const { return mNPixelsFired; }
+  double getRUDecodeTime(int ruSW) const { return mRUEntry[ruSW] < 0 ? 0. : mRUDecodeTime[mRUEntry[ruSW]]; }
+  size_t getRUDataSize(int ruSW) const { return mRUEntry[ruSW] < 0 ? 0 : mRUDataSize[mRUEntry[ruSW]]; }
 
   struct LinkEntry {
     int entry = -1;
@@ -108,6 +118,9 @@ class RawPixelDecoder final : public PixelReader
   RUDecodeData* getRUDecode(int ruSW) { return &mRUDecodeVec[mRUEntry[ruSW]]; }
   GBTLink* getGBTLink(int i) { return i < 0 ? nullptr : &mGBTLinks[i]; }
   RUDecodeData& getCreateRUDecode(int ruSW);
+  int decodeNextTrigger(int iru, uint32_t& nLinksDone);
+  void defineDecodingOrder();
+  void fillLinkDecodeTimeHisto();
 
   static constexpr uint16_t NORUDECODED = 0xffff; // this must be > than max N RUs
 
@@ -116,6 +129,11 @@ class RawPixelDecoder final : public PixelReader
   std::vector<RUDecodeData> mRUDecodeVec;                   // set of active RUs
   std::array<short, Mapping::getNRUs()> mRUEntry;           // entry of the RU with given SW ID in the mRUDecodeVec
   std::vector<ChipPixelData*> mOrderedChipsPtr;             // special ordering helper used for the MFT (its chipID is not contiguous in RU)
+  std::vector<int> mRUDecodeOrder;                          // order in which RUs are handed to decoding threads: largest TF data volume first
+  std::vector<size_t> mRUDataSize;                          // raw data volume of each active RU in the current TF
+  std::vector<double> mRUDecodeTime;                        // accumulated decoding wall time (s) of each active RU
+  std::vector<double> mLinkDecodeTimeTF;                    // decoding wall time (s) of each link of the pool in the current TF
+  std::unique_ptr<TH2F> mLinkDecodeTimeHisto;               // decoding time per TF vs link (RU SW ID * MaxLinksPerRU + link ID in RU)
   std::string mSelfName;                        // self name
   header::DataOrigin mUserDataOrigin = o2::header::gDataOriginInvalid; // alternative user-provided data origin to pick
   header::DataDescription mUserDataDescription = o2::header::gDataDescriptionInvalid; // alternative user-provided description to pick
@@ -125,6 +143,8 @@ class RawPixelDecoder final : public PixelReader
   bool mFillCalibData = false;                  // request to fill calib data from GBT
   int mVerbosity = 0;
   int mNThreads = 1; // number of decoding threads
+  bool mMonitorLinkDecodeTime = false;          // measure the decoding time of every link
+  bool mLinkDecodeTimeFilled = false;           // decoding times of the current TF were already histogrammed
   GBTLink::Format mFormat = GBTLink::NewFormat; // ITS Data Format (old: 1 ROF per CRU page)
   // statistics
   o2::itsmft::ROFRecord::ROFtype mROFCounter = 0; // RSTODO is this needed? eliminate from ROFRecord ?
@@ -17,6 +17,9 @@
 #include "DPLUtils/DPLRawParser.h"
 #include "Framework/InputRecordWalker.h"
 #include "CommonUtils/StringUtils.h"
+#include <chrono>
+#include <cmath>
+#include <numeric>
 
 #ifdef WITH_OPENMP
 #include <omp.h>
@@ -60,6 +63,18 @@ void RawPixelDecoder<Mapping>::printReport(bool decstat, bool skipNoErr) const
   LOGF(INFO, "%s Timing Total:     CPU = %.3e Real = %.3e in %d slots in %s mode", mSelfName, cpu, real, tmrS.Counter() - 1,
        mDecodeNextAuto ? "AutoDecode" : "ExternalCall");
 
+  if (!mRUDecodeOrder.empty()) { // RUs dominating the decoding time, i.e. the ones limiting the multi-threaded decoding
+    std::vector<int> ruByTime(mRUDecodeVec.size());
+    std::iota(ruByTime.begin(), ruByTime.end(), 0);
+    std::sort(ruByTime.begin(), ruByTime.end(), [this](int a, int b) { return mRUDecodeTime[a] > mRUDecodeTime[b]; });
+    double totTime = std::accumulate(mRUDecodeTime.begin(), mRUDecodeTime.end(), 0.);
+    for (size_t i = 0; i < std::min(ruByTime.size(), size_t(5)); i++) {
+      const auto& ru = mRUDecodeVec[ruByTime[i]];
+      LOGF(INFO, "%s RU#%d decoding time %.3e s (%.1f%% of total RU decoding time)", mSelfName, ru.ruSWID, mRUDecodeTime[ruByTime[i]],
+           totTime > 0 ? 100. * mRUDecodeTime[ruByTime[i]] / totTime : 0.);
+    }
+  }
+
   if (decstat) {
     LOG(INFO) << "GBT Links decoding statistics" << (skipNoErr ? " (only links with errors are reported)" : "");
     for (auto& lnk : mGBTLinks) {
@@ -78,22 +93,29 @@ int RawPixelDecoder<Mapping>::decodeNextTrigger()
   mNChipsFiredROF = 0;
   mNPixelsFiredROF = 0;
   mInteractionRecord.clear();
-  int nLinksWithData = 0, nru = mRUDecodeVec.size();
+  int nLinksWithData = 0, nru = mRUDecodeOrder.size();
   do {
+    uint32_t nLinksDone = 0;
+    // RUs are sorted in decreasing data volume, so that with the dynamic scheduling the heavy (inner barrel) RUs
+    // are picked up first and the idle threads take over the light ones instead of waiting for a busy thread
 #ifdef WITH_OPENMP
     omp_set_num_threads(mNThreads);
 #pragma omp parallel for schedule(dynamic) reduction(+ \
-                                                     : nLinksWithData, mNChipsFiredROF, mNPixelsFiredROF)
+                                                     : nLinksWithData, nLinksDone, mNChipsFiredROF, mNPixelsFiredROF)
 #endif
-    for (int iru = 0; iru < nru; iru++) {
-      nLinksWithData += decodeNextTrigger(iru);
+    for (int i = 0; i < nru; i++) {
+      int iru = mRUDecodeOrder[i];
+      auto tStart = std::chrono::steady_clock::now();
+      nLinksWithData += decodeNextTrigger(iru, nLinksDone);
       mNChipsFiredROF += mRUDecodeVec[iru].nChipsFired;
       int npix = 0;
       for (int ic = mRUDecodeVec[iru].nChipsFired; ic--;) {
         npix += mRUDecodeVec[iru].chipsData[ic].getData().size();
       }
       mNPixelsFiredROF += npix;
+      mRUDecodeTime[iru] += std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count(); // each RU is handled by a single thread
     }
+    mNLinksDone += nLinksDone;
 
     if (nLinksWithData) { // fill some statistics
       mROFCounter++;
@@ -115,6 +137,9 @@ int RawPixelDecoder<Mapping>::decodeNextTrigger()
 
   } while (mNLinksDone < mGBTLinks.size());
 
+  if (!nLinksWithData && mMonitorLinkDecodeTime && !mLinkDecodeTimeFilled) { // all links reached the end of the TF
+    fillLinkDecodeTimeHisto();
+  }
   ensureChipOrdering();
   mTimerDecode.Stop();
   return nLinksWithData;
@@ -134,31 +159,95 @@ void RawPixelDecoder<Mapping>::startNewTF(InputRecord& inputs)
     ru.clear();
   }
   setupLinks(inputs);
+  defineDecodingOrder();
+  mLinkDecodeTimeTF.assign(mGBTLinks.size(), 0.);
+  mLinkDecodeTimeFilled = false;
   mNLinksDone = 0;
   mTimerTFStart.Stop();
 }
 
+///______________________________________________________________
+/// sort RUs in decreasing order of their data volume in the current TF
+template <class Mapping>
+void RawPixelDecoder<Mapping>::defineDecodingOrder()
+{
+  mRUDataSize.clear();
+  mRUDataSize.resize(mRUDecodeVec.size(), 0);
+  if (mRUDecodeTime.size() != mRUDecodeVec.size()) { // RU slots were redefined
+    mRUDecodeTime.assign(mRUDecodeVec.size(), 0.);
+  }
+  for (const auto& link : mGBTLinks) {
+    if (link.ruPtr) {
+      mRUDataSize[mRUEntry[link.ruPtr->ruSWID]] += link.rawData.getTotalSize();
+    }
+  }
+  mRUDecodeOrder.resize(mRUDecodeVec.size());
+  std::iota(mRUDecodeOrder.begin(), mRUDecodeOrder.end(), 0);
+  std::stable_sort(mRUDecodeOrder.begin(), mRUDecodeOrder.end(), [this](int a, int b) { return mRUDataSize[a] > mRUDataSize[b]; });
+}
+
+///______________________________________________________________
+/// histogram the decoding time of every link in the TF which was just fully decoded
+template <class Mapping>
+void RawPixelDecoder<Mapping>::fillLinkDecodeTimeHisto()
+{
+  for (size_t il = 0; il < mGBTLinks.size(); il++) {
+    const auto& link = mGBTLinks[il];
+    if (link.ruPtr) {
+      mLinkDecodeTimeHisto->Fill(link.ruPtr->ruSWID * RUDecodeData::MaxLinksPerRU + link.idInRU, mLinkDecodeTimeTF[il] * 1e6);
+    }
+  }
+  mLinkDecodeTimeFilled = true;
+}
+
 ///______________________________________________________________
 /// Decode next trigger for given RU, return number of decoded GBT words
 template <class Mapping>
 int RawPixelDecoder<Mapping>::decodeNextTrigger(int iru)
+{
+  return decodeNextTrigger(iru, mNLinksDone);
+}
+
+///______________________________________________________________
+/// Decode next trigger for given RU, counting the links which are done in the provided counter (to be used in threads)
+template <class Mapping>
+int RawPixelDecoder<Mapping>::decodeNextTrigger(int iru, uint32_t& nLinksDone)
 {
   auto& ru = mRUDecodeVec[iru];
   ru.clear();
   int ndec = 0; // number of yet non-empty links
+  std::chrono::steady_clock::time_point tStart;
   for (int il = 0; il < RUDecodeData::MaxLinksPerRU; il++) {
     auto* link = getGBTLink(ru.links[il]);
     if (link) {
+      if (mMonitorLinkDecodeTime) {
+        tStart = std::chrono::steady_clock::now();
+      }
       auto res = link->collectROFCableData(mMAP);
+      if (mMonitorLinkDecodeTime) { // each link belongs to a single RU, hence it is handled by a single thread
+        mLinkDecodeTimeTF[ru.links[il]] += std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+      }
       if (res == GBTLink::DataSeen) { // at the moment process only DataSeen
         ndec++;
       } else if (res == GBTLink::StoppedOnEndOfData || res == GBTLink::AbortedOnError) { // this link has exhausted its data or it has to be discarded due to the error
-        mNLinksDone++;
+        nLinksDone++;
       }
     }
   }
   if (ndec) {
+    if (mMonitorLinkDecodeTime) {
+      tStart = std::chrono::steady_clock::now();
+    }
     ru.decodeROF(mMAP);
+    if (mMonitorLinkDecodeTime) { // the cables of the RU are decoded together, share their decoding time between the links which had data
+      double tShare = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count() / ndec;
+      for (int il = 0; il < RUDecodeData::MaxLinksPerRU; il++) {
+        auto* link = getGBTLink(ru.links[il]);
+        if (link && link->status == GBTLink::DataSeen) {
+          mLinkDecodeTimeTF[ru.links[il]] += tShare;
+        }
+      }
+    }
   }
   return ndec;
 }
@@ -382,6 +471,26 @@ void RawPixelDecoder<Mapping>::setNThreads(int n)
 #endif
 }
 
+///______________________________________________________________________
+template <class Mapping>
+void RawPixelDecoder<Mapping>::setMonitorLinkDecodeTime(bool v)
+{
+  mMonitorLinkDecodeTime = v;
+  if (v && !mLinkDecodeTimeHisto) {
+    // log binning of the per TF decoding time from 1 us to 10 s
+    constexpr int NTimeBins = 70;
+    std::array<double, NTimeBins + 1> timeBins;
+    for (int i = 0; i <= NTimeBins; i++) {
+      timeBins[i] = std::pow(10., 7. * i / NTimeBins);
+    }
+    int nLinks = Mapping::getNRUs() * RUDecodeData::MaxLinksPerRU;
+    mLinkDecodeTimeHisto = std::make_unique<TH2F>(o2::utils::Str::concat_string(mSelfName, "LinkDecodeTime").c_str(),
+                                                  ";RU SW ID * 3 + link ID in RU;decoding time per TF (#mus)",
+                                                  nLinks, -0.5, nLinks - 0.5, NTimeBins, timeBins.data());
+    mLinkDecodeTimeHisto->SetDirectory(nullptr);
+  }
+}
+
 ///______________________________________________________________________
 template <class Mapping>
 void RawPixelDecoder<Mapping>::setFormat(GBTLink::Format f)
@@ -398,6 +507,10 @@ void RawPixelDecoder<Mapping>::clearStat()
   for (auto& lnk : mGBTLinks) {
     lnk.clear(true, false);
   }
+  std::fill(mRUDecodeTime.begin(), mRUDecodeTime.end(), 0.);
+  if (mLinkDecodeTimeHisto) {
+    mLinkDecodeTimeHisto->Reset();
+  }
 }
 
 template class o2::itsmft::RawPixelDecoder<o2::itsmft::ChipMappingITS>;
@@ -0,0 +1,121 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file   bench_AlpideCoder.cxx
+/// \brief  Benchmark of the ALPIDE DATA LONG hit map expansion
+
+#include "benchmark/benchmark.h"
+#include <random>
+#include <vector>
+#include "ITSMFTReconstruction/AlpideCoder.h"
+#include "ITSMFTReconstruction/PayLoadCont.h"
+#include "ITSMFTReconstruction/PixelData.h"
+
+using namespace o2::itsmft;
+
+// Chips with one region of DATA LONG records, each with a random hit map
+// having up to nBitsSet bits set out of 7.
+PayLoadCont generateChips(int nChips, int nBitsSet, size_t& nHits)
+{
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int> bit(0, AlpideCoder::HitMapSize - 1);
+  PayLoadCont buffer;
+  nHits = 0;
+  for (int ic = 0; ic < nChips; ic++) {
+    buffer.add(uint8_t(AlpideCoder::CHIPHEADER | (ic & AlpideCoder::MaskChipID)));
+    buffer.add(uint8_t(0));
+    buffer.add(uint8_t(AlpideCoder::REGION | (ic % AlpideCoder::NRegions)));
+    for (int dcol = 0; dcol < AlpideCoder::NDColInReg; dcol++) {
+      for (uint16_t address = 0; address < 512; address += 8) {
+        uint8_t hitmap = 0;
+        for (int ib = 0; ib < nBitsSet; ib++) {
+          hitmap |= 0x1 << bit(gen);
+        }
+        uint16_t data = AlpideCoder::DATALONG | (dcol << 10) | address;
+        buffer.add(uint8_t(data >> 8));
+        buffer.add(uint8_t(data & 0xff));
+        buffer.add(hitmap);
+        nHits += 1 + __builtin_popcount(hitmap);
+      }
+    }
+    buffer.add(uint8_t(AlpideCoder::CHIPTRAILER));
+  }
+  return buffer;
+}
+
+static void BM_DecodeDataLong(benchmark::State& state)
+{
+  size_t nHits = 0;
+  auto buffer = generateChips(100, state.range(0), nHits);
+  ChipPixelData chipData;
+  for (auto _ : state) {
+    buffer.rewind();
+    while (AlpideCoder::decodeChip(chipData, buffer, [](uint16_t id) { return id; }) > 0) {
+      benchmark::DoNotOptimize(chipData.getData().data());
+    }
+  }
+  state.counters["hits"] = benchmark::Counter(nHits, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Only the expansion of the hit maps, as done before and after using the set bits.
+static void BM_HitMapPerBit(benchmark::State& state)
+{
+  std::mt19937 gen(12345);
+  std::vector<uint8_t> hitmaps(4096);
+  for (auto& h : hitmaps) {
+    h = gen() & AlpideCoder::MaskHitMap;
+  }
+  std::vector<uint16_t> rows(8);
+  for (auto _ : state) {
+    for (uint16_t i = 0; i < hitmaps.size(); i++) {
+      int n = 0;
+      for (int ip = 0; ip < AlpideCoder::HitMapSize; ip++) {
+        if (hitmaps[i] & (0x1 << ip)) {
+          uint16_t addr = i + ip + 1, rowE = addr >> 1;
+          bool rightC = ((rowE & 0x1) ? !(addr & 0x1) : (addr & 0x1));
+          rows[n++] = rowE + rightC;
+        }
+      }
+      benchmark::DoNotOptimize(rows.data());
+    }
+  }
+  state.counters["hitmaps"] = benchmark::Counter(hitmaps.size(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void BM_HitMapSetBits(benchmark::State& state)
+{
+  std::mt19937 gen(12345);
+  std::vector<uint8_t> hitmaps(4096);
+  for (auto& h : hitmaps) {
+    h = gen() & AlpideCoder::MaskHitMap;
+  }
+  std::vector<uint16_t> rows(8);
+  for (auto _ : state) {
+    for (uint16_t i = 0; i < hitmaps.size(); i++) {
+      int n = 0;
+      uint32_t hitMap = hitmaps[i];
+      while (hitMap) {
+        int ip = __builtin_ctz(hitMap);
+        hitMap &= hitMap - 1;
+        uint16_t addr = i + ip + 1, rowE = addr >> 1;
+        rows[n++] = rowE + ((rowE ^ addr) & 0x1);
+      }
+      benchmark::DoNotOptimize(rows.data());
+    }
+  }
+  state.counters["hitmaps"] = benchmark::Counter(hitmaps.size(), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_DecodeDataLong)->Arg(1)->Arg(3)->Arg(7);
+BENCHMARK(BM_HitMapPerBit);
+BENCHMARK(BM_HitMapSetBits);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,131 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test AlpideCoder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <vector>
+#include "ITSMFTReconstruction/AlpideCoder.h"
+#include "ITSMFTReconstruction/PayLoadCont.h"
+#include "ITSMFTReconstruction/PixelData.h"
+
+using namespace o2::itsmft;
+
+namespace
+{
+struct DataRecord {
+  uint8_t region;
+  uint8_t dcolumn;
+  uint16_t address;
+  bool isLong;
+  uint8_t hitmap;
+};
+
+void addChip(PayLoadCont& buffer, int chipID, const std::vector<DataRecord>& records)
+{
+  buffer.add(uint8_t(AlpideCoder::CHIPHEADER | chipID));
+  buffer.add(uint8_t(0)); // timestamp
+  int region = -1;
+  for (const auto& rec : records) {
+    if (rec.region != region) {
+      region = rec.region;
+      buffer.add(uint8_t(AlpideCoder::REGION | region));
+    }
+    uint16_t data = (rec.isLong ? AlpideCoder::DATALONG : AlpideCoder::DATASHORT) | (rec.dcolumn << 10) | rec.address;
+    buffer.add(uint8_t(data >> 8));
+    buffer.add(uint8_t(data & 0xff));
+    if (rec.isLong) {
+      buffer.add(rec.hitmap);
+    }
+  }
+  buffer.add(uint8_t(AlpideCoder::CHIPTRAILER));
+}
+
+/// The hits expected from the records, expanding the hit maps bit by bit as
+/// AlpideCoder::decodeChip used to do.
+std::vector<PixelData> expandPerBit(const std::vector<DataRecord>& records)
+{
+  std::vector<PixelData> hits;
+  std::vector<uint16_t> rightColHits;
+  uint16_t colDPrev = 0xffff;
+  auto flushRightColumn = [&]() {
+    colDPrev++;
+    for (auto row : rightColHits) {
+      hits.emplace_back(row, colDPrev);
+    }
+    rightColHits.clear();
+  };
+  auto addHit = [&](uint16_t addr, uint16_t colD) {
+    uint16_t row = addr >> 1;
+    bool rightC = (row & 0x1) ? !(addr & 0x1) : (addr & 0x1);
+    if (rightC) {
+      rightColHits.push_back(row);
+    } else {
+      hits.emplace_back(row, colD);
+    }
+  };
+  for (const auto& rec : records) {
+    uint16_t colD = (rec.region * AlpideCoder::NDColInReg + rec.dcolumn) << 1;
+    if (colD != colDPrev) {
+      flushRightColumn();
+      colDPrev = colD;
+    }
+    addHit(rec.address, colD);
+    if (rec.isLong) {
+      for (int ip = 0; ip < AlpideCoder::HitMapSize; ip++) {
+        if (rec.hitmap & (0x1 << ip)) {
+          addHit(rec.address + ip + 1, colD);
+        }
+      }
+    }
+  }
+  if (!rightColHits.empty()) {
+    flushRightColumn();
+  }
+  return hits;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(AlpideCoder_HitMapExpansion)
+{
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int> region(0, AlpideCoder::NRegions - 1);
+  std::uniform_int_distribution<int> dcolumn(0, AlpideCoder::NDColInReg - 1);
+  std::uniform_int_distribution<int> address(0, AlpideCoder::MaskPixID);
+  std::uniform_int_distribution<int> hitmap(0, 0xff);
+  std::uniform_int_distribution<int> nRecords(1, 8);
+
+  for (int iter = 0; iter < 10000; iter++) {
+    std::vector<DataRecord> records(nRecords(gen));
+    uint8_t reg = region(gen), dcol = dcolumn(gen);
+    for (auto& rec : records) {
+      // stay often in the same double column, to accumulate hits in the right column
+      if (gen() % 4 == 0) {
+        reg = region(gen);
+        dcol = dcolumn(gen);
+      }
+      rec = DataRecord{reg, dcol, uint16_t(address(gen)), gen() % 8 != 0, uint8_t(hitmap(gen))};
+    }
+    PayLoadCont buffer;
+    addChip(buffer, 3, records);
+
+    ChipPixelData chipData;
+    int nhits = AlpideCoder::decodeChip(chipData, buffer, [](uint16_t id) { return id; });
+    auto expected = expandPerBit(records);
+    BOOST_REQUIRE_EQUAL(nhits, expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+      BOOST_REQUIRE_EQUAL(chipData.getData()[i].getRow(), expected[i].getRow());
+      BOOST_REQUIRE_EQUAL(chipData.getData()[i].getCol(), expected[i].getCol());
+    }
+  }
+}
@@ -51,6 +51,7 @@ class STFDecoder : public Task
   bool mDoPatterns = false;
   bool mDoDigits = false;
   bool mDoCalibData = false;
+  bool mMonitorLinkDecodeTime = false;
   int mNThreads = 1;
   size_t mTFCounter = 0;
   size_t mEstNDig = 0;
@@ -31,6 +31,9 @@
 #include "DataFormatsITSMFT/CompCluster.h"
 #include "DetectorsCommonDataFormats/DetID.h"
 #include "CommonUtils/StringUtils.h"
+#include <Monitoring/Monitoring.h>
+#include <TFile.h>
+#include <fmt/format.h>
 
 namespace o2
 {
@@ -62,6 +65,8 @@ void STFDecoder<Mapping>::init(InitContext& ic)
   mDecoder->setFormat(ic.options().get<bool>("old-format") ? GBTLink::OldFormat : GBTLink::NewFormat);
   mDecoder->setVerbosity(ic.options().get<int>("decoder-verbosity"));
   mDecoder->setFillCalibData(mDoCalibData);
+  mMonitorLinkDecodeTime = ic.options().get<bool>("monitor-link-decode-time");
+  mDecoder->setMonitorLinkDecodeTime(mMonitorLinkDecodeTime);
   std::string noiseFile = o2::base::NameConf::getAlpideClusterDictionaryFileName(detID, mNoiseName, "root");
   if (o2::utils::Str::pathExists(noiseFile)) {
     TFile* f = TFile::Open(noiseFile.data(), "old");
@@ -144,6 +149,14 @@ void STFDecoder<Mapping>::run(ProcessingContext& pc)
     }
   }
 
+  if (mMonitorLinkDecodeTime) { // decoding time of every link in this TF, in us
+    auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+    const auto& decoder = *mDecoder; // the non-const getGBTLink is private
+    for (int il = 0; il < decoder.getNLinks(); il++) {
+      monitoring.send(o2::monitoring::Metric{decoder.getLinkDecodeTimeTF(il) * 1e6, fmt::format("{}-link-{:#x}-decode-time", Mapping::getName(), decoder.getGBTLink(il)->feeID)});
+    }
+  }
+
   if (mDoDigits) {
     pc.outputs().snapshot(Output{orig, "DIGITS", 0, Lifetime::Timeframe}, digVec);
     pc.outputs().snapshot(Output{orig, "DIGITSROF", 0, Lifetime::Timeframe}, digROFVec);
@@ -185,6 +198,12 @@ void STFDecoder<Mapping>::endOfStream(EndOfStreamContext& ec)
        mDoClusters ? "/clustering" : "", mTimer.CpuTime(), mTimer.RealTime(), mTimer.Counter() - 1);
   if (mDecoder) {
     mDecoder->printReport();
+    if (mDecoder->getLinkDecodeTimeHisto()) {
+      std::string fname = o2::utils::Str::concat_string(mSelfName, "LinkDecodeTime.root");
+      TFile fout(fname.c_str(), "recreate");
+      fout.WriteTObject(mDecoder->getLinkDecodeTimeHisto());
+      LOGF(INFO, "%s per link decoding time histogram is stored in %s", mSelfName, fname);
+    }
   }
   if (mClusterer) {
     mClusterer->print();
@@ -222,7 +241,8 @@ DataProcessorSpec getSTFDecoderITSSpec(bool doClusters, bool doPatterns, bool do
     Options{
       {"nthreads", VariantType::Int, 1, {"Number of decoding/clustering threads"}},
       {"old-format", VariantType::Bool, false, {"Use old format (1 trigger per CRU page)"}},
-      {"decoder-verbosity", VariantType::Int, 0, {"Verbosity level (-1: silent, 0: errors, 1: headers, 2: data)"}}}};
+      {"decoder-verbosity", VariantType::Int, 0, {"Verbosity level (-1: silent, 0: errors, 1: headers, 2: data)"}},
+      {"monitor-link-decode-time", VariantType::Bool, false, {"Send the decoding time of every link as metric and histogram it"}}}};
 }
 
 DataProcessorSpec getSTFDecoderMFTSpec(bool doClusters, bool doPatterns, bool doDigits, bool doCalib, bool askDISTSTF, const std::string& dict, const std::string& noise)
@@ -258,7 +278,8 @@ DataProcessorSpec getSTFDecoderMFTSpec(bool doClusters, bool doPatterns, bool do
     Options{
       {"nthreads", VariantType::Int, 1, {"Number of decoding/clustering threads"}},
       {"old-format", VariantType::Bool, false, {"Use old format (1 trigger per CRU page)"}},
-      {"decoder-verbosity", VariantType::Int, 0, {"Verbosity level (-1: silent, 0: errors, 1: headers, 2: data)"}}}};
+      {"decoder-verbosity", VariantType::Int, 0, {"Verbosity level (-1: silent, 0: errors, 1: headers, 2: data)"}},
+      {"monitor-link-decode-time", VariantType::Bool, false, {"Send the decoding time of every link as metric and histogram it"}}}};
 }
 
 } // namespace itsmft
@@ -19,11 +19,13 @@
 #include <gsl/span>
 #include <unordered_map>
 #include <vector>
+#include <deque>
 #include <map>
 #include <string>
 #include <string_view>
 #include <functional>
 #include <mutex>
+#include <memory>
 
 #include <Rtypes.h>
 #include <TTree.h>
@@ -51,11 +53,15 @@ class RawFileWriter
   using EmptyPageCallBack = std::function<void(const RDHAny* rdh, std::vector<char>& emptyHBF)>;
   using NewRDHCallBack = std::function<void(const RDHAny* rdh, bool prevEmpty, std::vector<char>& filler)>;
 
+  struct AsyncWriter;
   ///=====================================================================================
   /// output file handler with its own lock
   struct OutputFile {
     FILE* handler = nullptr;
     std::mutex fileMtx;
+    AsyncWriter* asyncWriter = nullptr;       //! writer threads shared by all files, if asynchronous writing is requested
+    std::deque<std::vector<char>> asyncQueue; //! superpages waiting to be written, in order, protected by the AsyncWriter lock
+    bool asyncBusy = false;                   //! some writer thread is writing to this file
     OutputFile() = default;
     OutputFile(const OutputFile& src) : handler(src.handler) {}
     OutputFile& operator=(const OutputFile& src)
@@ -66,6 +72,9 @@ class RawFileWriter
       return *this;
     }
     void write(const char* data, size_t size);
+    void write(std::vector<char>&& data);
+    bool isAsync() const { return asyncWriter != nullptr; }
+    std::vector<char> getFreeBuffer();
   };
   ///=====================================================================================
   struct PayloadCache {
@@ -384,6 +393,16 @@ class RawFileWriter
   bool isRDHStopUsed() const { return mUseRDHStop; }
   bool isCarryOverToLastPageApplied() const { return mApplyCarryOverToLastPage; }
 
+  /// flush the superpages of the output files asynchronously by a pool of nThreads writer threads shared by all files,
+  /// with at most maxQueuedBytes waiting to be written in total. Must be set before registering links.
+  void setAsyncWriting(bool v, int nThreads = 2, size_t maxQueuedBytes = 256 * 1024 * 1024)
+  {
+    mAsyncWriting = v;
+    mNAsyncWriterThreads = nThreads;
+    mMaxQueuedBytes = maxQueuedBytes;
+  }
+  bool isAsyncWriting() const { return mAsyncWriting; }
+
  private:
   void fillFromCache();
 
@@ -394,6 +413,7 @@ class RawFileWriter
   const HBFUtils& mHBFUtils = HBFUtils::Instance();
   std::unordered_map<LinkSubSpec_t, LinkData> mSSpec2Link; // mapping from subSpec to link
   std::unordered_map<std::string, OutputFile> mFName2File; // mapping from filenames to actual files
+  std::shared_ptr<AsyncWriter> mAsyncWriter;               //! writer threads of all files in async mode
 
   CarryOverCallBack carryOverFunc = nullptr; // default call back for large payload splitting (does nothing)
   EmptyPageCallBack emptyHBFFunc = nullptr;  // default call back for empty HBF (does nothing)
@@ -409,6 +429,9 @@ class RawFileWriter
   bool mUseRDHStop = true;                                                // detector uses STOP in RDH
   bool mCRUDetector = true;                                               // Detector readout via CRU ( RORC if false)
   bool mApplyCarryOverToLastPage = false;                                 // call CarryOver method also for last chunk and overwrite modified trailer
+  bool mAsyncWriting = false;                                             // superpages are written to files by background threads
+  int mNAsyncWriterThreads = 0;                                           // number of writer threads in async mode
+  size_t mMaxQueuedBytes = 0;                                             // max size of superpages queued for writing in async mode
 
   //>> caching --------------
   bool mCachingStage = false; // signal that current data should be cached
@@ -424,7 +447,7 @@ class RawFileWriter
   DetLazinessCheck mDetLazyCheck{};
   bool mDoLazinessCheck = true;
 
-  ClassDefNV(RawFileWriter, 1);
+  ClassDefNV(RawFileWriter, 2);
 };
 
 /** Ensure (i.e. create if needed) directory
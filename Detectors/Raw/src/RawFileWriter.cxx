@@ -18,6 +18,9 @@
 #include <sstream>
 #include <functional>
 #include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 #include "DetectorsCommonDataFormats/NameConf.h"
 #include "DetectorsRaw/RawFileWriter.h"
 #include "DetectorsRaw/HBFUtils.h"
@@ -62,9 +65,15 @@ void RawFileWriter::close()
     }
   }
   //
+  // write what is still queued
+  if (mAsyncWriter) {
+    mAsyncWriter->stop();
+    mAsyncWriter.reset();
+  }
   // close all files
   for (auto& flh : mFName2File) {
     LOG(INFO) << "Closing output file " << flh.first;
+    flh.second.asyncWriter = nullptr;
     fclose(flh.second.handler);
     flh.second.handler = nullptr;
   }
@@ -145,6 +154,12 @@ RawFileWriter::LinkData& RawFileWriter::registerLink(uint16_t fee, uint16_t cru,
       LOG(ERROR) << "Failed to open output file " << outFileName;
       throw std::runtime_error(std::string("cannot open link output file ") + outFileName);
     }
+    if (mAsyncWriting) {
+      if (!mAsyncWriter) {
+        mAsyncWriter = std::make_shared<AsyncWriter>(mNAsyncWriterThreads, mMaxQueuedBytes);
+      }
+      file.asyncWriter = mAsyncWriter.get();
+    }
   }
   if (!linkData.fileName.empty()) { // this link was already declared and associated with a file
     if (linkData.fileName == outFileName) {
@@ -583,15 +598,27 @@ void RawFileWriter::LinkData::flushSuperPage(bool keepLastPage)
   if (writer->mVerbosity) {
     LOGF(INFO, "Flushing super page of %u bytes for %s", pgSize, describe());
   }
-  writer->mFName2File.find(fileName)->second.write(buffer.data(), pgSize);
+  auto& file = writer->mFName2File.find(fileName)->second;
   auto toMove = buffer.size() - pgSize;
+  if (file.isAsync()) { // hand over the superpage to the writer thread and continue on a recycled buffer
+    auto next = file.getFreeBuffer();
+    next.reserve(std::max(size_t(writer->mSuperPageSize), toMove));
+    next.insert(next.end(), buffer.begin() + pgSize, buffer.end());
+    buffer.resize(pgSize);
+    file.write(std::move(buffer));
+    buffer.swap(next);
+  } else {
+    file.write(buffer.data(), pgSize);
+  }
   if (toMove) { // is there something left in the buffer, move it to the beginning of the buffer
-    if (toMove > pgSize) {
-      memcpy(buffer.data(), &buffer[pgSize], toMove);
-    } else {
-      memmove(buffer.data(), &buffer[pgSize], toMove);
+    if (!file.isAsync()) {
+      if (toMove > pgSize) {
+        memcpy(buffer.data(), &buffer[pgSize], toMove);
+      } else {
+        memmove(buffer.data(), &buffer[pgSize], toMove);
+      }
+      buffer.resize(toMove);
     }
-    buffer.resize(toMove);
     lastRDHoffset -= pgSize;
   } else {
     buffer.clear();
@@ -690,13 +717,137 @@ size_t RawFileWriter::LinkData::pushBack(const char* ptr, size_t sz, bool keepLa
 
 //================================================
 
+//____________________________________________
+/// writer threads shared by all output files. The superpages of every file are written in the order they were
+/// queued, by a single thread at a time, while different files are written in parallel
+struct RawFileWriter::AsyncWriter {
+  AsyncWriter(int nThreads, size_t maxBytes);
+  ~AsyncWriter() { stop(); }
+  void push(OutputFile& file, std::vector<char>&& data);
+  std::vector<char> getFreeBuffer();
+  void stop();
+  void process();
+
+  std::vector<std::thread> threads;
+  std::mutex queueMtx;
+  std::condition_variable dataReady;          // some file has new superpages to write or stop requested
+  std::condition_variable spaceReady;         // some queued superpage was written
+  std::deque<OutputFile*> readyFiles;         // files with queued superpages which no thread is writing
+  std::vector<std::vector<char>> freeBuffers; // written buffers to recycle
+  size_t queuedBytes = 0;
+  size_t maxQueuedBytes = 0;
+  bool stopRequested = false;
+};
+
+//____________________________________________
+RawFileWriter::AsyncWriter::AsyncWriter(int nThreads, size_t maxBytes) : maxQueuedBytes(maxBytes)
+{
+  for (int i = 0; i < std::max(1, nThreads); i++) {
+    threads.emplace_back([this]() { process(); });
+  }
+}
+
+//____________________________________________
+void RawFileWriter::AsyncWriter::push(OutputFile& file, std::vector<char>&& data)
+{
+  std::unique_lock<std::mutex> lock(queueMtx);
+  // block the producer if the memory budget is exhausted, unless nothing is queued
+  spaceReady.wait(lock, [this, &data]() { return queuedBytes == 0 || queuedBytes + data.size() <= maxQueuedBytes; });
+  queuedBytes += data.size();
+  file.asyncQueue.emplace_back(std::move(data));
+  if (file.asyncQueue.size() == 1 && !file.asyncBusy) { // otherwise the file is already waiting for or being served by a thread
+    readyFiles.push_back(&file);
+    dataReady.notify_one();
+  }
+}
+
+//____________________________________________
+std::vector<char> RawFileWriter::AsyncWriter::getFreeBuffer()
+{
+  std::vector<char> buff;
+  std::lock_guard<std::mutex> lock(queueMtx);
+  if (!freeBuffers.empty()) {
+    buff.swap(freeBuffers.back());
+    freeBuffers.pop_back();
+  }
+  return buff;
+}
+
+//____________________________________________
+void RawFileWriter::AsyncWriter::process()
+{
+  std::unique_lock<std::mutex> lock(queueMtx);
+  while (true) {
+    dataReady.wait(lock, [this]() { return stopRequested || !readyFiles.empty(); });
+    if (readyFiles.empty()) { // stop requested and nothing is left for this thread
+      break;
+    }
+    auto* file = readyFiles.front();
+    readyFiles.pop_front();
+    file->asyncBusy = true;
+    auto buff = std::move(file->asyncQueue.front());
+    file->asyncQueue.pop_front();
+    lock.unlock();
+    {
+      std::lock_guard<std::mutex> fileLock(file->fileMtx);
+      fwrite(buff.data(), 1, buff.size(), file->handler);
+    }
+    lock.lock();
+    file->asyncBusy = false;
+    if (!file->asyncQueue.empty()) {
+      readyFiles.push_back(file);
+      dataReady.notify_one();
+    }
+    queuedBytes -= buff.size();
+    buff.clear();
+    freeBuffers.emplace_back(std::move(buff));
+    spaceReady.notify_all();
+  }
+}
+
+//____________________________________________
+void RawFileWriter::AsyncWriter::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(queueMtx);
+    stopRequested = true;
+  }
+  dataReady.notify_all();
+  for (auto& thread : threads) { // every thread keeps serving its current file until its queue is empty
+    thread.join();
+  }
+  threads.clear();
+}
+
 //____________________________________________
 void RawFileWriter::OutputFile::write(const char* data, size_t sz)
 {
+  if (asyncWriter) { // must go through the queue to preserve the order of writing
+    auto buff = getFreeBuffer();
+    buff.assign(data, data + sz);
+    write(std::move(buff));
+    return;
+  }
   std::lock_guard<std::mutex> lock(fileMtx);
   fwrite(data, 1, sz, handler); // flush to file
 }
 
+//____________________________________________
+void RawFileWriter::OutputFile::write(std::vector<char>&& data)
+{
+  if (!asyncWriter) {
+    write(data.data(), data.size());
+    return;
+  }
+  asyncWriter->push(*this, std::move(data));
+}
+
+//____________________________________________
+std::vector<char> RawFileWriter::OutputFile::getFreeBuffer()
+{
+  return asyncWriter ? asyncWriter->getFreeBuffer() : std::vector<char>{};
+}
+
 //____________________________________________
 void RawFileWriter::DetLazinessCheck::acknowledge(LinkSubSpec_t s, const IR& _ir, bool _preformatted, uint32_t _trigger, uint32_t _detField)
 {
@@ -61,7 +61,10 @@ struct TestRawWriter { // simple class to create detector payload for multiple l
   std::string configName = "rawConf.cfg";
 
   //_________________________________________________________________
-  TestRawWriter(o2::header::DataOrigin origin = "TST", bool isCRU = true, const std::string& cfg = "rawConf.cfg") : writer(origin, isCRU), configName(cfg) {}
+  TestRawWriter(o2::header::DataOrigin origin = "TST", bool isCRU = true, const std::string& cfg = "rawConf.cfg", bool async = false) : writer(origin, isCRU), configName(cfg)
+  {
+    writer.setAsyncWriting(async, 3, 2 * 1024 * 1024); // small budget to make the links wait for the writer threads
+  }
 
   //_________________________________________________________________
   void init()
@@ -351,6 +354,17 @@ BOOST_AUTO_TEST_CASE(RawReaderWriter_CRU)
   }
 }
 
+BOOST_AUTO_TEST_CASE(RawReaderWriter_CRU_Async)
+{
+  TestRawWriter dw{"TST", true, "test_raw_conf_GBT_async.cfg", true}; // same as above but superpages are written by the file writer threads
+  dw.init();
+  dw.run(); // write output
+  //
+  TestRawReader dr{"TST", "test_raw_conf_GBT_async.cfg"};
+  dr.init();
+  dr.run(); // read back and check
+}
+
 BOOST_AUTO_TEST_CASE(RawReaderWriter_RORC)
 {
   TestRawWriter dw{"TST", false, "test_raw_conf_DDL.cfg"}; // this is RORC detector with origin TST
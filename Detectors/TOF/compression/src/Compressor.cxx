@@ -122,6 +122,11 @@ bool Compressor<RDH, verbose, paranoid>::processHBF()
     return true;
   }
 
+  /** DRM payload of the first page, decoded in place if the HBF has a single page with data **/
+  const char* firstPayload = nullptr;
+  uint32_t firstPayloadSize = 0;
+  int nPayloadPages = 0;
+
   /** loop until RDH close **/
   while (!rdh->stop) {
 
@@ -148,9 +153,22 @@ bool Compressor<RDH, verbose, paranoid>::processHBF()
     auto offsetToNext = rdh->offsetToNext;
     auto drmPayload = memorySize - headerSize;
 
-    /** copy DRM payload to save buffer **/
-    std::memcpy(mDecoderSaveBuffer + mDecoderSaveBufferDataSize, reinterpret_cast<const char*>(rdh) + headerSize, drmPayload);
-    mDecoderSaveBufferDataSize += drmPayload;
+    /** keep first DRM payload in place, copy to save buffer only when the HBF spans several pages **/
+    if (drmPayload > 0) {
+      auto payload = reinterpret_cast<const char*>(rdh) + headerSize;
+      if (nPayloadPages == 0) {
+        firstPayload = payload;
+        firstPayloadSize = drmPayload;
+      } else {
+        if (nPayloadPages == 1) {
+          std::memcpy(mDecoderSaveBuffer, firstPayload, firstPayloadSize);
+          mDecoderSaveBufferDataSize = firstPayloadSize;
+        }
+        std::memcpy(mDecoderSaveBuffer + mDecoderSaveBufferDataSize, payload, drmPayload);
+        mDecoderSaveBufferDataSize += drmPayload;
+      }
+      nPayloadPages++;
+    }
 
     /** move to next RDH **/
     rdh = reinterpret_cast<const RDH*>(reinterpret_cast<const char*>(rdh) + offsetToNext);
@@ -187,8 +205,13 @@ bool Compressor<RDH, verbose, paranoid>::processHBF()
   mEncoderPointer = reinterpret_cast<uint32_t*>(reinterpret_cast<char*>(mEncoderPointer) + rdh->headerSize);
 
   /** process DRM data **/
-  mDecoderPointer = reinterpret_cast<const uint32_t*>(mDecoderSaveBuffer);
-  mDecoderPointerMax = reinterpret_cast<const uint32_t*>(mDecoderSaveBuffer + mDecoderSaveBufferDataSize);
+  if (nPayloadPages == 1) {
+    mDecoderPointer = reinterpret_cast<const uint32_t*>(firstPayload);
+    mDecoderPointerMax = reinterpret_cast<const uint32_t*>(firstPayload + firstPayloadSize);
+  } else {
+    mDecoderPointer = reinterpret_cast<const uint32_t*>(mDecoderSaveBuffer);
+    mDecoderPointerMax = reinterpret_cast<const uint32_t*>(mDecoderSaveBuffer + mDecoderSaveBufferDataSize);
+  }
   while (mDecoderPointer < mDecoderPointerMax) {
     mEventCounter++;
     if (processDRM()) {            // if this breaks, we did not run the checker and the summary is not reset!
@@ -93,7 +93,7 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
   for (auto& subspecPartEntry : subspecPartMap) {
 
     auto subspec = subspecPartEntry.first;
-    auto parts = subspecPartEntry.second;
+    auto& parts = subspecPartEntry.second;
     auto& firstPart = parts.at(0);
 
     /** use the first part to define output headers **/
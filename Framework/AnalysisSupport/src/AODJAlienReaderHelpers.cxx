@@ -31,7 +31,9 @@
 #endif
 #include <TGrid.h>
 #include <TFile.h>
+#include <TROOT.h>
 #include <TTreeCache.h>
+#include <TTreeCacheUnzip.h>
 
 #include <arrow/ipc/reader.h>
 #include <arrow/ipc/writer.h>
@@ -39,6 +41,9 @@
 #include <arrow/table.h>
 #include <arrow/util/key_value_metadata.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <thread>
 
 using namespace o2;
@@ -132,11 +137,8 @@ static inline auto extractOriginalsTuple(framework::pack<Os...>, ProcessingConte
   return std::make_tuple(extractTypedOriginal<Os>(pc)...);
 }
 
-void AODJAlienReaderHelpers::dumpFileMetrics(Monitoring& monitoring, TFile* currentFile, uint64_t startedAt, uint64_t ioTime, int tfPerFile, int tfRead)
+std::string AODJAlienReaderHelpers::fileMetricsInfo(TFile* currentFile, uint64_t startedAt, uint64_t ioTime, int tfPerFile, int tfRead)
 {
-  if (currentFile == nullptr) {
-    return;
-  }
   std::string monitoringInfo(fmt::format("lfn={},size={},total_tf={},read_tf={},read_bytes={},read_calls={},io_time={:.1f},wait_time={:.1f}", currentFile->GetName(),
                                          currentFile->GetSize(), tfPerFile, tfRead, currentFile->GetBytesRead(), currentFile->GetReadCalls(),
                                          ((float)ioTime / 1e9), ((float)(uv_hrtime() - startedAt - ioTime) / 1e9)));
@@ -146,10 +148,260 @@ void AODJAlienReaderHelpers::dumpFileMetrics(Monitoring& monitoring, TFile* curr
     monitoringInfo += fmt::format(",se={},open_time={:.1f}", alienFile->GetSE(), alienFile->GetElapsed());
   }
 #endif
+  return monitoringInfo;
+}
+
+void AODJAlienReaderHelpers::dumpFileMetrics(Monitoring& monitoring, TFile* currentFile, uint64_t startedAt, uint64_t ioTime, int tfPerFile, int tfRead)
+{
+  if (currentFile == nullptr) {
+    return;
+  }
+  sendFileMetrics(monitoring, fileMetricsInfo(currentFile, startedAt, ioTime, tfPerFile, tfRead));
+}
+
+void AODJAlienReaderHelpers::sendFileMetrics(Monitoring& monitoring, std::string const& monitoringInfo)
+{
   monitoring.send(Metric{monitoringInfo, "aod-file-read-info"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
   LOGP(INFO, "Read info: {}", monitoringInfo);
 }
 
+/// The input of a table for one time frame: either a TTree or, for Arrow IPC
+/// input, the table itself
+struct TableInput {
+  TTree* tree = nullptr;
+  std::shared_ptr<arrow::Table> table = nullptr;
+
+  explicit operator bool() const { return tree != nullptr || table != nullptr; }
+};
+
+static TableInput getTableInput(DataInputDirector& didir, header::DataHeader const& dh, int counter, int numTF)
+{
+  if (didir.isArrowFile(dh, counter)) {
+    return {nullptr, didir.getArrowTable(dh, counter, numTF)};
+  }
+  return {didir.getDataTree(dh, counter, numTF), nullptr};
+}
+
+/// A time frame which was read and converted ahead of time by AODReadAhead
+struct PrefetchedTimeFrame {
+  int fileCounter = 0;
+  int numTF = 0;
+  uint64_t timeFrameNumber = 0;
+  std::vector<std::pair<header::DataHeader, std::shared_ptr<arrow::Table>>> tables;
+  size_t sizeCompressed = 0;
+  size_t sizeUncompressed = 0;
+  // read info of the file which was completed before this time frame
+  std::string fileInfo;
+  bool endOfData = false;
+  std::exception_ptr error = nullptr;
+};
+
+/// Reads the time frames of a reader device in a separate thread and keeps
+/// up to depth of them, converted to arrow tables, in a queue. The thread
+/// walks the files and time frames in the same order as the reader callback
+/// does and it is the only one using the DataInputDirector while running.
+class AODReadAhead
+{
+ public:
+  AODReadAhead(std::shared_ptr<DataInputDirector> didir, std::vector<OutputRoute> tables, int inputTimesliceId, int maxInputTimeslices, size_t depth)
+    : mDidir{std::move(didir)},
+      mRequestedTables{std::move(tables)},
+      mFileCounter{inputTimesliceId},
+      mMaxInputTimeslices{maxInputTimeslices},
+      mDepth{depth}
+  {
+    mThread = std::thread([this]() { run(); });
+  }
+
+  ~AODReadAhead()
+  {
+    stop();
+  }
+
+  /// Wait for the next time frame
+  PrefetchedTimeFrame pop()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this]() { return !mQueue.empty(); });
+    auto tf = std::move(mQueue.front());
+    mQueue.pop_front();
+    mCondition.notify_all();
+    return tf;
+  }
+
+  size_t queued()
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mQueue.size();
+  }
+
+  /// Stop the thread. Afterwards the read info of the current file can
+  /// be retrieved safely.
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mCondition.notify_all();
+    if (mThread.joinable()) {
+      mThread.join();
+    }
+  }
+
+  std::string currentFileInfo()
+  {
+    if (mCurrentFile == nullptr) {
+      return "";
+    }
+    return AODJAlienReaderHelpers::fileMetricsInfo(mCurrentFile, mCurrentFileStartedAt, mCurrentFileIOTime, mTFCurrentFile, mNumTF);
+  }
+
+ private:
+  void run()
+  {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this]() { return mStop || mQueue.size() < mDepth; });
+        if (mStop) {
+          return;
+        }
+      }
+      PrefetchedTimeFrame tf;
+      try {
+        read(tf);
+      } catch (...) {
+        tf.error = std::current_exception();
+      }
+      bool done = tf.endOfData || tf.error;
+      {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQueue.push_back(std::move(tf));
+      }
+      mCondition.notify_all();
+      if (done) {
+        return;
+      }
+    }
+  }
+
+  void read(PrefetchedTimeFrame& tf)
+  {
+    auto ioStart = uv_hrtime();
+    int ntf = mNumTF + 1;
+    bool first = true;
+    for (auto& route : mRequestedTables) {
+      auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
+      auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
+
+      auto input = getTableInput(*mDidir, dh, mFileCounter, ntf);
+      if (!input) {
+        if (!first) {
+          throw std::runtime_error(fmt::format("Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin.str, mFileCounter, ntf));
+        }
+        // the current file is done, move to the next one
+        tf.fileInfo = currentFileInfo();
+        mCurrentFile = nullptr;
+        mCurrentFileStartedAt = uv_hrtime();
+        mCurrentFileIOTime = 0;
+
+        mFileCounter += mMaxInputTimeslices;
+        if (mDidir->atEnd(mFileCounter)) {
+          tf.endOfData = true;
+          return;
+        }
+        ntf = 0;
+        input = getTableInput(*mDidir, dh, mFileCounter, ntf);
+        if (!input) {
+          throw std::runtime_error(fmt::format("Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin.str, mFileCounter, ntf));
+        }
+      }
+
+      if (first) {
+        tf.timeFrameNumber = mDidir->getTimeFrameNumber(dh, mFileCounter, ntf);
+      }
+
+      if (input.table) {
+        tf.tables.emplace_back(dh, input.table);
+      } else {
+        TreeToTable t2t;
+        tf.sizeCompressed += input.tree->GetZipBytes();
+        tf.sizeUncompressed += input.tree->GetTotBytes();
+        t2t.addAllColumns(input.tree);
+        t2t.fill(input.tree);
+        delete input.tree;
+        tf.tables.emplace_back(dh, t2t.finalize());
+      }
+
+      if (mCurrentFile == nullptr) {
+        mCurrentFile = mDidir->getFileFolder(dh, mFileCounter, ntf).file;
+        mTFCurrentFile = mDidir->getTimeFramesInFile(dh, mFileCounter);
+      }
+      first = false;
+    }
+    tf.fileCounter = mFileCounter;
+    tf.numTF = mNumTF = ntf;
+    mCurrentFileIOTime += (uv_hrtime() - ioStart);
+  }
+
+  std::shared_ptr<DataInputDirector> mDidir;
+  std::vector<OutputRoute> mRequestedTables;
+  int mFileCounter;
+  int mMaxInputTimeslices;
+  size_t mDepth;
+  int mNumTF = -1;
+
+  TFile* mCurrentFile = nullptr;
+  int mTFCurrentFile = -1;
+  uint64_t mCurrentFileStartedAt = uv_hrtime();
+  uint64_t mCurrentFileIOTime = 0;
+
+  std::deque<PrefetchedTimeFrame> mQueue;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  bool mStop = false;
+  std::thread mThread;
+};
+
+/// Send one time frame prepared by AODReadAhead. Returns false when there
+/// is nothing left to read.
+static bool sendPrefetched(AODReadAhead& readAhead, header::DataHeader const& TFNumberHeader, Monitoring& monitoring, DataAllocator& outputs)
+{
+  static size_t totalSizeUncompressed = 0;
+  static size_t totalSizeCompressed = 0;
+  static int filesProcessed = 0;
+  static int currentFileCounter = -1;
+
+  auto tf = readAhead.pop();
+  if (!tf.fileInfo.empty()) {
+    AODJAlienReaderHelpers::sendFileMetrics(monitoring, tf.fileInfo);
+  }
+  if (tf.error) {
+    std::rethrow_exception(tf.error);
+  }
+  if (tf.endOfData) {
+    return false;
+  }
+  if (currentFileCounter != tf.fileCounter) {
+    currentFileCounter = tf.fileCounter;
+    monitoring.send(Metric{(uint64_t)++filesProcessed, "files-opened"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+  }
+
+  outputs.make<uint64_t>(Output(TFNumberHeader)) = tf.timeFrameNumber;
+  for (auto& [dh, table] : tf.tables) {
+    outputs.adopt(Output(dh), table);
+  }
+  totalSizeCompressed += tf.sizeCompressed;
+  totalSizeUncompressed += tf.sizeUncompressed;
+
+  monitoring.send(Metric{(uint64_t)tf.numTF, "tf-sent"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+  monitoring.send(Metric{(uint64_t)totalSizeUncompressed / 1000, "aod-bytes-read-uncompressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+  monitoring.send(Metric{(uint64_t)totalSizeCompressed / 1000, "aod-bytes-read-compressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+  monitoring.send(Metric{(uint64_t)readAhead.queued(), "aod-read-ahead-queue"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+  return true;
+}
+
 AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
 {
   auto callback = AlgorithmSpec{adaptStateful([](ConfigParamRegistry const& options,
@@ -180,6 +432,13 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
     // get the run time watchdog
     auto* watchdog = new RuntimeWatchdog(options.get<int64_t>("time-limit"));
 
+    // decompress the baskets and convert the columns of a table in parallel
+    auto nThreads = options.get<int>("aod-reader-threads");
+    if (nThreads > 0) {
+      ROOT::EnableImplicitMT(nThreads);
+      TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+    }
+
     // selected the TFN input and
     // create list of requested tables
     header::DataHeader TFNumberHeader;
@@ -194,6 +453,14 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       }
     }
 
+    // read the next time frames in a separate thread
+    std::shared_ptr<AODReadAhead> readAhead;
+    auto readAheadDepth = options.get<int>("aod-read-ahead");
+    if (readAheadDepth > 0) {
+      ROOT::EnableThreadSafety();
+      readAhead = std::make_shared<AODReadAhead>(didir, requestedTables, spec.inputTimesliceId, spec.maxInputTimeslices, readAheadDepth);
+    }
+
     auto fileCounter = std::make_shared<int>(0);
     auto numTF = std::make_shared<int>(-1);
     return adaptStateless([TFNumberHeader,
@@ -201,7 +468,29 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
                            fileCounter,
                            numTF,
                            watchdog,
+                           readAhead,
                            didir](Monitoring& monitoring, DataAllocator& outputs, ControlService& control, DeviceSpec const& device) {
+      if (readAhead) {
+        bool timeLeft = watchdog->update();
+        if (!timeLeft) {
+          LOGP(INFO, "Run time exceeds run time limit of {} seconds. Exiting gracefully...", watchdog->runTimeLimit);
+          LOGP(INFO, "Stopping reader {} after time frame {}.", device.inputTimesliceId, watchdog->numberTimeFrames - 1);
+        }
+        if (!timeLeft || !sendPrefetched(*readAhead, TFNumberHeader, monitoring, outputs)) {
+          readAhead->stop();
+          if (timeLeft) {
+            LOGP(INFO, "No input files left to read for reader {}!", device.inputTimesliceId);
+          } else if (auto info = readAhead->currentFileInfo(); !info.empty()) {
+            AODJAlienReaderHelpers::sendFileMetrics(monitoring, info);
+          }
+          monitoring.flushBuffer();
+          didir->closeInputFiles();
+          control.endOfStream();
+          control.readyToQuit(QuitRequest::Me);
+        }
+        return;
+      }
+
       // Each parallel reader device.inputTimesliceId reads the files fileCounter*device.maxInputTimeslices+device.inputTimesliceId
       // the TF to read is numTF
       assert(device.inputTimesliceId < device.maxInputTimeslices);
@@ -244,9 +533,9 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
         auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
 
-        // create a TreeToTable object
-        TTree* tr = didir->getDataTree(dh, fcnt, ntf);
-        if (!tr) {
+        // get the tree, or the table for Arrow IPC input
+        auto input = getTableInput(*didir, dh, fcnt, ntf);
+        if (!input) {
           if (first) {
             // dump metrics of file which is done for reading
             dumpFileMetrics(monitoring, currentFile, currentFileStartedAt, currentFileIOTime, tfCurrentFile, ntf);
@@ -265,8 +554,8 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
             }
             // get first folder of next file
             ntf = 0;
-            tr = didir->getDataTree(dh, fcnt, ntf);
-            if (!tr) {
+            input = getTableInput(*didir, dh, fcnt, ntf);
+            if (!input) {
               LOGP(FATAL, "Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin, fcnt, ntf);
               throw std::runtime_error("Processing is stopped!");
             }
@@ -284,6 +573,12 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
 
         // create table output
         auto o = Output(dh);
+        if (input.table) {
+          outputs.adopt(o, input.table);
+          first = false;
+          continue;
+        }
+        auto tr = input.tree;
         auto& t2t = outputs.make<TreeToTable>(o);
 
         // add branches to read
@@ -24,6 +24,8 @@ namespace o2::framework::readers
 struct AODJAlienReaderHelpers {
   static AlgorithmSpec rootFileReaderCallback();
   static void dumpFileMetrics(o2::monitoring::Monitoring& monitoring, TFile* currentFile, uint64_t startedAt, uint64_t ioTime, int tfPerFile, int tfRead);
+  static std::string fileMetricsInfo(TFile* currentFile, uint64_t startedAt, uint64_t ioTime, int tfPerFile, int tfRead);
+  static void sendFileMetrics(o2::monitoring::Monitoring& monitoring, std::string const& monitoringInfo);
 };
 
 } // namespace o2::framework::readers
@@ -18,6 +18,7 @@
 #include <arrow/table.h>
 
 #include <iterator>
+#include <numeric>
 #include <tuple>
 #include <utility>
 
@@ -1004,6 +1005,164 @@ CombinationsGenerator<P2<T2s...>> combinations(const P2<T2s...>& policy)
   return CombinationsGenerator<P2<T2s...>>(policy);
 }
 
+// Flat buffers of row indices filled by CombinationsBatchGenerator.
+// indices[i][n] is the row of the i-th element of the n-th combination.
+template <std::size_t K>
+struct CombinationsIndexBatch {
+  std::array<std::vector<uint64_t>, K> indices;
+
+  uint64_t size() const
+  {
+    return indices[0].size();
+  }
+
+  void clear()
+  {
+    for (auto& v : indices) {
+      v.clear();
+    }
+  }
+
+  void reserve(uint64_t n)
+  {
+    for (auto& v : indices) {
+      v.reserve(n);
+    }
+  }
+};
+
+// Block-wise generation of strictly upper k-combinations of rows of a single table.
+// Instead of moving k row iterators for every combination, row indices are written
+// in blocks to flat buffers, so that the caller can gather the needed columns
+// in tight loops. With a category column, the grouping is done once on construction
+// and the same sliding window as in CombinationsBlockStrictlyUpperSameIndexPolicy
+// is applied, so that the combinations come out in the same order.
+template <std::size_t K>
+struct CombinationsBatchGenerator {
+  static_assert(K >= 2, "Batched combinations need at least two elements");
+  static constexpr uint64_t defaultBlockSize = 4096;
+
+  CombinationsBatchGenerator(uint64_t nRows) : mRows(nRows), mWindowSize(nRows)
+  {
+    std::iota(mRows.begin(), mRows.end(), 0);
+    mCategoryEnds.push_back(nRows);
+    reset();
+  }
+
+  template <typename T1, typename T>
+  CombinationsBatchGenerator(const std::string& categoryColumnName, int categoryNeighbours, const T1& outsider, const T& table) : mWindowSize(categoryNeighbours + 1)
+  {
+    if (mWindowSize >= K) {
+      auto groupedIndices = groupTable(table, categoryColumnName, K, outsider);
+      mRows.reserve(groupedIndices.size());
+      for (uint64_t i = 0; i < groupedIndices.size(); i++) {
+        if (i > 0 && groupedIndices[i].first != groupedIndices[i - 1].first) {
+          mCategoryEnds.push_back(i);
+        }
+        mRows.push_back(groupedIndices[i].second);
+      }
+      mCategoryEnds.push_back(mRows.size());
+    }
+    reset();
+  }
+
+  // Rewind to the first combination
+  void reset()
+  {
+    mCategory = 0;
+    mIsEnd = mWindowSize < K;
+    if (!mIsEnd) {
+      setCategory();
+    }
+  }
+
+  bool isEnd() const
+  {
+    return mIsEnd;
+  }
+
+  // Replace the content of batch with at most blockSize next combinations.
+  // Returns false when there was nothing left to generate.
+  bool next(CombinationsIndexBatch<K>& batch, uint64_t blockSize = defaultBlockSize)
+  {
+    batch.clear();
+    batch.reserve(blockSize);
+    while (!mIsEnd && batch.size() < blockSize) {
+      // Emit the whole run of the innermost element at once
+      uint64_t limit = std::min(mPos[0] + mWindowSize, mCategoryEnd);
+      uint64_t n = std::min(limit - mPos[K - 1], blockSize - batch.size());
+      for (std::size_t i = 0; i < K - 1; i++) {
+        batch.indices[i].insert(batch.indices[i].end(), n, mRows[mPos[i]]);
+      }
+      auto first = mRows.begin() + mPos[K - 1];
+      batch.indices[K - 1].insert(batch.indices[K - 1].end(), first, first + n);
+      mPos[K - 1] += n;
+      if (mPos[K - 1] == limit) {
+        advance();
+      }
+    }
+    return batch.size() > 0;
+  }
+
+ private:
+  void setCategory()
+  {
+    for (; mCategory < mCategoryEnds.size(); mCategory++) {
+      uint64_t begin = mCategory == 0 ? 0 : mCategoryEnds[mCategory - 1];
+      mCategoryEnd = mCategoryEnds[mCategory];
+      if (mCategoryEnd - begin >= K) {
+        for (std::size_t i = 0; i < K; i++) {
+          mPos[i] = begin + i;
+        }
+        return;
+      }
+    }
+    mIsEnd = true;
+  }
+
+  // Move to the next combination once the innermost element is exhausted
+  void advance()
+  {
+    for (std::size_t i = K - 2; i > 0; i--) {
+      uint64_t limit = std::min(mPos[0] + mWindowSize, mCategoryEnd) - (K - 1 - i);
+      if (++mPos[i] < limit) {
+        for (std::size_t j = i + 1; j < K; j++) {
+          mPos[j] = mPos[j - 1] + 1;
+        }
+        return;
+      }
+    }
+    if (++mPos[0] + K - 1 < mCategoryEnd) {
+      for (std::size_t j = 1; j < K; j++) {
+        mPos[j] = mPos[j - 1] + 1;
+      }
+      return;
+    }
+    mCategory++;
+    setCategory();
+  }
+
+  std::vector<uint64_t> mRows;         // table rows, ordered by category
+  std::vector<uint64_t> mCategoryEnds; // end offset of each category in mRows
+  uint64_t mWindowSize;
+  uint64_t mCategory = 0;
+  uint64_t mCategoryEnd = 0;
+  std::array<uint64_t, K> mPos; // current combination, as offsets in mRows
+  bool mIsEnd = false;
+};
+
+template <std::size_t K, typename T2>
+auto selfCombinationsBatched(const T2& table)
+{
+  return CombinationsBatchGenerator<K>(table.size());
+}
+
+template <std::size_t K, typename T1, typename T2>
+auto selfCombinationsBatched(const char* categoryColumnName, int categoryNeighbours, const T1& outsider, const T2& table)
+{
+  return CombinationsBatchGenerator<K>(categoryColumnName, categoryNeighbours, outsider, table);
+}
+
 } // namespace o2::soa
 
 #endif // O2_FRAMEWORK_ASOAHELPERS_H_
@@ -20,6 +20,8 @@
 #include "Framework/OutputObjHeader.h"
 #include "Framework/StringHelpers.h"
 #include "Framework/Output.h"
+#include "Framework/DataProcessorLabel.h"
+#include "Framework/ProcessingSlot.h"
 #include <string>
 #include "Framework/Logger.h"
 
@@ -171,8 +173,16 @@ struct TableTransform {
   }
 };
 
+/// Prefix of the DataProcessorLabel used to advertise spawned extended tables
+constexpr char const* spawnsLabelPrefix = "spawns:";
+/// Schema metadata key holding the hash of a spawned extended table
+constexpr char const* spawnsHashKey = "spawns-hash";
+
 /// This helper struct allows you to declare extended tables which should be
-/// created by the task (as opposed to those pre-defined by data model)
+/// created by the task (as opposed to those pre-defined by data model).
+/// When several tasks of a workflow spawn the same extended table with the
+/// same expressions, it is computed only by the first one and shared with
+/// the others.
 template <typename T>
 struct Spawns : TableTransform<typename aod::MetadataTrait<framework::pack_head_t<typename T::originals>>::metadata> {
   using extension_t = framework::pack_head_t<typename T::originals>;
@@ -184,6 +194,21 @@ struct Spawns : TableTransform<typename aod::MetadataTrait<framework::pack_head_
     return expression_pack_t{};
   }
 
+  /// Hash of the column expressions, used to share the extended table
+  /// between tasks which spawn it with the same definition
+  static uint32_t hash()
+  {
+    return hash_impl(expression_pack_t{});
+  }
+
+  /// Label advertising the spawned table to the topology builder
+  static DataProcessorLabel label()
+  {
+    using metadata_t = typename aod::MetadataTrait<extension_t>::metadata;
+    auto description = header::DataDescription{metadata_t::description()}.template as<std::string>();
+    return DataProcessorLabel{fmt::format("{}{}:{}", spawnsLabelPrefix, description, hash())};
+  }
+
   T* operator->()
   {
     return table.get();
@@ -199,6 +224,74 @@ struct Spawns : TableTransform<typename aod::MetadataTrait<framework::pack_head_
   }
   std::shared_ptr<typename T::table_t> table = nullptr;
   std::shared_ptr<extension_t> extension = nullptr;
+  /// true when the extension was received from the task which spawns it
+  bool shared = false;
+
+ private:
+  template <typename... Cs>
+  static uint32_t hash_impl(framework::pack<Cs...>)
+  {
+    uint32_t result = 0;
+    ((result = result * 31 + (expressions::hashExpression(Cs::Projector()) ^ compile_time_hash(Cs::columnLabel()))), ...);
+    return result;
+  }
+};
+
+/// Helpers shared by the index building policies
+struct IndexBuilderHelpers {
+  /// Dense lookup from a Key row to the first row of @a table pointing to it.
+  /// Input does not need to be sorted by Key; rows with a negative
+  /// index are ignored.
+  template <typename Key, typename T>
+  static std::vector<int32_t> makeLookup(T const& table, size_t keySize)
+  {
+    std::vector<int32_t> lookup(keySize, -1);
+    for (auto& row : table) {
+      auto id = row.template getId<Key>();
+      if (id < 0) {
+        continue;
+      }
+      if (static_cast<size_t>(id) >= lookup.size()) {
+        lookup.resize(id + 1, -1);
+      }
+      if (lookup[id] == -1) {
+        lookup[id] = row.globalIndex();
+      }
+    }
+    return lookup;
+  }
+
+  static int32_t find(std::vector<int32_t> const& lookup, int32_t id)
+  {
+    return (id < 0 || static_cast<size_t>(id) >= lookup.size()) ? -1 : lookup[id];
+  }
+
+  /// Column-wise buffer for the index table, written to arrow in one go
+  template <typename... Cs>
+  struct Columns {
+    std::tuple<std::vector<typename Cs::type>...> data;
+
+    void reserve(size_t n)
+    {
+      std::apply([n](auto&... c) { (c.reserve(n), ...); }, data);
+    }
+
+    template <typename... Vs>
+    void push(Vs... vs)
+    {
+      static_assert(sizeof...(Vs) == sizeof...(Cs), "Number of values does not coincide with number of columns");
+      std::apply([&](auto&... c) { (c.push_back(vs), ...); }, data);
+    }
+
+    std::shared_ptr<arrow::Table> finalize()
+    {
+      TableBuilder builder;
+      auto nRows = std::get<0>(data).size();
+      auto writer = builder.bulkPersist<typename Cs::type...>({Cs::columnLabel()...}, nRows);
+      std::apply([&](auto const&... c) { writer(0, nRows, c.data()...); }, data);
+      return builder.finalize();
+    }
+  };
 };
 
 /// Policy to control index building
@@ -206,130 +299,68 @@ struct Spawns : TableTransform<typename aod::MetadataTrait<framework::pack_head_
 struct IndexExclusive {
   /// Generic builder for in index table
   template <typename... Cs, typename Key, typename T1, typename... T>
-  static auto indexBuilder(framework::pack<Cs...>, Key const&, std::tuple<T1, T...> tables)
+  static auto indexBuilder(framework::pack<Cs...>, Key const& key, std::tuple<T1, T...> tables)
   {
     static_assert(sizeof...(Cs) == sizeof...(T) + 1, "Number of columns does not coincide with number of supplied tables");
-    using tables_t = framework::pack<T...>;
     using first_t = T1;
     auto tail = tuple_tail(tables);
-    TableBuilder builder;
-    auto cursor = framework::FFL(builder.cursor<o2::soa::Table<Cs...>>());
 
+    std::array<std::vector<int32_t>, sizeof...(T)> lookups{
+      IndexBuilderHelpers::makeLookup<Key>(std::get<T>(tail), key.size())...};
     std::array<int32_t, sizeof...(T)> values;
-    iterator_tuple_t<std::decay_t<T>...> iterators = std::apply(
-      [](auto&&... x) {
-        return std::make_tuple(x.begin()...);
-      },
-      tail);
-
-    using rest_it_t = decltype(pack_from_tuple(iterators));
-
-    int32_t idx = -1;
-    auto setValue = [&](auto& x) -> bool {
-      using type = std::decay_t<decltype(x)>;
-      constexpr auto position = framework::has_type_at_v<type>(rest_it_t{});
-
-      lowerBound<Key>(idx, x);
-      if (x == soa::RowViewSentinel{static_cast<uint64_t>(x.mMaxRow)}) {
-        return false;
-      } else if (x.template getId<Key>() != idx) {
-        return false;
-      } else {
-        values[position] = x.globalIndex();
-        ++x;
-        return true;
-      }
-    };
 
     auto first = std::get<first_t>(tables);
+    IndexBuilderHelpers::Columns<Cs...> columns;
+    columns.reserve(first.size());
     for (auto& row : first) {
-      idx = row.template getId<Key>();
-
-      if (std::apply(
-            [](auto&... x) {
-              return ((x == soa::RowViewSentinel{static_cast<uint64_t>(x.mMaxRow)}) && ...);
-            },
-            iterators)) {
-        break;
+      auto idx = row.template getId<Key>();
+      bool found = true;
+      for (auto i = 0u; i < sizeof...(T); ++i) {
+        values[i] = IndexBuilderHelpers::find(lookups[i], idx);
+        if (values[i] < 0) {
+          found = false;
+          break;
+        }
       }
-
-      auto result = std::apply(
-        [&](auto&... x) {
-          std::array<bool, sizeof...(T)> results{setValue(x)...};
-          return (results[framework::has_type_at_v<std::decay_t<decltype(x)>>(rest_it_t{})] && ...);
-        },
-        iterators);
-
-      if (result) {
-        cursor(0, row.globalIndex(), values[framework::has_type_at_v<T>(tables_t{})]...);
+      if (found) {
+        std::apply([&](auto... v) { columns.push(static_cast<int32_t>(row.globalIndex()), v...); }, values);
       }
     }
-    return builder.finalize();
+    return columns.finalize();
   }
 };
 /// Sparse index: values in a row can be (-1), index table is isomorphic (joinable)
 /// to T1
 struct IndexSparse {
   template <typename... Cs, typename Key, typename T1, typename... T>
-  static auto indexBuilder(framework::pack<Cs...>, Key const&, std::tuple<T1, T...> tables)
+  static auto indexBuilder(framework::pack<Cs...>, Key const& key, std::tuple<T1, T...> tables)
   {
     static_assert(sizeof...(Cs) == sizeof...(T) + 1, "Number of columns does not coincide with number of supplied tables");
-    using tables_t = framework::pack<T...>;
     using first_t = T1;
     auto tail = tuple_tail(tables);
-    TableBuilder builder;
-    auto cursor = framework::FFL(builder.cursor<o2::soa::Table<Cs...>>());
 
+    // The Key table is not looked up: its index is the key itself
+    constexpr std::array<bool, sizeof...(T)> isKey{std::is_same_v<std::decay_t<T>, Key>...};
+    std::array<std::vector<int32_t>, sizeof...(T)> lookups{
+      (std::is_same_v<std::decay_t<T>, Key> ? std::vector<int32_t>{} : IndexBuilderHelpers::makeLookup<Key>(std::get<T>(tail), key.size()))...};
     std::array<int32_t, sizeof...(T)> values;
 
-    iterator_tuple_t<std::decay_t<T>...> iterators = std::apply(
-      [](auto&&... x) {
-        return std::make_tuple(x.begin()...);
-      },
-      tail);
-
-    using rest_it_t = decltype(pack_from_tuple(iterators));
-
-    auto setValue = [&](auto& x, int idx) -> bool {
-      using type = std::decay_t<decltype(x)>;
-      constexpr auto position = framework::has_type_at_v<type>(rest_it_t{});
-
-      if constexpr (std::is_same_v<framework::pack_element_t<position, framework::pack<std::decay_t<T>...>>, Key>) {
-        values[position] = idx;
-        return true;
-      } else {
-        lowerBound<Key>(idx, x);
-        if (x == soa::RowViewSentinel{static_cast<uint64_t>(x.mMaxRow)}) {
-          values[position] = -1;
-          return false;
-        } else if (x.template getId<Key>() != idx) {
-          values[position] = -1;
-          return false;
-        } else {
-          values[position] = x.globalIndex();
-          ++x;
-          return true;
-        }
-      }
-    };
-
     auto first = std::get<first_t>(tables);
+    IndexBuilderHelpers::Columns<Cs...> columns;
+    columns.reserve(first.size());
     for (auto& row : first) {
-      auto idx = -1;
-      if constexpr (std::is_same_v<first_t, Key>) {
+      int32_t idx = -1;
+      if constexpr (std::is_same_v<std::decay_t<first_t>, Key>) {
         idx = row.globalIndex();
       } else {
         idx = row.template getId<Key>();
       }
-      std::apply(
-        [&](auto&... x) {
-          (setValue(x, idx), ...);
-        },
-        iterators);
-
-      cursor(0, row.globalIndex(), values[framework::has_type_at_v<T>(tables_t{})]...);
+      for (auto i = 0u; i < sizeof...(T); ++i) {
+        values[i] = isKey[i] ? idx : IndexBuilderHelpers::find(lookups[i], idx);
+      }
+      std::apply([&](auto... v) { columns.push(static_cast<int32_t>(row.globalIndex()), v...); }, values);
     }
-    return builder.finalize();
+    return columns.finalize();
   }
 };
 
@@ -444,14 +475,17 @@ struct OutputObj {
     return OutputSpec{OutputLabel{label}, "ATSK", desc, 0};
   }
 
+  /// Within the workers of a parallel process() this is the worker's own
+  /// copy of the object, merged into the object at the end of the timeframe
   T* operator->()
   {
-    return object.get();
+    auto slot = ProcessingSlot::current();
+    return (slot <= 0 || shadows.empty()) ? object.get() : shadows[slot - 1].get();
   }
 
   T& operator*()
   {
-    return *object.get();
+    return *operator->();
   }
 
   OutputRef ref()
@@ -461,6 +495,9 @@ struct OutputObj {
   }
 
   std::shared_ptr<T> object;
+  std::vector<std::shared_ptr<T>> shadows;
+  /// The object the shadows were cloned from
+  T* shadowsOf = nullptr;
   std::string label;
   OutputObjHandlingPolicy policy;
   OutputObjSourceType sourceType;
@@ -28,6 +28,7 @@
 #include "Framework/VariantHelpers.h"
 #include "Framework/RuntimeError.h"
 #include "Framework/TypeIdHelpers.h"
+#include "Framework/ProcessingWorkers.h"
 
 #include <arrow/compute/kernel.h>
 #include <arrow/table.h>
@@ -37,6 +38,7 @@
 #include <memory>
 #include <sstream>
 #include <iomanip>
+#include <atomic>
 namespace o2::framework
 {
 /// A more familiar task API for the DPL analysis framework.
@@ -278,18 +280,14 @@ struct AnalysisDataProcessorBuilder {
           using xt = std::decay_t<decltype(x)>;
           constexpr auto index = framework::has_type_at_v<std::decay_t<decltype(x)>>(associated_pack_t{});
           if (x.size() != 0 && hasIndexTo<std::decay_t<G>>(typename xt::persistent_columns_t{})) {
-            auto result = o2::framework::sliceByColumn(indexColumnName.c_str(),
+            auto result = o2::framework::groupByColumn(indexColumnName.c_str(),
                                                        x.asArrowTable(),
                                                        static_cast<int32_t>(gt.tableSize()),
-                                                       &groups[index],
                                                        &offsets[index],
                                                        &sizes[index]);
             if (result.ok() == false) {
-              throw runtime_error("Cannot split collection");
+              throw runtime_error_f("Cannot split collection: %s", result.ToString().c_str());
             }
-            if (groups[index].size() > gt.tableSize()) {
-              throw runtime_error_f("Splitting collection resulted in a larger group number (%d) than there is rows in the grouping table (%d).", groups[index].size(), gt.tableSize());
-            };
           }
         };
 
@@ -376,27 +374,45 @@ struct AnalysisDataProcessorBuilder {
 
       auto associatedTables()
       {
-        return std::make_tuple(prepareArgument<A>()...);
+        return std::make_tuple(prepareArgument<A>(position, true)...);
+      }
+
+      /// Grouping element and associated tables of an arbitrary group. Unlike
+      /// groupingElement() and associatedTables() these do not modify the
+      /// iterator, so that different groups can be prepared concurrently.
+      auto groupingElementAt(uint64_t group) const
+      {
+        return mGroupingElement + (static_cast<int64_t>(group) - static_cast<int64_t>(position));
+      }
+
+      auto associatedTablesAt(uint64_t group)
+      {
+        return std::make_tuple(prepareArgument<A>(group, false)...);
       }
 
       template <typename A1>
-      auto prepareArgument()
+      auto prepareArgument(uint64_t group, bool sequential)
       {
         constexpr auto index = framework::has_type_at_v<A1>(associated_pack_t{});
         if (std::get<A1>(*mAt).size() != 0 && hasIndexTo<G>(typename std::decay_t<A1>::persistent_columns_t{})) {
           uint64_t pos;
           if constexpr (soa::is_soa_filtered_t<std::decay_t<G>>::value) {
-            pos = (*groupSelection)[position];
+            pos = (*groupSelection)[group];
           } else {
-            pos = position;
+            pos = group;
           }
+          // the slice is created only for the groups which are actually iterated over
+          auto groupedElementsTable = std::get<A1>(*mAt).asArrowTable()->Slice((offsets[index])[pos], (sizes[index])[pos]);
           if constexpr (soa::is_soa_filtered_t<std::decay_t<A1>>::value) {
-            auto groupedElementsTable = arrow::util::get<std::shared_ptr<arrow::Table>>(((groups[index])[pos]).value);
 
-            // for each grouping element we need to slice the selection vector
-            auto start_iterator = std::lower_bound(starts[index], selections[index]->end(), (offsets[index])[pos]);
+            // for each grouping element we need to slice the selection vector;
+            // when iterating in order the search starts where the previous group ended
+            auto first = sequential ? starts[index] : selections[index]->begin();
+            auto start_iterator = std::lower_bound(first, selections[index]->end(), (offsets[index])[pos]);
             auto stop_iterator = std::lower_bound(start_iterator, selections[index]->end(), (offsets[index])[pos] + (sizes[index])[pos]);
-            starts[index] = stop_iterator;
+            if (sequential) {
+              starts[index] = stop_iterator;
+            }
             soa::SelectionVector slicedSelection{start_iterator, stop_iterator};
             std::transform(slicedSelection.begin(), slicedSelection.end(), slicedSelection.begin(),
                            [&](int64_t idx) {
@@ -406,7 +422,6 @@ struct AnalysisDataProcessorBuilder {
             std::decay_t<A1> typedTable{{groupedElementsTable}, std::move(slicedSelection), (offsets[index])[pos]};
             return typedTable;
           } else {
-            auto groupedElementsTable = arrow::util::get<std::shared_ptr<arrow::Table>>(((groups[index])[pos]).value);
             std::decay_t<A1> typedTable{{groupedElementsTable}, (offsets[index])[pos]};
             return typedTable;
           }
@@ -420,7 +435,6 @@ struct AnalysisDataProcessorBuilder {
       typename grouping_t::iterator mGroupingElement;
       uint64_t position = 0;
       soa::SelectionVector const* groupSelection = nullptr;
-      std::array<std::vector<arrow::Datum>, sizeof...(A)> groups;
       std::array<std::vector<uint64_t>, sizeof...(A)> offsets;
       std::array<std::vector<int>, sizeof...(A)> sizes;
       std::array<soa::SelectionVector const*, sizeof...(A)> selections;
@@ -440,14 +454,16 @@ struct AnalysisDataProcessorBuilder {
     GroupSlicerIterator mBegin;
   };
 
+  /// With @a workers the groups of grouped process() methods are processed
+  /// concurrently, it must only be used for thread-safe tasks
   template <typename Task, typename... T>
-  static void invokeProcessTuple(Task& task, InputRecord& inputs, std::tuple<T...> const& processTuple, std::vector<ExpressionInfo> const& infos)
+  static void invokeProcessTuple(Task& task, InputRecord& inputs, std::tuple<T...> const& processTuple, std::vector<ExpressionInfo> const& infos, ProcessingWorkers* workers = nullptr)
   {
-    (invokeProcess<o2::framework::has_type_at_v<T>(pack<T...>{})>(task, inputs, std::get<T>(processTuple), infos), ...);
+    (invokeProcess<o2::framework::has_type_at_v<T>(pack<T...>{})>(task, inputs, std::get<T>(processTuple), infos, workers), ...);
   }
 
   template <int PI, typename Task, typename R, typename C, typename Grouping, typename... Associated>
-  static void invokeProcess(Task& task, InputRecord& inputs, R (C::*processingFunction)(Grouping, Associated...), std::vector<ExpressionInfo> const& infos)
+  static void invokeProcess(Task& task, InputRecord& inputs, R (C::*processingFunction)(Grouping, Associated...), std::vector<ExpressionInfo> const& infos, ProcessingWorkers* workers = nullptr)
   {
     using G = std::decay_t<Grouping>;
     auto groupingTable = AnalysisDataProcessorBuilder::bindGroupingTable<PI>(inputs, processingFunction, infos);
@@ -503,6 +519,24 @@ struct AnalysisDataProcessorBuilder {
       if constexpr (soa::is_soa_iterator_t<std::decay_t<G>>::value) {
         // grouping case
         auto slicer = GroupSlicer(groupingTable, associatedTables);
+        if (workers != nullptr) {
+          // thread-safe task: groups are processed concurrently, partitions are not
+          // supported in this mode so that only the slices need to be bound
+          auto& slice = slicer.begin();
+          std::atomic<int64_t> nextGroup{0};
+          workers->run([&]() {
+            for (auto group = nextGroup++; group < slicer.max; group = nextGroup++) {
+              auto associatedSlices = slice.associatedTablesAt(group);
+              std::apply(
+                [&](auto&&... x) {
+                  (x.bindExternalIndices(&groupingTable, &std::get<std::decay_t<Associated>>(associatedTables)...), ...);
+                },
+                associatedSlices);
+              invokeProcessWithArgsGeneric(task, processingFunction, slice.groupingElementAt(group), associatedSlices);
+            }
+          });
+          return;
+        }
         for (auto& slice : slicer) {
           auto associatedSlices = slice.associatedTables();
 
@@ -597,6 +631,19 @@ class has_init
 
 template <class T>
 inline constexpr bool has_init_v = has_init<T>::value;
+
+/// A task declares that its process() can be run concurrently over groups with
+///   static constexpr bool threadSafe = true;
+template <typename T, typename = void>
+struct is_thread_safe : std::false_type {
+};
+
+template <typename T>
+struct is_thread_safe<T, std::void_t<decltype(T::threadSafe)>> : std::bool_constant<T::threadSafe> {
+};
+
+template <class T>
+inline constexpr bool is_thread_safe_v = is_thread_safe<T>::value;
 } // namespace
 
 /// Struct to differentiate task names from possible task string arguments
@@ -689,6 +736,9 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
 
   /// make sure options and configurables are set before expression infos are created
   homogeneous_apply_refs([&options, &hash](auto& x) { return OptionManager<std::decay_t<decltype(x)>>::appendOption(options, x); }, *task.get());
+  if constexpr (is_thread_safe_v<T>) {
+    options.push_back(ConfigParamSpec{"analysis-threads", VariantType::Int, 1, {"Number of threads processing the groups of a timeframe concurrently"}});
+  }
 
   if constexpr ((std::tuple_size_v<std::decay_t<decltype(processTuple)>>) > 0) {
     // this pushes (argumentIndex,processIndex,schemaPtr,nullptr) into expressionInfos for arguments that are Filtered/filtered_iterators
@@ -705,6 +755,13 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
   },
                          *task.get());
 
+  //advertise spawned extended tables, so that they can be shared with other tasks
+  std::vector<DataProcessorLabel> labels;
+  homogeneous_apply_refs([&labels](auto& x) {
+    return SpawnManager<std::decay_t<decltype(x)>>::appendLabel(labels, x);
+  },
+                         *task.get());
+
   //request base tables for indices to be built
   homogeneous_apply_refs([&inputs](auto& x) {
     return IndexManager<std::decay_t<decltype(x)>>::requestInputs(inputs, x);
@@ -744,13 +801,34 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
       task->init(ic);
     }
 
-    return [task, processTuple, expressionInfos](ProcessingContext& pc) {
+    std::shared_ptr<ProcessingWorkers> workers;
+    if constexpr (is_thread_safe_v<T>) {
+      auto nThreads = ic.options().get<int>("analysis-threads");
+      if (nThreads > 1) {
+        auto supported = homogeneous_apply_refs([](auto& x) { return ParallelManager<std::decay_t<decltype(x)>>::isSupported(x); }, *task.get());
+        if (std::all_of(supported.begin(), supported.end(), [](bool s) { return s; }) == false) {
+          LOG(WARNING) << "Task has outputs which cannot be filled concurrently, ignoring analysis-threads";
+        } else {
+          workers = std::make_shared<ProcessingWorkers>(nThreads);
+        }
+      }
+    }
+
+    return [task, processTuple, expressionInfos, workers](ProcessingContext& pc) {
       homogeneous_apply_refs([&pc](auto&& x) { return OutputManager<std::decay_t<decltype(x)>>::prepare(pc, x); }, *task.get());
       if constexpr (has_run_v<T>) {
         task->run(pc);
       }
+      if (workers) {
+        // the first worker fills the outputs themselves, each other one its own shadow. Outputs
+        // created since the previous timeframe get their shadows here.
+        homogeneous_apply_refs([n = workers->size() - 1](auto& x) { return ParallelManager<std::decay_t<decltype(x)>>::createShadows(x, n); }, *task.get());
+      }
       if constexpr ((std::tuple_size_v<std::decay_t<decltype(processTuple)>>) > 0) {
-        AnalysisDataProcessorBuilder::invokeProcessTuple(*(task.get()), pc.inputs(), processTuple, expressionInfos);
+        AnalysisDataProcessorBuilder::invokeProcessTuple(*(task.get()), pc.inputs(), processTuple, expressionInfos, workers.get());
+      }
+      if (workers) {
+        homogeneous_apply_refs([](auto& x) { return ParallelManager<std::decay_t<decltype(x)>>::mergeShadows(x); }, *task.get());
       }
       homogeneous_apply_refs([&pc](auto&& x) { return OutputManager<std::decay_t<decltype(x)>>::finalize(pc, x); }, *task.get());
     };
@@ -765,6 +843,7 @@ DataProcessorSpec adaptAnalysisTask(ConfigContext const& ctx, Args&&... args)
     outputs,
     algo,
     options};
+  spec.labels = labels;
   return spec;
 }
 
@@ -0,0 +1,51 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_ARROWFILEHELPERS_H_
+#define O2_FRAMEWORK_ARROWFILEHELPERS_H_
+
+#include <memory>
+#include <string>
+
+namespace arrow
+{
+class Table;
+}
+
+namespace o2::framework
+{
+
+/// Helpers to store AOD tables as Arrow IPC files, the arrow native
+/// alternative to TableToTree / TreeToTable. A file holds one table of
+/// one time frame and the files are arranged as
+///
+///   <filename base>.arrow/DF_<time frame>/<tree name>.arrow
+///
+/// i.e. with the same DF_ folder structure used in the ROOT files.
+struct ArrowFileHelpers {
+  /// Extension of the directories holding the Arrow IPC files
+  static constexpr char const* extension = ".arrow";
+
+  /// Write @a table to @a filename. The buffers are compressed
+  /// with @a codec, which can be "" (no compression), "lz4" or "zstd".
+  static bool write(std::shared_ptr<arrow::Table> const& table, std::string const& filename, std::string const& codec = "");
+
+  /// Memory map @a filename and create a table from it. For uncompressed
+  /// files the columns point directly to the mapped memory.
+  /// Returns nullptr if the file cannot be read.
+  static std::shared_ptr<arrow::Table> read(std::string const& filename);
+
+  /// Whether @a path is a directory of Arrow IPC files
+  static bool isArrowDirectory(std::string const& path);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_ARROWFILEHELPERS_H_
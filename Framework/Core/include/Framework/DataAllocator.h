@@ -18,6 +18,7 @@
 #include "Framework/OutputRef.h"
 #include "Framework/OutputRoute.h"
 #include "Framework/DataChunk.h"
+#include "Framework/DataRef.h"
 #include "Framework/FairMQDeviceProxy.h"
 #include "Framework/TimingInfo.h"
 #include "Framework/TMessageSerializer.h"
@@ -376,6 +377,14 @@ class DataAllocator
   void snapshot(const Output& spec, const char* payload, size_t payloadSize,
                 o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
 
+  /// Send the payload of the input @a ref again, to the output specified by
+  /// @a spec, with a new header. When @a ref is one of the inputs being
+  /// processed and the output channel uses the same transport, the new message
+  /// shares the payload buffer with the input (e.g. shared memory is only
+  /// reference counted), otherwise this behaves as a snapshot of the payload.
+  /// Size and serialization method are the ones of the input.
+  void forwardPayload(const Output& spec, DataRef const& ref);
+
   /// make an object of type T and route to output specified by OutputRef
   /// The object is owned by the framework, returned reference can be used to fill the object.
   ///
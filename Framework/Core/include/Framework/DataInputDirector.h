@@ -19,6 +19,11 @@
 #include <regex>
 #include "rapidjson/fwd.h"
 
+namespace arrow
+{
+class Table;
+}
+
 namespace o2::framework
 {
 
@@ -27,6 +32,7 @@ struct FileNameHolder {
   int numberOfTimeFrames = 0;
   std::vector<uint64_t> listOfTimeFrameNumbers;
   std::vector<std::string> listOfTimeFrameKeys;
+  bool arrowFormat = false;
 };
 FileNameHolder* makeFileNameHolder(std::string fileName);
 
@@ -72,6 +78,10 @@ struct DataInputDescriptor {
   FileAndFolder getFileFolder(int counter, int numTF);
   int getTimeFramesInFile(int counter);
 
+  // Arrow IPC input, see ArrowFileHelpers
+  bool isArrowFile(int counter);
+  std::shared_ptr<arrow::Table> getArrowTable(int counter, int numTF, std::string const& treename);
+
   void closeInputFile();
   bool isAlienSupportOn() { return mAlienSupport; }
 
@@ -114,6 +124,8 @@ struct DataInputDirector {
 
   std::unique_ptr<TTreeReader> getTreeReader(header::DataHeader dh, int counter, int numTF, std::string treeName);
   TTree* getDataTree(header::DataHeader dh, int counter, int numTF);
+  bool isArrowFile(header::DataHeader dh, int counter);
+  std::shared_ptr<arrow::Table> getArrowTable(header::DataHeader dh, int counter, int numTF);
   uint64_t getTimeFrameNumber(header::DataHeader dh, int counter, int numTF);
   FileAndFolder getFileFolder(header::DataHeader dh, int counter, int numTF);
   int getTimeFramesInFile(header::DataHeader dh, int counter);
@@ -132,6 +144,7 @@ struct DataInputDirector {
 
   bool readJsonDocument(rapidjson::Document* doc);
   bool isValid();
+  std::pair<DataInputDescriptor*, std::string> getDescriptorAndTreeName(header::DataHeader dh);
 };
 
 } // namespace o2::framework
@@ -75,6 +75,11 @@ struct DataOutputDirector {
   void setNumberTimeFramesToMerge(int ntfmerge) { mnumberTimeFramesToMerge = ntfmerge > 0 ? ntfmerge : 1; }
   std::string getFileMode() { return mfileMode; }
   void setFileMode(std::string filemode) { mfileMode = filemode; }
+  // output format: root (TTrees), arrow, arrow-lz4, or arrow-zstd (Arrow IPC files)
+  std::string getOutputFormat() { return mOutputFormat; }
+  void setOutputFormat(std::string format);
+  bool isArrowOutput() { return mOutputFormat.rfind("arrow", 0) == 0; }
+  std::string getArrowCodec();
 
   // get matching DataOutputDescriptors
   std::vector<DataOutputDescriptor*> getDataOutputDescriptors(header::DataHeader dh);
@@ -83,6 +88,9 @@ struct DataOutputDirector {
   // get the matching TFile
   FileAndFolder getFileFolder(DataOutputDescriptor* dodesc, uint64_t folderNumber);
 
+  // get the name of the Arrow IPC file, creating the DF_ folder if needed
+  std::string getArrowFileName(DataOutputDescriptor* dodesc, uint64_t folderNumber);
+
   void closeDataFiles();
 
   void setFilenameBase(std::string dfn);
@@ -99,6 +107,7 @@ struct DataOutputDirector {
   bool mdebugmode = false;
   int mnumberTimeFramesToMerge = 1;
   std::string mfileMode = "RECREATE";
+  std::string mOutputFormat = "root";
 
   std::tuple<std::string, std::string, int> readJsonDocument(Document* doc);
   const std::tuple<std::string, std::string, int> memptyanswer = std::make_tuple(std::string(""), std::string(""), -1);
@@ -30,8 +30,11 @@
 #include <fairmq/FairMQDevice.h>
 #include <fairmq/FairMQParts.h>
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <uv.h>
 
 namespace o2::framework
@@ -41,6 +44,42 @@ struct InputChannelInfo;
 struct DeviceState;
 struct ComputingQuotaEvaluator;
 
+/// When more than one stream is processing, the outputs are sent one stream
+/// at the time, since the channels are not thread safe, and in the order
+/// in which the inputs were handed to the streams.
+struct StreamSequencer {
+  std::mutex mutex;
+  std::condition_variable turn;
+  /// The ticket given to the next action handed to a stream
+  uint64_t nextTicket = 0;
+  /// The ticket of the action which is allowed to send its outputs
+  uint64_t nowServing = 0;
+};
+
+/// When the inputs carrying a LatencyTraceHeader were received, keyed by
+/// their header. This is not stored in the header itself, since received
+/// messages might be shared with other consumers.
+struct LatencyArrivals {
+  void add(void const* header, uint64_t arrival);
+  /// The arrival of @a header, 0 if unknown. The entry is removed.
+  uint64_t take(void const* header);
+
+  std::mutex mutex;
+  std::unordered_map<void const*, uint64_t> byHeader;
+  uint64_t lastPruned = 0;
+};
+
+/// What the main thread takes from the relayer when handing a timeslice to
+/// a stream. The stream never accesses the slot, which can be reused as soon
+/// as its inputs are taken.
+struct HandedOffTimeslice {
+  DataRelayer::RecordAction action;
+  TimesliceId timeslice;
+  uint32_t firstTFCounter = 0;
+  uint32_t firstTFOrbit = 0;
+  std::vector<MessageSet> inputs;
+};
+
 /// Context associated to a given DataProcessor.
 /// For the time being everything points to
 /// members of the DataProcessingDevice and
@@ -61,6 +100,15 @@ struct DeviceContext {
   DeviceState* state = nullptr;
   ComputingQuotaEvaluator* quotaEvaluator = nullptr;
   DataProcessingStats* stats = nullptr;
+  /// Only set when the device runs more than one stream.
+  StreamSequencer* sequencer = nullptr;
+  /// Actions which are ready but still waiting for a free stream.
+  /// Only set when the device runs more than one stream.
+  std::deque<DataRelayer::RecordAction>* pendingActions = nullptr;
+  /// How many streams are currently processing in a worker thread.
+  int runningStreams = 0;
+  /// Only set when the critical path latency is traced, see --latency-trace.
+  LatencyArrivals* latencyArrivals = nullptr;
 };
 
 struct DataProcessorContext {
@@ -68,6 +116,15 @@ struct DataProcessorContext {
   // not shared by threads.
   bool* wasActive = nullptr;
   bool allDone = false;
+  /// The place in the output sequence of the action being processed,
+  /// when running on a stream other than the main one.
+  uint64_t ticket = 0;
+  /// The timeslice being processed, when running on a stream other
+  /// than the main one.
+  HandedOffTimeslice* handedOff = nullptr;
+  /// What the outputs of a stream other than the main one used of its
+  /// offer. Accounted once the stream is done.
+  std::vector<ComputingQuotaConsumer> offerConsumers;
 
   // These are pointers to the one owned by the DataProcessingDevice
   // but they are fully reentrant / thread safe and therefore can
@@ -123,11 +180,16 @@ class DataProcessingDevice : public FairMQDevice
   static void doPrepare(DataProcessorContext& context);
   static void handleData(DataProcessorContext& context, InputChannelInfo&);
   static bool tryDispatchComputation(DataProcessorContext& context, std::vector<DataRelayer::RecordAction>& completed);
+  /// Process the actions in @a completed, which were already taken from the relayer.
+  static void dispatchComputation(DataProcessorContext& context, std::vector<DataRelayer::RecordAction>& completed);
   std::vector<DataProcessorContext> mDataProcessorContexes;
 
  protected:
   void error(const char* msg);
   void fillContext(DataProcessorContext& context, DeviceContext& deviceContext);
+  /// Hand the pending actions to the streams which are free and have
+  /// enough resources to run them.
+  void handOffActions();
 
  private:
   DeviceContext mDeviceContext;
@@ -162,6 +224,21 @@ class DataProcessingDevice : public FairMQDevice
   std::vector<uv_work_t> mHandles;                               /// Handles to use to schedule work.
   std::vector<TaskStreamInfo> mStreams;                          /// Information about the task running in the associated mHandle.
   ComputingQuotaEvaluator& mQuotaEvaluator;                      /// The component which evaluates if the offer can be used to run a task
+
+  /// What a stream other than the main one owns, so that it can
+  /// create its outputs independently.
+  struct StreamResources {
+    std::unique_ptr<ServiceRegistry> registry;
+    TimingInfo timingInfo;
+    std::unique_ptr<DataAllocator> allocator;
+    std::vector<DataRelayer::RecordAction> completed;
+    HandedOffTimeslice handedOff;
+    bool wasActive = false;
+  };
+  std::vector<std::unique_ptr<StreamResources>> mStreamResources; /// Resources of the streams, index 0 (the main one) is unused.
+  std::deque<DataRelayer::RecordAction> mPendingActions;          /// Actions waiting for a free stream.
+  StreamSequencer mSequencer;                                     /// Orders the outputs of the streams.
+  LatencyArrivals mLatencyArrivals;                               /// When the traced inputs were received.
 };
 
 } // namespace o2::framework
@@ -21,6 +21,7 @@
 #include "Framework/Tracing.h"
 
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -34,6 +35,8 @@ class Monitoring;
 namespace o2::framework
 {
 
+struct RouteMatchingTable;
+
 /// Helper struct to hold statistics about the relaying process.
 struct DataRelayerStats {
   uint64_t malformedInputs = 0;         /// Malformed inputs which the user attempted to process
@@ -77,10 +80,12 @@ class DataRelayer
               std::vector<InputRoute> const& routes,
               monitoring::Monitoring&,
               TimesliceIndex&);
+  ~DataRelayer();
 
   /// This invokes the appropriate `InputRoute::danglingChecker` on every
-  /// entry in the cache and if it returns true, it creates a new
+  /// entry in the cache which is due and if it returns true, it creates a new
   /// cache entry by invoking the associated `InputRoute::expirationHandler`.
+  /// Entries are checked again only at the time the checker asks for.
   /// @a createNew true if the dangling inputs are allowed to create new slots.
   /// @return true if there were expirations, false if not.
   ActivityStats processDanglingInputs(std::vector<ExpirationHandler> const&,
@@ -129,6 +134,10 @@ class DataRelayer
   /// so that we can mutex on it.
   TimesliceId getTimesliceForSlot(TimesliceSlot slot);
 
+  /// Mark a given slot as scheduled for processing, so that it is not
+  /// reused under backpressure until getInputsForTimeslice takes its inputs.
+  void markAsPending(TimesliceSlot slot);
+
   /// Mark a given slot as done so that the GUI
   /// can reflect that.
   void updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStatus, CacheEntryStatus newStatus);
@@ -155,6 +164,8 @@ class DataRelayer
   CompletionPolicy mCompletionPolicy;
   std::vector<size_t> mDistinctRoutesIndex;
   std::vector<data_matcher::DataDescriptorMatcher> mInputMatchers;
+  /// Lookup table to avoid evaluating all of mInputMatchers for each message.
+  std::unique_ptr<RouteMatchingTable const> mRouteMatchingTable;
   std::vector<data_matcher::VariableContext> mVariableContextes;
   std::vector<CacheEntryStatus> mCachedStateMetrics;
 
@@ -151,6 +151,11 @@ struct DataSpecUtils {
   /// and we can add corner cases as we go.
   static ConcreteDataTypeMatcher asConcreteDataTypeMatcher(InputSpec const& spec);
 
+  /// Same as asConcreteDataTypeMatcher, but returns an empty optional rather
+  /// than throwing when the InputSpec does not select a unique data type,
+  /// e.g. because of a wildcard or of an OR in the query.
+  static std::optional<ConcreteDataTypeMatcher> optionalConcreteDataTypeMatcher(InputSpec const& spec);
+
   /// If possible extract the DataOrigin from an InputSpec.
   /// This will not always be possible, depending on how complex of
   /// a query the InputSpec does, however in most cases it should be ok
@@ -28,7 +28,15 @@ struct TimesliceSlot;
 
 struct ExpirationHandler {
   using Creator = std::function<TimesliceSlot(TimesliceIndex&)>;
-  using Checker = std::function<bool(uint64_t timestamp)>;
+  /// Special value for the time of the next check, meaning the record
+  /// can not expire anymore.
+  static constexpr uint64_t NEVER = -1;
+  /// Whether the record associated to @a timestamp is expired. When it
+  /// is not, @a nextCheck is set to the earliest time (in microseconds
+  /// since the epoch) at which it might be, or to NEVER. Checkers which
+  /// leave it untouched are asked again at every iteration, therefore the
+  /// ones in LifetimeHelpers which can return false all set it.
+  using Checker = std::function<bool(uint64_t timestamp, uint64_t& nextCheck)>;
   using Handler = std::function<void(ServiceRegistry&, PartRef& expiredInput, uint64_t timestamp, data_matcher::VariableContext& variables)>;
 
   RouteIndex routeIndex;
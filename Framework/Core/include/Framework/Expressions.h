@@ -340,6 +340,9 @@ using Operations = std::vector<ColumnOperationSpec>;
 /// Function to create an internal operation sequence from a filter tree
 Operations createOperations(Filter const& expression);
 
+/// Function to compute a hash identifying an expression by its operation sequence
+uint32_t hashExpression(Filter const& expression);
+
 /// Function to check compatibility of a given arrow schema with operation sequence
 bool isSchemaCompatible(gandiva::SchemaPtr const& Schema, Operations const& opSpecs);
 /// Function to create gandiva expression tree from operation sequence
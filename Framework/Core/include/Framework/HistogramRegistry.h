@@ -19,6 +19,7 @@
 #include "Framework/OutputRef.h"
 #include "Framework/OutputObjHeader.h"
 #include "Framework/OutputSpec.h"
+#include "Framework/ProcessingSlot.h"
 #include "Framework/SerializationMethods.h"
 #include "Framework/TableBuilder.h"
 #include "Framework/RuntimeError.h"
@@ -62,6 +63,35 @@ struct HistFiller {
 
   template <typename B, typename T>
   static int getBaseElementSize(T* ptr);
+
+  // equidistant axis description with the bin finding arithmetic of TAxis::FindBin
+  struct FixedAxis {
+    explicit FixedAxis(const TAxis* axis) : nBins(axis->GetNbins()), min(axis->GetXmin()), max(axis->GetXmax()) {}
+    int findBin(double x) const
+    {
+      if (x < min) {
+        return 0;
+      }
+      if (!(x < max)) {
+        return nBins + 1;
+      }
+      return 1 + static_cast<int>(nBins * (x - min) / (max - min));
+    }
+    int nBins{};
+    double min{};
+    double max{};
+  };
+
+  // number of table rows for which bin indices are computed in one go
+  static constexpr int FIXED_BINNING_BATCH_SIZE{256};
+
+  // fast path for filling TH1, TH2 and TH3 with equidistant binning from table columns;
+  // returns false if the histogram does not qualify and the generic fill must be used instead
+  template <typename... Cs, typename R, typename T>
+  static bool fillHistFixedBinning(std::shared_ptr<R>& hist, const T& filtered);
+
+  template <int nDim, typename R>
+  static void addFixedBinningBatch(R* hist, const std::array<FixedAxis, 3>& axes, const double (*values)[FIXED_BINNING_BATCH_SIZE], const double* weights, int nEntries, std::array<double, 11>& stats);
 };
 
 //**************************************************************************************************
@@ -132,6 +162,13 @@ class HistogramRegistry
   // print summary of the histograms stored in registry
   void print(bool showAxisDetails = false);
 
+  // create n empty copies of all histograms, filled instead of the originals by the workers of a parallel process(),
+  // histograms added since the previous call get their copies as well
+  void createShadows(int n);
+
+  // merge the content of the shadow copies into the histograms and reset the copies
+  void mergeShadows();
+
   // lookup distance counter for benchmarking
   mutable uint32_t lookup = 0;
 
@@ -150,6 +187,13 @@ class HistogramRegistry
   template <typename T>
   uint32_t getHistIndex(const T& histName);
 
+  // histogram at given position, or its shadow copy when called from a parallel process() worker
+  HistPtr& valueAt(uint32_t idx)
+  {
+    auto slot = ProcessingSlot::current();
+    return (slot <= 0 || mShadowValues.empty()) ? mRegistryValue[idx] : mShadowValues[slot - 1][idx];
+  }
+
   constexpr uint32_t imask(uint32_t i) const
   {
     return i & REGISTRY_BITMASK;
@@ -177,6 +221,7 @@ class HistogramRegistry
   static constexpr uint32_t MAX_REGISTRY_SIZE{REGISTRY_BITMASK + 1};
   std::array<uint32_t, MAX_REGISTRY_SIZE> mRegistryKey{};
   std::array<HistPtr, MAX_REGISTRY_SIZE> mRegistryValue{};
+  std::vector<std::array<HistPtr, MAX_REGISTRY_SIZE>> mShadowValues{};
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -229,11 +274,123 @@ void HistFiller::fillHistAny(std::shared_ptr<R>& hist, const T& table, const o2:
     return;
   }
   auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, o2::framework::expressions::createSelection(table.asArrowTable(), filter)};
+  if constexpr (std::is_same_v<TH1, R> || std::is_same_v<TH2, R> || std::is_same_v<TH3, R>) {
+    if (fillHistFixedBinning<Cs...>(hist, filtered)) {
+      return;
+    }
+  }
   for (auto& t : filtered) {
     fillHistAny(hist, (*(static_cast<Cs>(t).getIterator()))...);
   }
 }
 
+template <typename... Cs, typename R, typename T>
+bool HistFiller::fillHistFixedBinning(std::shared_ptr<R>& hist, const T& filtered)
+{
+  constexpr int nDim = std::is_same_v<TH3, R> ? 3 : (std::is_same_v<TH2, R> ? 2 : 1);
+  constexpr int nCols = sizeof...(Cs);
+  constexpr bool weighted = (nCols == nDim + 1);
+  if constexpr (nCols != nDim && !weighted) {
+    return false;
+  } else {
+    if (hist->GetBuffer()) {
+      return false;
+    }
+    const std::array<const TAxis*, 3> rootAxes{hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+    for (int d = 0; d < nDim; ++d) {
+      if (rootAxes[d]->GetXbins()->fN != 0 || rootAxes[d]->CanExtend()) {
+        return false;
+      }
+    }
+    const std::array<FixedAxis, 3> axes{FixedAxis{rootAxes[0]}, FixedAxis{rootAxes[1]}, FixedAxis{rootAxes[2]}};
+
+    // column values are gathered row-wise into per-column batches, the binning is then done column-wise
+    double values[nCols][FIXED_BINNING_BATCH_SIZE];
+    std::array<double, 11> stats{};
+    hist->GetStats(stats.data());
+    const double entries = hist->GetEntries();
+    int nEntries = 0;
+    int64_t nTotal = 0;
+    auto flush = [&]() {
+      const double* weights = weighted ? values[nCols - 1] : nullptr;
+      if (weights && !hist->GetSumw2N() && !hist->TestBit(TH1::kIsNotW)) {
+        for (int i = 0; i < nEntries; ++i) {
+          if (weights[i] != 1.) {
+            hist->Sumw2();
+            break;
+          }
+        }
+      }
+      addFixedBinningBatch<nDim>(hist.get(), axes, values, weights, nEntries, stats);
+      nTotal += nEntries;
+      nEntries = 0;
+    };
+    for (auto& t : filtered) {
+      int col = 0;
+      ((values[col++][nEntries] = static_cast<double>(*(static_cast<Cs>(t).getIterator()))), ...);
+      if (++nEntries == FIXED_BINNING_BATCH_SIZE) {
+        flush();
+      }
+    }
+    if (nEntries) {
+      flush();
+    }
+    hist->PutStats(stats.data());
+    hist->SetEntries(entries + nTotal);
+    return true;
+  }
+}
+
+template <int nDim, typename R>
+void HistFiller::addFixedBinningBatch(R* hist, const std::array<FixedAxis, 3>& axes, const double (*values)[FIXED_BINNING_BATCH_SIZE], const double* weights, int nEntries, std::array<double, 11>& stats)
+{
+  int bins[nDim][FIXED_BINNING_BATCH_SIZE];
+  for (int d = 0; d < nDim; ++d) {
+    const FixedAxis axis = axes[d];
+    for (int i = 0; i < nEntries; ++i) {
+      bins[d][i] = axis.findBin(values[d][i]);
+    }
+  }
+
+  double* sumw2 = hist->GetSumw2N() ? hist->GetSumw2()->GetArray() : nullptr;
+  const bool statOverflows = hist->GetStatOverflowsBehaviour();
+  for (int i = 0; i < nEntries; ++i) {
+    const double w = weights ? weights[i] : 1.;
+    int globalBin = bins[nDim - 1][i];
+    bool inRange = (bins[nDim - 1][i] > 0 && bins[nDim - 1][i] <= axes[nDim - 1].nBins);
+    for (int d = nDim - 2; d >= 0; --d) {
+      globalBin = bins[d][i] + (axes[d].nBins + 2) * globalBin;
+      inRange = inRange && (bins[d][i] > 0 && bins[d][i] <= axes[d].nBins);
+    }
+    hist->AddBinContent(globalBin, w);
+    if (sumw2) {
+      sumw2[globalBin] += w * w;
+    }
+    if (!inRange && !statOverflows) {
+      continue;
+    }
+    // same statistics bookkeeping as TH1::Fill, TH2::Fill and TH3::Fill
+    const double x = values[0][i];
+    stats[0] += w;
+    stats[1] += w * w;
+    stats[2] += w * x;
+    stats[3] += w * x * x;
+    if constexpr (nDim > 1) {
+      const double y = values[1][i];
+      stats[4] += w * y;
+      stats[5] += w * y * y;
+      stats[6] += w * x * y;
+      if constexpr (nDim > 2) {
+        const double z = values[2][i];
+        stats[7] += w * z;
+        stats[8] += w * z * z;
+        stats[9] += w * x * z;
+        stats[10] += w * y * z;
+      }
+    }
+  }
+}
+
 template <typename T>
 double HistFiller::getSize(std::shared_ptr<T>& hist, double fillFraction)
 {
@@ -331,7 +488,7 @@ constexpr HistogramRegistry::HistName::HistName(const ConstStr<chars...>& hashed
 template <typename T>
 std::shared_ptr<T>& HistogramRegistry::get(const HistName& histName)
 {
-  if (auto histPtr = std::get_if<std::shared_ptr<T>>(&mRegistryValue[getHistIndex(histName)])) {
+  if (auto histPtr = std::get_if<std::shared_ptr<T>>(&valueAt(getHistIndex(histName)))) {
     return *histPtr;
   } else {
     throw runtime_error_f(R"(Histogram type specified in get<>(HIST("%s")) does not match the actual type of the histogram!)", histName.str);
@@ -379,13 +536,13 @@ uint32_t HistogramRegistry::getHistIndex(const T& histName)
 template <typename... Ts>
 void HistogramRegistry::fill(const HistName& histName, Ts&&... positionAndWeight)
 {
-  std::visit([&positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, std::forward<Ts>(positionAndWeight)...); }, mRegistryValue[getHistIndex(histName)]);
+  std::visit([&positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, std::forward<Ts>(positionAndWeight)...); }, valueAt(getHistIndex(histName)));
 }
 
 template <typename... Cs, typename T>
 void HistogramRegistry::fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter)
 {
-  std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[getHistIndex(histName)]);
+  std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, valueAt(getHistIndex(histName)));
 }
 
 } // namespace o2::framework
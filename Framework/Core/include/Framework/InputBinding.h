@@ -0,0 +1,62 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_INPUTBINDING_H_
+#define O2_FRAMEWORK_INPUTBINDING_H_
+
+#include <vector>
+
+namespace o2::framework
+{
+
+struct InputRoute;
+
+/// A handle to one of the inputs of a device. Looking up an input by name
+/// means going through all the InputRoutes at every InputRecord::get. An
+/// InputBinding can instead be resolved once, e.g. in the init callback,
+/// after which it directly refers to the position of the input:
+///
+/// <pre>
+///   InputBinding mClusters{"clusters"};
+///   ...
+///   void init(InitContext& ic)
+///   {
+///     mClusters.resolve(ic.services().get<DeviceSpec const>().inputs);
+///   }
+///   void run(ProcessingContext& pc)
+///   {
+///     auto clusters = pc.inputs().get<gsl::span<Cluster>>(mClusters);
+///   }
+/// </pre>
+///
+/// An unresolved binding still works, and is looked up by name.
+struct InputBinding {
+  explicit constexpr InputBinding(char const* name_)
+    : name{name_}
+  {
+  }
+
+  /// Resolve the position of the binding among the inputs described by
+  /// @a routes. @return false if none of them has such a binding.
+  bool resolve(std::vector<InputRoute> const& routes);
+
+  constexpr bool resolved() const
+  {
+    return pos >= 0;
+  }
+
+  char const* name;
+  /// Position in the InputRecord, -1 when not resolved.
+  int pos = -1;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_INPUTBINDING_H_
@@ -13,6 +13,7 @@
 
 #include "Framework/DataRef.h"
 #include "Framework/DataRefUtils.h"
+#include "Framework/InputBinding.h"
 #include "Framework/InputRoute.h"
 #include "Framework/TypeTraits.h"
 #include "Framework/TableConsumer.h"
@@ -176,6 +177,11 @@ class InputRecord
 
   int getPos(const char* name) const;
   int getPos(const std::string& name) const;
+  /// @return the position of @a binding, without any lookup if it was resolved.
+  int getPos(InputBinding const& binding) const
+  {
+    return binding.resolved() ? binding.pos : getPos(binding.name);
+  }
 
   DataRef getByPos(int pos, int part = 0) const;
 
@@ -218,6 +224,12 @@ class InputRecord
           throw runtime_error_f("Unknown argument requested %s - %s", binding, e.what());
         }
       }
+    } else if constexpr (std::is_same_v<decayed, InputBinding>) {
+      int pos = getPos(binding);
+      if (pos < 0) {
+        throw runtime_error_f("Unknown argument requested %s - no matching route found", binding.name);
+      }
+      ref = this->getByPos(pos, part);
     } else if constexpr (std::is_same_v<decayed, DataRef>) {
       ref = binding;
     } else {
@@ -415,6 +427,33 @@ class InputRecord
     }
   }
 
+  /// Get all the parts of a multi-part input as spans of messageable type
+  /// @a T in one go, resolving @a binding only once.
+  template <typename T, typename R>
+  std::vector<gsl::span<T const>> getSpans(R const& binding) const
+  {
+    int pos = -1;
+    if constexpr (std::is_same_v<std::decay_t<R>, std::string>) {
+      pos = getPos(binding.c_str());
+    } else {
+      pos = getPos(binding);
+    }
+    if (pos < 0) {
+      throw runtime_error("Unknown argument requested - no matching route found");
+    }
+    std::vector<gsl::span<T const>> result;
+    auto nParts = getNofParts(pos);
+    result.reserve(nParts);
+    for (size_t part = 0; part < nParts; ++part) {
+      auto ref = getByPos(pos, part);
+      if (ref.header == nullptr) {
+        continue;
+      }
+      result.emplace_back(get<gsl::span<T>>(ref));
+    }
+    return result;
+  }
+
   template <typename T>
   T get_boost(char const* binding) const
   {
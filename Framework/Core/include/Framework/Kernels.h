@@ -104,6 +104,66 @@ auto sliceByColumn(
 
   return arrow::Status::OK();
 }
+
+/// Compute the position of the groups of rows sharing the same value of the
+/// index column @a key in a single pass over the column, without slicing
+/// the table. The column must be sorted in increasing order. Negative
+/// values (unassigned rows) may appear between the groups, but not inside
+/// one, since each group is a contiguous slice of the table.
+/// @a offsets and @a sizes are resized to @a fullSize and hold the first row
+/// and the number of rows of the group for each value of the index. Empty
+/// groups are placed at the end of the preceding group.
+template <typename T>
+auto groupByColumn(
+  char const* key,
+  std::shared_ptr<arrow::Table> const& input,
+  T fullSize,
+  std::vector<uint64_t>* offsets,
+  std::vector<int>* sizes)
+{
+  using ArrowArray = arrow::NumericArray<typename detail::ConversionTraits<T>::ArrowType>;
+  offsets->assign(fullSize, 0);
+  sizes->assign(fullSize, 0);
+  auto column = input->GetColumnByName(key);
+  if (column == nullptr) {
+    return arrow::Status::Invalid("Missing index column ", key);
+  }
+
+  uint64_t row = 0;
+  T last = -1; // last group seen
+  for (auto const& chunk : column->chunks()) {
+    auto values = std::static_pointer_cast<ArrowArray>(chunk)->raw_values();
+    for (auto i = 0; i < chunk->length(); ++i, ++row) {
+      auto v = values[i];
+      if (v < 0) {
+        continue;
+      }
+      if (v != last) {
+        if (v >= fullSize) {
+          return arrow::Status::Invalid("Index ", v, " in column ", key, " is out of range (", fullSize, ")");
+        }
+        if (v < last || (*sizes)[v] != 0) {
+          return arrow::Status::Invalid("Index column ", key, " is not sorted");
+        }
+        (*offsets)[v] = row;
+        last = v;
+      } else if (row != (*offsets)[v] + (*sizes)[v]) {
+        return arrow::Status::Invalid("Index column ", key, " has unassigned rows inside the group ", v);
+      }
+      ++(*sizes)[v];
+    }
+  }
+
+  uint64_t end = 0;
+  for (auto v = 0; v < fullSize; ++v) {
+    if ((*sizes)[v] != 0) {
+      end = (*offsets)[v] + (*sizes)[v];
+    } else {
+      (*offsets)[v] = end;
+    }
+  }
+  return arrow::Status::OK();
+}
 } // namespace o2::framework
 
 #endif // O2_FRAMEWORK_KERNELS_H_
@@ -0,0 +1,104 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_LATENCYTRACEHEADER_H_
+#define O2_FRAMEWORK_LATENCYTRACEHEADER_H_
+
+#include "Headers/DataHeader.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+namespace o2::framework
+{
+
+//__________________________________________________________________________________________________
+/// @struct LatencyTraceHeader
+/// @brief the chain of devices a timeslice went through, with the time spent in each of them
+///
+/// With --latency-trace, every output produced while processing a timeslice
+/// carries this header, stacked after the DataProcessingHeader. It contains the hops of the
+/// critical path of the timeslice, i.e. the hops of the input which arrived
+/// last, followed by the one of the device which produced the output.
+/// Only the most recent MAX_HOPS hops are kept.
+///
+/// All the timestamps are in nanoseconds of the monotonic clock, so they can
+/// only be compared between devices running on the same node.
+///
+/// @ingroup aliceo2_dataformats_dataheader
+struct LatencyTraceHeader : public header::BaseHeader {
+  constexpr static const o2::header::HeaderType sHeaderType = "LatTrace";
+  static const uint32_t sVersion = 1;
+  static constexpr size_t MAX_HOPS = 8;
+
+  struct Hop {
+    /// Hash of the DeviceSpec::id, see deviceHash.
+    uint32_t device = 0;
+    uint32_t reserved = 0;
+    /// When the input the device waited for arrived.
+    uint64_t enqueue = 0;
+    /// When the processing started.
+    uint64_t start = 0;
+    /// When the message carrying the header was sent, 0 until then.
+    uint64_t finish = 0;
+  };
+
+  uint32_t hopsCount = 0;
+  /// How many hops were dropped at the beginning of the path.
+  uint32_t droppedHops = 0;
+  Hop hops[MAX_HOPS];
+
+  LatencyTraceHeader()
+    : BaseHeader(sizeof(LatencyTraceHeader), sHeaderType, header::gSerializationMethodNone, sVersion)
+  {
+  }
+
+  LatencyTraceHeader(const LatencyTraceHeader&) = default;
+  LatencyTraceHeader& operator=(const LatencyTraceHeader&) = default;
+
+  static uint64_t now()
+  {
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+  }
+
+  /// FNV-1a of the device id, so that the header does not need to carry strings.
+  static constexpr uint32_t deviceHash(std::string_view id)
+  {
+    uint32_t hash = 2166136261u;
+    for (auto c : id) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+  }
+
+  /// Append @a hop, dropping the oldest one if the path is full.
+  void addHop(Hop const& hop)
+  {
+    if (hopsCount == MAX_HOPS) {
+      for (size_t i = 1; i < MAX_HOPS; ++i) {
+        hops[i - 1] = hops[i];
+      }
+      hopsCount--;
+      droppedHops++;
+    }
+    hops[hopsCount++] = hop;
+  }
+
+  static const LatencyTraceHeader* Get(const BaseHeader* baseHeader)
+  {
+    return (baseHeader->description == LatencyTraceHeader::sHeaderType) ? static_cast<const LatencyTraceHeader*>(baseHeader) : nullptr;
+  }
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_LATENCYTRACEHEADER_H_
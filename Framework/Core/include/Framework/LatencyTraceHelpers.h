@@ -0,0 +1,55 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_LATENCYTRACEHELPERS_H_
+#define O2_FRAMEWORK_LATENCYTRACEHELPERS_H_
+
+#include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceSpec.h"
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Latency of a chain of devices, in microseconds, over the last samples
+/// reported by the sinks.
+struct LatencyPercentiles {
+  /// The two ends of an edge, or all the devices of a path.
+  std::vector<std::string> devices;
+  size_t samples = 0;
+  int p50 = 0;
+  int p99 = 0;
+};
+
+/// Driver side of the LatencyTraceHeader: the sinks report the critical
+/// path of each timeslice as "latency-edge-<from>-<to>" and
+/// "latency-path-<device>-..." metrics, using the device hashes, and these
+/// helpers put them back together.
+struct LatencyTraceHelpers {
+  /// One entry per edge of the topology which was on a critical path,
+  /// slowest p99 first.
+  static std::vector<LatencyPercentiles> edges(std::vector<DeviceSpec> const& specs,
+                                               std::vector<DeviceMetricsInfo> const& metrics);
+  /// One entry per critical path, slowest p99 first.
+  static std::vector<LatencyPercentiles> paths(std::vector<DeviceSpec> const& specs,
+                                               std::vector<DeviceMetricsInfo> const& metrics);
+  /// Write @a edges and @a paths as JSON.
+  static void dumpToJSON(std::ostream& out,
+                         std::vector<LatencyPercentiles> const& edges,
+                         std::vector<LatencyPercentiles> const& paths);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_LATENCYTRACEHELPERS_H_
@@ -37,6 +37,7 @@ namespace o2
 namespace framework
 {
 class Output;
+struct MessageSet;
 
 class MessageContext
 {
@@ -475,6 +476,9 @@ class MessageContext
           FairMQParts parts = std::move(message->finalize());
           assert(message->empty());
           assert(parts.Size() == 2);
+          if (mTap) {
+            mTap(*parts.At(0), *parts.At(1), outputs);
+          }
           for (auto& part : parts) {
             outputs[&(message->channel())].AddPart(std::move(part));
           }
@@ -544,12 +548,43 @@ class MessageContext
   /// mMessages then in mScheduledMessages
   o2::header::DataHeader* findMessageHeader(const Output& spec);
 
+  /// Invoked with the header and the payload of every message about to be
+  /// sent, including the ones of the string, raw buffer and Arrow backends
+  /// (see DataProcessor::doSend). Further header / payload pairs can be added to @a outputs, the
+  /// parts to be sent on each channel (see getChannelRef), e.g. to send a
+  /// sample of the message elsewhere.
+  using Tap = std::function<void(FairMQMessage& header, FairMQMessage& payload, std::unordered_map<std::string const*, FairMQParts>& outputs)>;
+
+  void setTap(Tap tap)
+  {
+    mTap = std::move(tap);
+  }
+
+  Tap const& tap() const
+  {
+    return mTap;
+  }
+
+  /// Make the messages of the inputs being processed known to the context,
+  /// so that their payload can be sent again without copying it.
+  /// nullptr when nothing is being processed.
+  void setInputs(std::vector<MessageSet> const* inputs)
+  {
+    mInputs = inputs;
+  }
+
+  /// return the input message whose payload starts at @a payload, nullptr
+  /// if none of the inputs being processed has it
+  FairMQMessage const* findInputPayload(const char* payload) const;
+
  private:
   FairMQDeviceProxy mProxy;
   Messages mMessages;
   Messages mScheduledMessages;
   DispatchControl mDispatchControl;
   std::unordered_map<std::string, std::unique_ptr<std::string>> mChannelRefs;
+  std::vector<MessageSet> const* mInputs = nullptr;
+  Tap mTap;
 };
 } // namespace framework
 } // namespace o2
@@ -0,0 +1,33 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_PROCESSINGSLOT_H_
+#define O2_FRAMEWORK_PROCESSINGSLOT_H_
+
+namespace o2::framework
+{
+
+/// Index of the worker thread currently running the process() of a
+/// thread-safe analysis task. Outputs of the task (HistogramRegistry,
+/// OutputObj) use it to redirect writes of the slot N > 0 to the shadow copy
+/// N - 1, merged back at the end of each timeframe. The slot 0, i.e. the
+/// thread invoking process(), uses the outputs themselves. It is -1 outside
+/// of the workers.
+struct ProcessingSlot {
+  static int& current()
+  {
+    static thread_local int slot = -1;
+    return slot;
+  }
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_PROCESSINGSLOT_H_
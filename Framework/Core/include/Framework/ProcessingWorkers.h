@@ -0,0 +1,61 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_PROCESSINGWORKERS_H_
+#define O2_FRAMEWORK_PROCESSINGWORKERS_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// A fixed set of threads processing the groups of a thread-safe analysis
+/// task. The threads are created once, when the task is initialised, and
+/// wait for the next timeframe in between. Each of them runs with its own
+/// ProcessingSlot, the calling thread being the slot 0.
+class ProcessingWorkers
+{
+ public:
+  /// Create @a nSlots - 1 threads, the thread calling run() being the slot 0.
+  explicit ProcessingWorkers(int nSlots);
+  ~ProcessingWorkers();
+
+  int size() const { return mNSlots; }
+
+  /// Run @a job in all the slots concurrently and wait for all of them to
+  /// finish. The ProcessingSlot of each thread is set while running the job.
+  /// The first exception thrown by one of the jobs is rethrown.
+  void run(std::function<void()> const& job);
+
+ private:
+  void execute(int slot);
+  void loop(int slot);
+
+  int mNSlots;
+  std::vector<std::thread> mThreads;
+  std::mutex mMutex;
+  std::condition_variable mWorkReady;
+  std::condition_variable mWorkDone;
+  std::function<void()> const* mJob = nullptr;
+  std::vector<std::exception_ptr> mErrors;
+  uint64_t mGeneration = 0;
+  int mPending = 0;
+  bool mStop = false;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_PROCESSINGWORKERS_H_
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <array>
 #include <functional>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <typeinfo>
@@ -160,6 +161,13 @@ struct ServiceRegistry {
   /// thread safe.
   void declareService(ServiceSpec const& spec, DeviceState& state, fair::mq::ProgOptions& options);
 
+  /// Create a registry for an additional processing stream. The already
+  /// instanciated services named in @a perStream are instanciated again and
+  /// replace, both for lookup and for the callbacks, the ones of this
+  /// registry. All the others are shared. This function is not thread safe.
+  std::unique_ptr<ServiceRegistry> createStreamRegistry(DeviceState& state, fair::mq::ProgOptions& options,
+                                                        std::vector<std::string> const& perStream) const;
+
   /// Bind the callbacks of a service spec to a given service.
   void bindService(ServiceSpec const& spec, void* service);
 
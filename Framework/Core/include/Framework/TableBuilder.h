@@ -193,6 +193,24 @@ struct BuilderUtils {
     }
   }
 
+  /// Appender for a whole column. @a data points to @a nRows contiguous
+  /// values, or to nRows * N values in the case of fixed size arrays.
+  template <typename HolderType, typename T>
+  static arrow::Status columnarAppend(HolderType& holder, size_t nRows, T const* data)
+  {
+    if (data == nullptr || nRows == 0) {
+      return arrow::Status::OK();
+    }
+    if constexpr (std::is_same_v<decltype(holder.builder), std::unique_ptr<arrow::FixedSizeListBuilder>>) {
+      return appendToList<T const>(holder.builder, data, nRows);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      // booleans are bit-packed by arrow, which takes them as bytes
+      return holder.builder->AppendValues(reinterpret_cast<const uint8_t*>(data), nRows, nullptr);
+    } else {
+      return holder.builder->AppendValues(data, nRows, nullptr);
+    }
+  }
+
   template <typename HolderType, typename ITERATOR>
   static arrow::Status append(HolderType& holder, std::pair<ITERATOR, ITERATOR> ip)
   {
@@ -319,6 +337,7 @@ struct BuilderMaker<T (&)[N]> {
 template <typename T, int N>
 struct BuilderMaker<T[N]> {
   using FillType = T*;
+  using STLValueType = T;
   using BuilderType = arrow::FixedSizeListBuilder;
   using ArrowType = arrow::FixedSizeListType;
   using ElementType = typename detail::ConversionTraits<T>::ArrowType;
@@ -474,6 +493,27 @@ struct TableBuilderHelpers {
   {
     return (std::get<Is>(holders).builder->Reserve(s).ok() && ...);
   }
+
+  template <std::size_t... Is, typename HOLDERS, typename COLUMNS>
+  static bool columnarAppend(HOLDERS& holders, size_t nRows, std::index_sequence<Is...>, COLUMNS columns)
+  {
+    return (BuilderUtils::columnarAppend(std::get<Is>(holders), nRows, std::get<Is>(columns)).ok() && ...);
+  }
+
+  /// Like reserveAll, but also reserves the values of fixed size array
+  /// columns, so that filling @a s rows does not reallocate any buffer.
+  template <typename HOLDERS, std::size_t... Is>
+  static bool reserveValues(HOLDERS& holders, size_t s, std::index_sequence<Is...> seq)
+  {
+    auto reserveList = [s](auto& holder) -> bool {
+      if constexpr (std::is_same_v<decltype(holder.builder), std::unique_ptr<arrow::FixedSizeListBuilder>>) {
+        auto listSize = static_cast<const arrow::FixedSizeListType*>(holder.builder->type().get())->list_size();
+        return holder.builder->value_builder()->Reserve(s * listSize).ok();
+      }
+      return true;
+    };
+    return reserveAll(holders, s, seq) && (reserveList(std::get<Is>(holders)) && ...);
+  }
 };
 
 template <typename... ARGS>
@@ -739,6 +779,39 @@ class TableBuilder
     };
   }
 
+  /// Creates a lambda which appends whole columns at once, from one
+  /// contiguous buffer per column. @a nRows is the expected total number
+  /// of rows, for which all the buffers are allocated upfront, so that
+  /// filling does not need to reallocate. Fixed size array columns take
+  /// a flat buffer of nRows * N elements.
+  template <typename... ARGS>
+  auto columnarPersist(std::vector<std::string> const& columnNames, size_t nRows)
+  {
+    static_assert(((is_bounded_array<ARGS>::value || std::is_arithmetic_v<ARGS>)&&...), "Only scalar and fixed size array columns can be filled column-wise");
+    constexpr int nColumns = sizeof...(ARGS);
+    validate(nColumns, columnNames);
+    mArrays.resize(nColumns);
+    makeBuilders<ARGS...>(columnNames, -1);
+    TableBuilderHelpers::reserveValues(*(HoldersTuple<ARGS...>*)mHolders, nRows, std::index_sequence_for<ARGS...>{});
+    makeFinalizer<ARGS...>();
+
+    return [holders = mHolders](unsigned int slot, size_t batchSize, typename BuilderMaker<ARGS>::STLValueType const*... columns) -> void {
+      auto status = TableBuilderHelpers::columnarAppend(*(HoldersTuple<ARGS...>*)holders, batchSize, std::index_sequence_for<ARGS...>{}, std::forward_as_tuple(columns...));
+      if (status == false) {
+        throwError(runtime_error("Unable to append columns"));
+      }
+    };
+  }
+
+  /// Same as above, but starting from a o2::soa::Table
+  template <typename T>
+  auto columnarCursor(size_t nRows)
+  {
+    using persistent_columns_pack = typename T::table_t::persistent_columns_t;
+    constexpr auto persistent_size = pack_size(persistent_columns_pack{});
+    return columnarCursorHelper<typename soa::PackToTable<persistent_columns_pack>::table>(nRows, std::make_index_sequence<persistent_size>());
+  }
+
   /// Reserve method to expand the columns as needed.
   template <typename... ARGS>
   auto reserve(o2::framework::pack<ARGS...> pack, int s)
@@ -777,6 +850,13 @@ class TableBuilder
     return this->template persist<E>(columnNames);
   }
 
+  template <typename T, size_t... Is>
+  auto columnarCursorHelper(size_t nRows, std::index_sequence<Is...>)
+  {
+    std::vector<std::string> columnNames{pack_element_t<Is, typename T::columns>::columnLabel()...};
+    return this->template columnarPersist<typename pack_element_t<Is, typename T::columns>::type...>(columnNames, nRows);
+  }
+
   bool (*mFinalizer)(std::shared_ptr<arrow::Schema> schema, std::vector<std::shared_ptr<arrow::Array>>& arrays, void* holders);
   void* mHolders;
   arrow::MemoryPool* mMemoryPool;
@@ -14,8 +14,10 @@
 
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/CompilerBuiltins.h"
+#include "Framework/ExpirationHandler.h"
 #include "Framework/ServiceHandle.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <tuple>
 #include <vector>
@@ -40,10 +42,11 @@ struct TimesliceSlot {
 
 /// This class keeps the information relative to a given slot in the cache, in
 /// particular which variables are associated to it (and indirectly which
-/// timeslice which is always mapped to the variable 0) and wether we should
+/// timeslice which is always mapped to the variable 0), wether we should
 /// consider the slot dirty (e.g. up for reprocessing by the completion
-/// policy).  It also provides helpers to decide which slot to reuse in case we
-/// are under overload.
+/// policy) and wether it might have dangling inputs to be expired.  It also
+/// provides helpers to decide which slot to reuse in case we are under
+/// overload.
 class TimesliceIndex
 {
  public:
@@ -68,10 +71,28 @@ class TimesliceIndex
   };
 
   inline void resize(size_t s);
+  inline void setBackpressurePolicy(BackpressureOp policy);
   inline size_t size() const;
   inline bool isValid(TimesliceSlot const& slot) const;
   inline bool isDirty(TimesliceSlot const& slot) const;
   inline void markAsDirty(TimesliceSlot slot, bool value);
+  /// A slot is pending when its inputs are ready but not yet taken for
+  /// processing. Pending slots are never replaced under backpressure.
+  inline bool isPending(TimesliceSlot const& slot) const;
+  inline void markAsPending(TimesliceSlot slot, bool value);
+  /// A slot is dangling at time @a now (in microseconds since the epoch)
+  /// when some of its inputs might need to be expired by then, e.g. because
+  /// it was just associated to a new timeslice. Only dangling slots need to
+  /// be checked by the expiration handlers which do not create slots
+  /// themselves.
+  inline bool isDangling(TimesliceSlot const& slot, uint64_t now) const;
+  /// Mark the slot to be checked again at @a nextCheck, 0 meaning as soon as
+  /// possible and ExpirationHandler::NEVER that nothing can expire anymore.
+  inline void markAsDangling(TimesliceSlot slot, uint64_t nextCheck);
+  /// @return the earliest time at which any of the slots is dangling.
+  inline uint64_t getEarliestCheck() const;
+  /// Recompute the earliest check from the valid slots.
+  inline void updateEarliestCheck();
   inline void markAsInvalid(TimesliceSlot slot);
   /// Publish a slot to be sent via metrics.
   inline void publishSlot(TimesliceSlot slot);
@@ -109,7 +130,8 @@ class TimesliceIndex
 
  private:
   /// @return the oldest slot possible so that we can eventually override it.
-  /// This is the timeslices for all the in flight parts.
+  /// This is the timeslices for all the in flight parts, excluding the
+  /// pending ones, or an invalid slot if they are all pending.
   inline TimesliceSlot findOldestSlot() const;
 
   /// The variables for each cacheline.
@@ -122,6 +144,17 @@ class TimesliceIndex
   /// since last time we called getReadyToProcess()
   std::vector<bool> mDirty;
 
+  /// This keeps track of the slots whose processing was scheduled, but
+  /// whose inputs were not taken yet.
+  std::vector<bool> mPending;
+
+  /// This keeps track of when the slots might have inputs to expire.
+  std::vector<uint64_t> mNextCheck;
+
+  /// The minimum of mNextCheck, so that we do not have to look at the slots
+  /// when none of them is due.
+  uint64_t mEarliestCheck = ExpirationHandler::NEVER;
+
   /// What to do in case of backpressure
   BackpressureOp mBackpressurePolicy = BackpressureOp::Wait;
 };
@@ -15,12 +15,20 @@
 #include <cstddef>
 #include <cstdint>
 
+namespace o2::framework
+{
+struct LatencyTraceHeader;
+}
+
 /// This class holds the information about timing
 /// of the messages being processed.
 struct TimingInfo {
   size_t timeslice; /// the timeslice associated to current processing
   uint32_t firstTFOrbit = -1; /// the orbit the TF begins
   uint32_t tfCounter = -1;    // the counter associated to a TF
+  /// The critical path of the timeslice being processed, which its outputs
+  /// carry along. nullptr outside of the processing.
+  o2::framework::LatencyTraceHeader const* criticalPath = nullptr;
 };
 
 #endif // O2_FRAMEWORK_TIMINGINFO_H_
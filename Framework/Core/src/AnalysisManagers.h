@@ -23,6 +23,8 @@
 #include "Framework/InitContext.h"
 #include "Framework/RootConfigParamHelpers.h"
 #include "../src/ExpressionHelpers.h"
+#include <arrow/util/key_value_metadata.h>
+#include <TList.h>
 
 namespace o2::framework
 {
@@ -243,14 +245,34 @@ struct OutputManager<Spawns<T>> {
       original_table = makeEmptyTable<base_table_t>();
     }
 
-    what.extension = std::make_shared<typename Spawns<T>::extension_t>(o2::framework::spawner(what.pack(), original_table.get(), aod::MetadataTrait<typename Spawns<T>::extension_t>::metadata::tableLabel()));
+    using extension_t = typename Spawns<T>::extension_t;
+    auto label = aod::MetadataTrait<extension_t>::metadata::tableLabel();
+    auto hash = std::to_string(Spawns<T>::hash());
+    std::shared_ptr<arrow::Table> extension_table = nullptr;
+    // the same extension is spawned by another task and we get it as an input
+    what.shared = pc.inputs().getPos(label) >= 0;
+    if (what.shared) {
+      extension_table = pc.inputs().get<TableConsumer>(label)->asArrowTable();
+      auto metadata = extension_table->schema()->metadata();
+      auto index = metadata == nullptr ? -1 : metadata->FindKey(spawnsHashKey);
+      if (index < 0 || metadata->value(index) != hash) {
+        throw runtime_error_f("Shared extended table %s has a different definition", label);
+      }
+    } else {
+      extension_table = o2::framework::spawner(what.pack(), original_table.get(), label);
+      extension_table = extension_table->ReplaceSchemaMetadata(std::make_shared<arrow::KeyValueMetadata>(std::vector<std::string>{spawnsHashKey}, std::vector<std::string>{hash}));
+    }
+
+    what.extension = std::make_shared<extension_t>(extension_table);
     what.table = std::make_shared<typename T::table_t>(soa::ArrowHelpers::joinTables({what.extension->asArrowTable(), original_table}));
     return true;
   }
 
   static bool finalize(ProcessingContext& pc, Spawns<T>& what)
   {
-    pc.outputs().adopt(what.output(), what.asArrowTable());
+    if (what.shared == false) {
+      pc.outputs().adopt(what.output(), what.asArrowTable());
+    }
     return true;
   }
 
@@ -388,11 +410,18 @@ struct OptionManager<Configurable<T, K, IP>> {
 /// Manager template to facilitate extended tables spawning
 template <typename T>
 struct SpawnManager {
+  static bool appendLabel(std::vector<DataProcessorLabel>&, T const&) { return false; }
   static bool requestInputs(std::vector<InputSpec>&, T const&) { return false; }
 };
 
 template <typename TABLE>
 struct SpawnManager<Spawns<TABLE>> {
+  static bool appendLabel(std::vector<DataProcessorLabel>& labels, Spawns<TABLE>&)
+  {
+    labels.emplace_back(Spawns<TABLE>::label());
+    return true;
+  }
+
   static bool requestInputs(std::vector<InputSpec>& inputs, Spawns<TABLE>& spawns)
   {
     auto base_specs = spawns.base_specs();
@@ -424,6 +453,100 @@ struct IndexManager<Builds<IDX, P>> {
     return true;
   }
 };
+
+/// Manager template for running process() of thread-safe tasks concurrently
+/// over groups. Members which are written from process() without per-worker
+/// shadows make the task unsupported, and it is then processed serially.
+template <typename T>
+struct ParallelManager {
+  static bool isSupported(T const&) { return true; }
+  static bool createShadows(T&, int) { return false; }
+  static bool mergeShadows(T&) { return false; }
+};
+
+template <typename TABLE>
+struct ParallelManager<Produces<TABLE>> {
+  static bool isSupported(Produces<TABLE> const&) { return false; }
+  static bool createShadows(Produces<TABLE>&, int) { return false; }
+  static bool mergeShadows(Produces<TABLE>&) { return false; }
+};
+
+template <typename T>
+struct ParallelManager<Partition<T>> {
+  static bool isSupported(Partition<T> const&) { return false; }
+  static bool createShadows(Partition<T>&, int) { return false; }
+  static bool mergeShadows(Partition<T>&) { return false; }
+};
+
+template <>
+struct ParallelManager<HistogramRegistry> {
+  static bool isSupported(HistogramRegistry const&) { return true; }
+  static bool createShadows(HistogramRegistry& what, int n)
+  {
+    what.createShadows(n);
+    return true;
+  }
+  static bool mergeShadows(HistogramRegistry& what)
+  {
+    what.mergeShadows();
+    return true;
+  }
+};
+
+template <typename T>
+struct ParallelManager<OutputObj<T>> {
+  template <typename O, typename = void>
+  struct is_mergeable : std::false_type {
+  };
+
+  template <typename O>
+  struct is_mergeable<O, std::void_t<decltype(std::declval<O&>().Merge(std::declval<TCollection*>())), decltype(std::declval<O&>().Reset())>> : std::true_type {
+  };
+
+  static bool isSupported(OutputObj<T> const&) { return is_mergeable<T>::value; }
+
+  /// Objects set after the previous call get new shadows
+  static bool createShadows(OutputObj<T>& what, int n)
+  {
+    if constexpr (is_mergeable<T>::value) {
+      if (what.object == nullptr) {
+        what.shadows.clear();
+        what.shadowsOf = nullptr;
+        return false;
+      }
+      if (what.shadowsOf == what.object.get() && what.shadows.size() == static_cast<size_t>(n)) {
+        return true;
+      }
+      what.shadows.clear();
+      for (int i = 0; i < n; ++i) {
+        what.shadows.emplace_back(static_cast<T*>(what.object->Clone()));
+        what.shadows.back()->Reset();
+      }
+      what.shadowsOf = what.object.get();
+      return true;
+    }
+    return false;
+  }
+
+  static bool mergeShadows(OutputObj<T>& what)
+  {
+    if constexpr (is_mergeable<T>::value) {
+      if (what.shadows.empty()) {
+        return false;
+      }
+      TList list;
+      for (auto& shadow : what.shadows) {
+        list.Add(shadow.get());
+      }
+      what.object->Merge(&list);
+      for (auto& shadow : what.shadows) {
+        shadow->Reset();
+      }
+      return true;
+    }
+    return false;
+  }
+};
 } // namespace o2::framework
 
 #endif // ANALYSISMANAGERS_H
@@ -0,0 +1,111 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/ArrowFileHelpers.h"
+#include "Framework/Logger.h"
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/table.h>
+#include <arrow/util/compression.h>
+
+#include <filesystem>
+
+namespace o2::framework
+{
+
+bool ArrowFileHelpers::write(std::shared_ptr<arrow::Table> const& table, std::string const& filename, std::string const& codec)
+{
+  auto options = arrow::ipc::IpcWriteOptions::Defaults();
+  if (!codec.empty()) {
+    auto type = arrow::Compression::UNCOMPRESSED;
+    if (codec == "lz4") {
+      type = arrow::Compression::LZ4_FRAME;
+    } else if (codec == "zstd") {
+      type = arrow::Compression::ZSTD;
+    } else {
+      LOGP(ERROR, "Unknown compression {} for {}", codec, filename);
+      return false;
+    }
+#if ARROW_VERSION_MAJOR < 2
+    options.compression = type;
+#else
+    auto compressor = arrow::util::Codec::Create(type);
+    if (!compressor.ok()) {
+      LOGP(ERROR, "Unable to create {} codec: {}", codec, compressor.status().ToString());
+      return false;
+    }
+    options.codec = std::move(compressor).ValueOrDie();
+#endif
+  }
+
+  auto sink = arrow::io::FileOutputStream::Open(filename);
+  if (!sink.ok()) {
+    LOGP(ERROR, "Unable to open {}: {}", filename, sink.status().ToString());
+    return false;
+  }
+  auto stream = sink.ValueOrDie();
+#if ARROW_VERSION_MAJOR < 3
+  auto writer = arrow::ipc::NewFileWriter(stream.get(), table->schema(), options);
+#else
+  auto writer = arrow::ipc::MakeFileWriter(stream.get(), table->schema(), options);
+#endif
+  if (!writer.ok()) {
+    LOGP(ERROR, "Unable to create writer for {}: {}", filename, writer.status().ToString());
+    return false;
+  }
+  auto status = writer.ValueOrDie()->WriteTable(*table);
+  status &= writer.ValueOrDie()->Close();
+  status &= stream->Close();
+  if (!status.ok()) {
+    LOGP(ERROR, "Unable to write {}: {}", filename, status.ToString());
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<arrow::Table> ArrowFileHelpers::read(std::string const& filename)
+{
+  auto file = arrow::io::MemoryMappedFile::Open(filename, arrow::io::FileMode::READ);
+  if (!file.ok()) {
+    LOGP(ERROR, "Unable to map {}: {}", filename, file.status().ToString());
+    return nullptr;
+  }
+  auto reader = arrow::ipc::RecordBatchFileReader::Open(file.ValueOrDie());
+  if (!reader.ok()) {
+    LOGP(ERROR, "Unable to read {}: {}", filename, reader.status().ToString());
+    return nullptr;
+  }
+  auto fileReader = reader.ValueOrDie();
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (auto i = 0; i < fileReader->num_record_batches(); ++i) {
+    auto batch = fileReader->ReadRecordBatch(i);
+    if (!batch.ok()) {
+      LOGP(ERROR, "Unable to read batch {} of {}: {}", i, filename, batch.status().ToString());
+      return nullptr;
+    }
+    batches.push_back(batch.ValueOrDie());
+  }
+  auto table = arrow::Table::FromRecordBatches(fileReader->schema(), batches);
+  if (!table.ok()) {
+    LOGP(ERROR, "Unable to create table from {}: {}", filename, table.status().ToString());
+    return nullptr;
+  }
+  return table.ValueOrDie();
+}
+
+bool ArrowFileHelpers::isArrowDirectory(std::string const& path)
+{
+  std::error_code ec;
+  return std::filesystem::is_directory(path, ec);
+}
+
+} // namespace o2::framework
@@ -18,6 +18,7 @@
 #include "Framework/DataDescriptorQueryBuilder.h"
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/DataOutputDirector.h"
+#include "Framework/ArrowFileHelpers.h"
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/DataSpecUtils.h"
 #include "Framework/TableBuilder.h"
@@ -353,6 +354,26 @@ DataProcessorSpec
         // a table can be saved in multiple ways
         // e.g. different selections of columns to different files
         for (auto d : ds) {
+          if (dod->isArrowOutput()) {
+            auto toWrite = table;
+            if (d->colnames.size() > 0) {
+              std::vector<std::shared_ptr<arrow::Field>> fields;
+              std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+              for (auto cn : d->colnames) {
+                auto idx = table->schema()->GetFieldIndex(cn);
+                if (idx != -1) {
+                  fields.push_back(table->schema()->field(idx));
+                  columns.push_back(table->column(idx));
+                }
+              }
+              toWrite = arrow::Table::Make(std::make_shared<arrow::Schema>(fields), columns, table->num_rows());
+            }
+            auto filename = dod->getArrowFileName(d, tfNumber);
+            if (!ArrowFileHelpers::write(toWrite, filename, dod->getArrowCodec())) {
+              LOGP(ERROR, "The table \"{}\" could not be saved to {}!", tableName, filename);
+            }
+            continue;
+          }
           auto fileAndFolder = dod->getFileFolder(d, tfNumber);
           auto treename = fileAndFolder.folderName + d->treename;
           TableToTree ta2tr(table,
@@ -117,7 +117,9 @@ bool ComputingQuotaEvaluator::selectOffer(int task, ComputingQuotaRequest const&
       stats.invalidOffers.push_back(i);
       continue;
     }
-    if (offer.user != -1 && offer.user != task) {
+    // The first offer does not hold any resource, so it can be
+    // used by all the streams at the same time.
+    if (offer.user != -1 && offer.user != task && i != 0) {
       stats.otherUser.push_back(i);
       continue;
     }
@@ -10,10 +10,14 @@
 // or submit itself to any jurisdiction.
 
 #include "DPLMonitoringBackend.h"
+#include "DeviceMetricsRing.h"
+#include "Framework/DeviceSpec.h"
 #include "Framework/DriverClient.h"
 #include "Framework/ServiceRegistry.h"
 #include <fmt/format.h>
 #include <sstream>
+#include <sys/mman.h>
+#include <unistd.h>
 
 namespace o2::framework
 {
@@ -35,8 +39,17 @@ inline unsigned long DPLMonitoringBackend::convertTimestamp(const std::chrono::t
 DPLMonitoringBackend::DPLMonitoringBackend(ServiceRegistry& registry)
   : mRegistry{registry}
 {
+  // The ring exists only if we were spawned by a local driver. Once we
+  // are attached, the name is not needed anymore.
+  auto name = DeviceMetricsRing::segmentName(getppid(), registry.get<DeviceSpec const>().id);
+  mRing = DeviceMetricsRing::attach(name);
+  if (mRing) {
+    shm_unlink(name.c_str());
+  }
 }
 
+DPLMonitoringBackend::~DPLMonitoringBackend() = default;
+
 void DPLMonitoringBackend::addGlobalTag(std::string_view name, std::string_view value)
 {
   // FIXME: tags are ignored by DPL in any case...
@@ -52,6 +65,19 @@ void DPLMonitoringBackend::send(std::vector<o2::monitoring::Metric>&& metrics)
 
 void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
 {
+  if (mRing && metric.getValuesSize() == 1) {
+    auto timestamp = convertTimestamp(metric.getTimestamp());
+    std::scoped_lock lock(mRingMutex);
+    bool sent = std::visit(overloaded{
+                             [](const std::string&) -> bool { return false; },
+                             [&](int value) -> bool { return mRing->push(metric.getName(), value, timestamp); },
+                             [&](double value) -> bool { return mRing->push(metric.getName(), (float)value, timestamp); },
+                             [&](uint64_t value) -> bool { return mRing->push(metric.getName(), value, timestamp); }},
+                           metric.getValues().front().second);
+    if (sent) {
+      return;
+    }
+  }
   std::ostringstream mStream;
   mStream << "[METRIC] " << metric.getName();
   for (auto& value : metric.getValues()) {
@@ -12,12 +12,15 @@
 #define O2_FRAMEWORK_DPLMONITORINGBACKEND_H_
 
 #include "Monitoring/Backend.h"
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace o2::framework
 {
 
 struct ServiceRegistry;
+class DeviceMetricsRing;
 
 /// \brief Prints metrics to standard output via std::cout
 class DPLMonitoringBackend final : public o2::monitoring::Backend
@@ -27,7 +30,7 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   DPLMonitoringBackend(ServiceRegistry& registry);
 
   /// Default destructor
-  ~DPLMonitoringBackend() override = default;
+  ~DPLMonitoringBackend() override;
 
   /// Prints metric
   /// \param metric           reference to metric object
@@ -51,6 +54,8 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   std::string mTagString;    ///< Global tagset (common for each metric)
   const std::string mPrefix; ///< Metric prefix
   ServiceRegistry& mRegistry;
+  std::unique_ptr<DeviceMetricsRing> mRing; ///< Binary channel to the driver, if available
+  std::mutex mRingMutex;                     ///< The ring has a single producer, while metrics can come from different threads
 };
 
 } // namespace o2::framework
@@ -16,6 +16,7 @@
 #include "Framework/ArrowContext.h"
 #include "Framework/DataSpecUtils.h"
 #include "Framework/DataProcessingHeader.h"
+#include "Framework/LatencyTraceHeader.h"
 #include "Headers/Stack.h"
 #include "FairMQResizableBuffer.h"
 
@@ -107,6 +108,10 @@ FairMQMessagePtr DataAllocator::headerMessageFromOutput(Output const& spec,
   auto& context = mRegistry->get<MessageContext>();
 
   auto channelAlloc = o2::pmr::getTransportAllocator(context.proxy().getTransport(channel, 0));
+  // Only set with --latency-trace, see DataProcessingDevice::dispatchComputation.
+  if (mTimingInfo->criticalPath) {
+    return o2::pmr::getMessage(o2::header::Stack{channelAlloc, dh, dph, *mTimingInfo->criticalPath, spec.metaHeader});
+  }
   return o2::pmr::getMessage(o2::header::Stack{channelAlloc, dh, dph, spec.metaHeader});
 }
 
@@ -256,6 +261,31 @@ void DataAllocator::snapshot(const Output& spec, const char* payload, size_t pay
   addPartToContext(std::move(payloadMessage), spec, serializationMethod);
 }
 
+void DataAllocator::forwardPayload(const Output& spec, DataRef const& ref)
+{
+  auto const* dh = o2::header::get<DataHeader*>(ref.header);
+  if (dh == nullptr) {
+    throw runtime_error("Unable to forward a payload without DataHeader");
+  }
+  auto& context = mRegistry->get<MessageContext>();
+  auto const* input = context.findInputPayload(ref.payload);
+  if (input == nullptr) {
+    snapshot(spec, ref.payload, dh->payloadSize, dh->payloadSerializationMethod);
+    return;
+  }
+  std::string const& channel = matchDataHeader(spec, mTimingInfo->timeslice);
+  auto* transport = context.proxy().getTransport(channel);
+  FairMQMessagePtr payloadMessage;
+  if (input->GetType() == transport->GetType()) {
+    payloadMessage = transport->CreateMessage();
+    payloadMessage->Copy(*input);
+  } else {
+    payloadMessage = transport->CreateMessage(dh->payloadSize, fair::mq::Alignment{64});
+    memcpy(payloadMessage->GetData(), ref.payload, dh->payloadSize);
+  }
+  addPartToContext(std::move(payloadMessage), spec, dh->payloadSerializationMethod);
+}
+
 Output DataAllocator::getOutputByBind(OutputRef&& ref)
 {
   if (ref.label.empty()) {
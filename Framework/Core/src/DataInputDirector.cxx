@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include "Framework/DataInputDirector.h"
+#include "Framework/ArrowFileHelpers.h"
 #include "Framework/DataDescriptorQueryBuilder.h"
 #include "Framework/Logger.h"
 #include "AnalysisDataModelHelpers.h"
@@ -20,6 +21,8 @@
 #include "TGrid.h"
 #include "TObjString.h"
 
+#include <filesystem>
+
 namespace o2
 {
 namespace framework
@@ -90,30 +93,48 @@ bool DataInputDescriptor::setFile(int counter)
     return false;
   }
 
-  // open file
+  // Arrow IPC files are not opened, they are mapped table by table
   auto filename = mfilenames[counter]->fileName;
-  if (mcurrentFile) {
-    if (mcurrentFile->GetName() != filename) {
-      closeInputFile();
+  mfilenames[counter]->arrowFormat = ArrowFileHelpers::isArrowDirectory(filename);
+  if (mfilenames[counter]->arrowFormat) {
+    closeInputFile();
+  } else {
+    // open file
+    if (mcurrentFile) {
+      if (mcurrentFile->GetName() != filename) {
+        closeInputFile();
+        mcurrentFile = TFile::Open(filename.c_str());
+      }
+    } else {
       mcurrentFile = TFile::Open(filename.c_str());
     }
-  } else {
-    mcurrentFile = TFile::Open(filename.c_str());
-  }
-  if (!mcurrentFile) {
-    throw std::runtime_error(fmt::format("Couldn't open file \"{}\"!", filename));
+    if (!mcurrentFile) {
+      throw std::runtime_error(fmt::format("Couldn't open file \"{}\"!", filename));
+    }
+    mcurrentFile->SetReadaheadSize(50 * 1024 * 1024);
   }
-  mcurrentFile->SetReadaheadSize(50 * 1024 * 1024);
 
   // get the directory names
   if (mfilenames[counter]->numberOfTimeFrames <= 0) {
     std::regex TFRegex = std::regex("DF_[0-9]+");
-    TList* keyList = mcurrentFile->GetListOfKeys();
+    std::vector<std::string> folderNames;
+    if (mfilenames[counter]->arrowFormat) {
+      for (auto const& entry : std::filesystem::directory_iterator(filename)) {
+        if (entry.is_directory()) {
+          folderNames.emplace_back(entry.path().filename().string());
+        }
+      }
+    } else {
+      TList* keyList = mcurrentFile->GetListOfKeys();
+      for (auto key : *keyList) {
+        folderNames.emplace_back(((TObjString*)key)->GetString().Data());
+      }
+    }
 
     // extract TF numbers and sort accordingly
-    for (auto key : *keyList) {
-      if (std::regex_match(((TObjString*)key)->GetString().Data(), TFRegex)) {
-        auto folderNumber = std::stoul(std::string(((TObjString*)key)->GetString().Data()).substr(3));
+    for (auto const& folderName : folderNames) {
+      if (std::regex_match(folderName, TFRegex)) {
+        auto folderNumber = std::stoul(folderName.substr(3));
         mfilenames[counter]->listOfTimeFrameNumbers.emplace_back(folderNumber);
       }
     }
@@ -170,6 +191,34 @@ int DataInputDescriptor::getTimeFramesInFile(int counter)
   return mfilenames.at(counter)->numberOfTimeFrames;
 }
 
+bool DataInputDescriptor::isArrowFile(int counter)
+{
+  if (counter >= getNumberInputfiles()) {
+    return false;
+  }
+  return ArrowFileHelpers::isArrowDirectory(mfilenames[counter]->fileName);
+}
+
+std::shared_ptr<arrow::Table> DataInputDescriptor::getArrowTable(int counter, int numTF, std::string const& treename)
+{
+  // open file
+  if (!setFile(counter) || !mfilenames[counter]->arrowFormat) {
+    return nullptr;
+  }
+
+  // no TF left
+  if (numTF >= mfilenames[counter]->numberOfTimeFrames) {
+    return nullptr;
+  }
+
+  auto filename = mfilenames[counter]->fileName + "/" + (mfilenames[counter]->listOfTimeFrameKeys)[numTF] + "/" + treename + ArrowFileHelpers::extension;
+  auto table = ArrowFileHelpers::read(filename);
+  if (!table) {
+    throw std::runtime_error(fmt::format(R"(Couldn't get table "{}" from "{}")", treename, filename));
+  }
+  return table;
+}
+
 void DataInputDescriptor::closeInputFile()
 {
   if (mcurrentFile) {
@@ -554,22 +603,23 @@ uint64_t DataInputDirector::getTimeFrameNumber(header::DataHeader dh, int counte
   return didesc->getTimeFrameNumber(counter, numTF);
 }
 
-TTree* DataInputDirector::getDataTree(header::DataHeader dh, int counter, int numTF)
+std::pair<DataInputDescriptor*, std::string> DataInputDirector::getDescriptorAndTreeName(header::DataHeader dh)
 {
-  std::string treename;
-  TTree* tree = nullptr;
-
   auto didesc = getDataInputDescriptor(dh);
   if (didesc) {
     // if match then use filename and treename from DataInputDescriptor
-    treename = didesc->treename;
-  } else {
-    // if NOT match then use
-    //  . filename from defaultDataInputDescriptor
-    //  . treename from DataHeader
-    didesc = mdefaultDataInputDescriptor;
-    treename = aod::datamodel::getTreeName(dh);
+    return {didesc, didesc->treename};
   }
+  // if NOT match then use
+  //  . filename from defaultDataInputDescriptor
+  //  . treename from DataHeader
+  return {mdefaultDataInputDescriptor, aod::datamodel::getTreeName(dh)};
+}
+
+TTree* DataInputDirector::getDataTree(header::DataHeader dh, int counter, int numTF)
+{
+  TTree* tree = nullptr;
+  auto [didesc, treename] = getDescriptorAndTreeName(dh);
 
   auto fileAndFolder = didesc->getFileFolder(counter, numTF);
   if (fileAndFolder.file) {
@@ -583,6 +633,17 @@ TTree* DataInputDirector::getDataTree(header::DataHeader dh, int counter, int nu
   return tree;
 }
 
+bool DataInputDirector::isArrowFile(header::DataHeader dh, int counter)
+{
+  return getDescriptorAndTreeName(dh).first->isArrowFile(counter);
+}
+
+std::shared_ptr<arrow::Table> DataInputDirector::getArrowTable(header::DataHeader dh, int counter, int numTF)
+{
+  auto [didesc, treename] = getDescriptorAndTreeName(dh);
+  return didesc->getArrowTable(counter, numTF, treename);
+}
+
 void DataInputDirector::closeInputFiles()
 {
   mdefaultDataInputDescriptor->closeInputFile();
@@ -9,12 +9,15 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include "Framework/DataOutputDirector.h"
+#include "Framework/ArrowFileHelpers.h"
 #include "Framework/Logger.h"
 
 #include "rapidjson/document.h"
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/filereadstream.h"
 
+#include <filesystem>
+
 namespace o2
 {
 namespace framework
@@ -456,6 +459,31 @@ FileAndFolder DataOutputDirector::getFileFolder(DataOutputDescriptor* dodesc, ui
   return fileAndFolder;
 }
 
+std::string DataOutputDirector::getArrowFileName(DataOutputDescriptor* dodesc, uint64_t folderNumber)
+{
+  auto folderName = dodesc->getFilenameBase() + ArrowFileHelpers::extension + "/DF_" + std::to_string(folderNumber);
+  std::error_code ec;
+  std::filesystem::create_directories(folderName, ec);
+  if (ec) {
+    LOGP(ERROR, "Unable to create folder {}: {}", folderName, ec.message());
+  }
+  return folderName + "/" + dodesc->treename + ArrowFileHelpers::extension;
+}
+
+void DataOutputDirector::setOutputFormat(std::string format)
+{
+  if (format != "root" && format != "arrow" && format != "arrow-lz4" && format != "arrow-zstd") {
+    LOGP(FATAL, "Unknown AOD output format {}! Use root, arrow, arrow-lz4, or arrow-zstd.", format);
+  }
+  mOutputFormat = format;
+}
+
+std::string DataOutputDirector::getArrowCodec()
+{
+  auto pos = mOutputFormat.find('-');
+  return pos == std::string::npos ? "" : mOutputFormat.substr(pos + 1);
+}
+
 void DataOutputDirector::closeDataFiles()
 {
   for (auto filePtr : mfilePtrs) {
@@ -469,6 +497,7 @@ void DataOutputDirector::printOut()
 {
   LOGP(INFO, "DataOutputDirector");
   LOGP(INFO, "  Default file name    : {}", mfilenameBase);
+  LOGP(INFO, "  Output format        : {}", mOutputFormat);
   LOGP(INFO, "  Number of files      : {}", mfilenameBases.size());
 
   LOGP(INFO, "  DataOutputDescriptors: {}", mDataOutputDescriptors.size());
@@ -32,6 +32,8 @@
 #include "Framework/TMessageSerializer.h"
 #include "Framework/InputRecord.h"
 #include "Framework/InputSpan.h"
+#include "Framework/MessageContext.h"
+#include "Framework/LatencyTraceHeader.h"
 #include "Framework/Signpost.h"
 #include "Framework/SourceInfoHeader.h"
 #include "Framework/Logger.h"
@@ -55,6 +57,7 @@
 #include <TClonesArray.h>
 
 #include <algorithm>
+#include <array>
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -62,6 +65,7 @@
 #include <execinfo.h>
 #include <sstream>
 #include <boost/property_tree/json_parser.hpp>
+#include <fmt/format.h>
 
 using namespace o2::framework;
 using ConfigurationInterface = o2::configuration::ConfigurationInterface;
@@ -157,6 +161,94 @@ void run_completion(uv_work_t* handle, int status)
   ZoneScopedN("run_completion");
 }
 
+// Executed in a worker thread for the streams other than the main one,
+// which only process the actions handed to them by the main thread.
+void run_stream_callback(uv_work_t* handle)
+{
+  ZoneScopedN("run_stream_callback");
+  TaskStreamInfo* task = (TaskStreamInfo*)handle->data;
+  DataProcessorContext& context = *task->context;
+  DataProcessingDevice::dispatchComputation(context, *context.completed);
+}
+
+void run_stream_completion(uv_work_t* handle, int status)
+{
+  TaskStreamInfo* task = (TaskStreamInfo*)handle->data;
+  DataProcessorContext& context = *task->context;
+  auto& deviceContext = *context.deviceContext;
+  deviceContext.runningStreams--;
+  for (auto& consumer : context.offerConsumers) {
+    deviceContext.quotaEvaluator->consume(task->id.index, consumer);
+  }
+  context.offerConsumers.clear();
+  deviceContext.quotaEvaluator->handleExpired();
+  deviceContext.quotaEvaluator->dispose(task->id.index);
+  task->running = false;
+}
+
+/// Makes sure the outputs of a stream are sent in turn, see StreamSequencer.
+/// Without a sequencer, i.e. with a single stream, it does nothing.
+struct StreamTurn {
+  StreamTurn(StreamSequencer* sequencer_, uint64_t ticket_)
+    : sequencer{sequencer_}, ticket{ticket_}
+  {
+  }
+
+  ~StreamTurn()
+  {
+    if (sequencer == nullptr) {
+      return;
+    }
+    // Even if nothing was sent, the following streams must not overtake us.
+    acquire();
+    sequencer->nowServing++;
+    lock.unlock();
+    sequencer->turn.notify_all();
+  }
+
+  void acquire()
+  {
+    if (sequencer == nullptr || lock.owns_lock()) {
+      return;
+    }
+    ZoneScopedN("wait for stream turn");
+    lock = std::unique_lock<std::mutex>(sequencer->mutex);
+    sequencer->turn.wait(lock, [this]() { return sequencer->nowServing == ticket; });
+  }
+
+  StreamSequencer* sequencer;
+  uint64_t ticket;
+  std::unique_lock<std::mutex> lock;
+};
+
+void LatencyArrivals::add(void const* header, uint64_t arrival)
+{
+  // Inputs which the relayer drops are never taken, so we forget
+  // whatever is older than this.
+  constexpr uint64_t maxAge = 60ull * 1000000000ull;
+  std::scoped_lock<std::mutex> lock(mutex);
+  byHeader[header] = arrival;
+  if (arrival - lastPruned < maxAge) {
+    return;
+  }
+  for (auto it = byHeader.begin(); it != byHeader.end();) {
+    it = (arrival - it->second > maxAge) ? byHeader.erase(it) : std::next(it);
+  }
+  lastPruned = arrival;
+}
+
+uint64_t LatencyArrivals::take(void const* header)
+{
+  std::scoped_lock<std::mutex> lock(mutex);
+  auto it = byHeader.find(header);
+  if (it == byHeader.end()) {
+    return 0;
+  }
+  auto arrival = it->second;
+  byHeader.erase(it);
+  return arrival;
+}
+
 // Context for polling
 struct PollerContext {
   char const* name = nullptr;
@@ -256,6 +348,35 @@ void DataProcessingDevice::Init()
 
   mConfigRegistry = std::make_unique<ConfigParamRegistry>(std::move(configStore));
 
+  // Additional streams which process timeslices concurrently, while the
+  // main one receives and relays the data. They all share the same
+  // process, so that large objects (e.g. geometry) are loaded only once.
+  int streams = mConfigRegistry->isSet("dpl-streams") ? mConfigRegistry->get<int>("dpl-streams") : 1;
+  if (streams > 1 && mSpec.dispatchPolicy.action == DispatchPolicy::DispatchOp::WhenReady) {
+    LOGP(WARN, "{} dispatches its outputs when ready, which is not compatible with --dpl-streams. Using only one stream.", mSpec.name);
+    streams = 1;
+  }
+  // Tables are built by the ArrowContext, which all the streams share.
+  static const std::array<header::DataOrigin, 4> tableOrigins{header::DataOrigin{"AOD"}, header::DataOrigin{"DYN"}, header::DataOrigin{"IDX"}, header::DataOrigin{"RN2"}};
+  auto producesTables = std::any_of(mSpec.outputs.begin(), mSpec.outputs.end(), [](OutputRoute const& route) {
+    return std::any_of(tableOrigins.begin(), tableOrigins.end(), [&route](header::DataOrigin const& origin) {
+      return DataSpecUtils::partialMatch(route.matcher, origin);
+    });
+  });
+  if (streams > 1 && producesTables) {
+    LOGP(WARN, "{} produces tables, which is not compatible with --dpl-streams. Using only one stream.", mSpec.name);
+    streams = 1;
+  }
+  if (streams > 1) {
+    mStreams.resize(streams + 1);
+    mHandles.resize(streams + 1);
+  }
+  // The critical path of each timeslice is only traced on request, since
+  // it adds a LatencyTraceHeader to every output.
+  if (GetConfig()->Count("latency-trace") && GetConfig()->GetProperty<bool>("latency-trace")) {
+    mDeviceContext.latencyArrivals = &mLatencyArrivals;
+  }
+
   mExpirationHandlers.clear();
 
   auto distinct = DataRelayerHelpers::createDistinctRouteIndex(mSpec.inputs);
@@ -454,8 +575,31 @@ void DataProcessingDevice::InitTask()
   // We should be ready to run here. Therefore we copy all the
   // required parts in the DataProcessorContext. Eventually we should
   // do so on a per thread basis, with fine grained locks.
-  mDataProcessorContexes.resize(1);
+  mDataProcessorContexes.resize(mStreams.size());
   this->fillContext(mDataProcessorContexes.at(0), mDeviceContext);
+
+  // Every stream but the main one gets its own message backends, and
+  // therefore its own DataAllocator, but shares everything else.
+  mStreamResources.resize(mStreams.size());
+  for (size_t si = 1; si < mStreams.size(); ++si) {
+    auto resources = std::make_unique<StreamResources>();
+    resources->registry = mServiceRegistry.createStreamRegistry(mState, *GetConfig(), {"fairmq-backend", "string-backend", "raw-backend"});
+    resources->allocator = std::make_unique<DataAllocator>(&resources->timingInfo, resources->registry.get(), mSpec.outputs);
+    auto& context = mDataProcessorContexes.at(si);
+    this->fillContext(context, mDeviceContext);
+    context.registry = resources->registry.get();
+    context.timingInfo = &resources->timingInfo;
+    context.allocator = resources->allocator.get();
+    context.completed = &resources->completed;
+    context.handedOff = &resources->handedOff;
+    context.wasActive = &resources->wasActive;
+    mStreamResources[si] = std::move(resources);
+  }
+  if (mStreams.size() > 1) {
+    mDeviceContext.sequencer = &mSequencer;
+    mDeviceContext.pendingActions = &mPendingActions;
+    LOGP(INFO, "{} processes up to {} timeslices concurrently", mSpec.name, mStreams.size() - 1);
+  }
 }
 
 void DataProcessingDevice::fillContext(DataProcessorContext& context, DeviceContext& deviceContext)
@@ -541,6 +685,17 @@ bool DataProcessingDevice::ConditionalRun()
   }
 
   assert(mStreams.size() == mHandles.size());
+  // With more than one stream, the main thread only receives and relays the
+  // data, and the ready timeslices are handed to the other streams.
+  if (mStreams.size() > 1) {
+    auto& context = mDataProcessorContexes.at(0);
+    doPrepare(context);
+    doRun(context);
+    handOffActions();
+    FrameMark;
+    return true;
+  }
+
   /// Decide which task to use
   TaskStreamRef streamRef{-1};
   for (int ti = 0; ti < mStreams.size(); ti++) {
@@ -586,6 +741,50 @@ bool DataProcessingDevice::ConditionalRun()
   return true;
 }
 
+void DataProcessingDevice::handOffActions()
+{
+  for (size_t si = 1; si < mStreams.size() && mPendingActions.empty() == false; ++si) {
+    auto& stream = mStreams[si];
+    if (stream.running) {
+      continue;
+    }
+    // Each stream needs its own share of the resources to run.
+    if (mQuotaEvaluator.selectOffer(si, mSpec.resourcePolicy.request) == false) {
+      mQuotaEvaluator.handleExpired();
+      return;
+    }
+    auto action = mPendingActions.front();
+    mPendingActions.pop_front();
+    // Everything the stream needs from the slot is taken now, since the
+    // slot can be reused as soon as its inputs are gone.
+    auto& context = mDataProcessorContexes.at(si);
+    auto& handedOff = *context.handedOff;
+    handedOff.action = action;
+    handedOff.timeslice = mRelayer->getTimesliceForSlot(action.slot);
+    handedOff.firstTFCounter = mRelayer->getFirstTFCounterForSlot(action.slot);
+    handedOff.firstTFOrbit = mRelayer->getFirstTFOrbitForSlot(action.slot);
+    handedOff.inputs = mRelayer->getInputsForTimeslice(action.slot);
+    mRelayer->updateCacheStatus(action.slot, CacheEntryStatus::RUNNING, CacheEntryStatus::DONE);
+    for (size_t ai = 0; ai < handedOff.inputs.size(); ++ai) {
+      auto cacheId = action.slot.index * handedOff.inputs.size() + ai;
+      assert(cacheId < DataProcessingStats::MAX_RELAYER_STATES);
+      if (mStats.statesSize < cacheId + 1) {
+        mStats.statesSize = cacheId + 1;
+      }
+      mStats.relayerState[cacheId].store(handedOff.inputs[ai].empty() ? 0 : 2);
+    }
+    context.completed->clear();
+    context.completed->push_back(action);
+    context.ticket = mSequencer.nextTicket++;
+    stream.id = TaskStreamRef{static_cast<int>(si)};
+    stream.running = true;
+    stream.context = &context;
+    stream.task.data = &stream;
+    mDeviceContext.runningStreams++;
+    uv_queue_work(mState.loop, &stream.task, run_stream_callback, run_stream_completion);
+  }
+}
+
 /// We drive the state loop ourself so that we will be able to support
 /// non-data triggers like those which are time based.
 void DataProcessingDevice::doPrepare(DataProcessorContext& context)
@@ -720,6 +919,12 @@ void DataProcessingDevice::doRun(DataProcessorContext& context)
     while (DataProcessingDevice::tryDispatchComputation(context, *context.completed)) {
       context.relayer->processDanglingInputs(*context.expirationHandlers, *context.registry, false);
     }
+    // The other streams are still processing the last timeslices.
+    auto& deviceContext = *context.deviceContext;
+    if (deviceContext.pendingActions && (deviceContext.pendingActions->empty() == false || deviceContext.runningStreams > 0)) {
+      *context.wasActive = true;
+      return;
+    }
     EndOfStreamContext eosContext{*context.registry, *context.allocator};
 
     context.registry->preEOSCallbacks(eosContext);
@@ -741,6 +946,7 @@ void DataProcessingDevice::doRun(DataProcessorContext& context)
 
 void DataProcessingDevice::ResetTask()
 {
+  mPendingActions.clear();
   mRelayer->clear();
 }
 
@@ -840,6 +1046,8 @@ void DataProcessingDevice::handleData(DataProcessorContext& context, InputChanne
   auto handleValidMessages = [&info, &context = context, &relayer = *context.relayer, &reportError](std::vector<InputType> const& types) {
     static WaitBackpressurePolicy policy;
     auto& parts = info.parts;
+    auto arrivals = context.deviceContext->latencyArrivals;
+    auto arrival = arrivals ? LatencyTraceHeader::now() : 0;
     // We relay execution to make sure we have a complete set of parts
     // available.
     for (size_t pi = 0; pi < (parts.Size() / 2); ++pi) {
@@ -849,6 +1057,7 @@ void DataProcessingDevice::handleData(DataProcessorContext& context, InputChanne
           auto payloadIndex = 2 * pi + 1;
           assert(payloadIndex < parts.Size());
           auto dh = o2::header::get<DataHeader*>(parts.At(headerIndex)->GetData());
+          void const* header = parts.At(headerIndex)->GetData();
           auto relayed = relayer.relay(parts.At(headerIndex),
                                        &parts.At(payloadIndex), dh->splitPayloadParts > 0 ? dh->splitPayloadParts * 2 - 1 : 0);
           pi += dh->splitPayloadParts > 0 ? dh->splitPayloadParts - 1 : 0;
@@ -856,9 +1065,13 @@ void DataProcessingDevice::handleData(DataProcessorContext& context, InputChanne
             case DataRelayer::Backpressured:
               policy.backpressure(info);
               break;
+            case DataRelayer::WillRelay:
+              if (arrivals && o2::header::get<LatencyTraceHeader*>(header)) {
+                arrivals->add(header, arrival);
+              }
+              break;
             case DataRelayer::Dropped:
             case DataRelayer::Invalid:
-            case DataRelayer::WillRelay:
               break;
           }
         } break;
@@ -939,6 +1152,60 @@ auto calculateTotalInputRecordSize(InputRecord const& record) -> int
   return totalInputSize;
 };
 
+/// The critical path of a timeslice is the one of the input which arrived
+/// last, i.e. the one we had to wait for, followed by this device.
+void fillCriticalPath(InputRecord const& record, LatencyArrivals& arrivals, uint32_t device, uint64_t tStart, LatencyTraceHeader& path)
+{
+  LatencyTraceHeader const* critical = nullptr;
+  uint64_t criticalArrival = 0;
+  for (auto& item : record) {
+    if (item.header == nullptr) {
+      continue;
+    }
+    auto* trace = o2::header::get<LatencyTraceHeader*>(item.header);
+    if (trace == nullptr) {
+      continue;
+    }
+    auto arrival = arrivals.take(item.header);
+    if (critical == nullptr || arrival > criticalArrival) {
+      critical = trace;
+      criticalArrival = arrival;
+    }
+  }
+  path = critical ? *critical : LatencyTraceHeader{};
+  path.addHop({device, 0, criticalArrival ? criticalArrival : tStart, tStart, 0});
+}
+
+/// A sink reports, in microseconds, how long the timeslice took to go
+/// through each edge of its critical path, measured between the start of the
+/// two devices, and through the whole path.
+void reportCriticalPath(o2::monitoring::Monitoring& monitoring, LatencyTraceHeader const& path)
+{
+  using o2::monitoring::Metric;
+  using o2::monitoring::tags::Key;
+  using o2::monitoring::tags::Value;
+  if (path.hopsCount < 2) {
+    return;
+  }
+  auto const& first = path.hops[0];
+  auto const& last = path.hops[path.hopsCount - 1];
+  std::string pathName = "latency-path";
+  for (size_t hi = 0; hi < path.hopsCount; ++hi) {
+    pathName += fmt::format("-{:08x}", path.hops[hi].device);
+    if (hi == 0) {
+      continue;
+    }
+    auto const& from = path.hops[hi - 1];
+    auto const& to = path.hops[hi];
+    // Clocks of different nodes cannot be compared.
+    if (to.start < from.start) {
+      return;
+    }
+    monitoring.send(Metric{(int)((to.start - from.start) / 1000), fmt::format("latency-edge-{:08x}-{:08x}", from.device, to.device)}.addTag(Key::Subsystem, Value::DPL));
+  }
+  monitoring.send(Metric{(int)((last.finish - first.enqueue) / 1000), pathName}.addTag(Key::Subsystem, Value::DPL));
+}
+
 template <typename T>
 void update_maximum(std::atomic<T>& maximum_value, T const& value) noexcept
 {
@@ -952,42 +1219,77 @@ void update_maximum(std::atomic<T>& maximum_value, T const& value) noexcept
 bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context, std::vector<DataRelayer::RecordAction>& completed)
 {
   ZoneScopedN("DataProcessingDevice::tryDispatchComputation");
-  // This is the actual hidden state for the outer loop. In case we decide we
-  // want to support multithreaded dispatching of operations, I can simply
-  // move these to some thread local store and the rest of the lambdas
-  // should work just fine.
-  std::vector<MessageSet> currentSetOfInputs;
-
-  auto reportError = [&registry = *context.registry, &context](const char* message) {
-    registry.get<DataProcessingStats>().errorCount++;
-  };
-
   // For the moment we have a simple "immediately dispatch" policy for stuff
   // in the cache. This could be controlled from the outside e.g. by waiting
   // for a few sets of inputs to arrive before we actually dispatch the
   // computation, however this can be defined at a later stage.
-  auto canDispatchSomeComputation = [&completed,
-                                     &relayer = context.relayer]() -> bool {
-    relayer->getReadyToProcess(completed);
-    return completed.empty() == false;
+  context.relayer->getReadyToProcess(completed);
+  if (completed.empty()) {
+    return false;
+  }
+  auto& stats = context.registry->get<DataProcessingStats>();
+  stats.pendingInputs = (int)context.relayer->getParallelTimeslices() - completed.size();
+  stats.incomplete = completed.empty() ? 1 : 0;
+
+  // With more than one stream, the actions are only queued here, and the
+  // main thread hands them to the other streams, oldest timeslice first.
+  // Their slots are kept until then, even when dropping ancient timeslices.
+  if (auto pending = context.deviceContext->pendingActions) {
+    for (auto& action : completed) {
+      if (action.op != CompletionPolicy::CompletionOp::Wait) {
+        context.relayer->markAsPending(action.slot);
+        pending->push_back(action);
+      }
+    }
+    std::stable_sort(pending->begin(), pending->end(), [&relayer = context.relayer](auto const& a, auto const& b) {
+      return relayer->getTimesliceForSlot(a.slot).value < relayer->getTimesliceForSlot(b.slot).value;
+    });
+    return true;
+  }
+
+  DataProcessingDevice::dispatchComputation(context, completed);
+
+  auto switchState = [&control = context.registry->get<ControlService>(),
+                      &state = context.deviceContext->state](StreamingState newState) {
+    state->streaming = newState;
+    control.notifyStreamingState(state->streaming);
   };
 
-  // We use this to get a list with the actual indexes in the cache which
-  // indicate a complete set of inputs. Notice how I fill the completed
-  // vector and return it, so that I can have a nice for loop iteration later
-  // on.
-  auto getReadyActions = [&relayer = context.relayer,
-                          &completed,
-                          &stats = context.registry->get<DataProcessingStats>()]() -> std::vector<DataRelayer::RecordAction> {
-    stats.pendingInputs = (int)relayer->getParallelTimeslices() - completed.size();
-    stats.incomplete = completed.empty() ? 1 : 0;
-    return completed;
+  // We now broadcast the end of stream if it was requested
+  if (context.deviceContext->state->streaming == StreamingState::EndOfStreaming) {
+    for (auto& channel : context.deviceContext->spec->outputChannels) {
+      DataProcessingHelpers::sendEndOfStream(*context.deviceContext->device, channel);
+    }
+    switchState(StreamingState::Idle);
+  }
+
+  return true;
+}
+
+void DataProcessingDevice::dispatchComputation(DataProcessorContext& context, std::vector<DataRelayer::RecordAction>& completed)
+{
+  ZoneScopedN("DataProcessingDevice::dispatchComputation");
+  // This is the actual hidden state for the outer loop. Each stream
+  // has its own, so that they can dispatch concurrently.
+  std::vector<MessageSet> currentSetOfInputs;
+  // Streams other than the main one have to wait for their turn to send.
+  StreamTurn turn{context.deviceContext->sequencer, context.ticket};
+  // They also get the timeslice already taken from the relayer, and must
+  // not access its slot, which might be in use for another one by now.
+  HandedOffTimeslice* handedOff = context.handedOff;
+
+  auto reportError = [&registry = *context.registry, &context](const char* message) {
+    registry.get<DataProcessingStats>().errorCount++;
   };
 
   //
-  auto getInputSpan = [&relayer = context.relayer,
+  auto getInputSpan = [&relayer = context.relayer, handedOff,
                        &currentSetOfInputs](TimesliceSlot slot) {
-    currentSetOfInputs = std::move(relayer->getInputsForTimeslice(slot));
+    if (handedOff) {
+      currentSetOfInputs = std::move(handedOff->inputs);
+    } else {
+      currentSetOfInputs = std::move(relayer->getInputsForTimeslice(slot));
+    }
     auto getter = [&currentSetOfInputs](size_t i, size_t partindex) -> DataRef {
       if (currentSetOfInputs[i].size() > partindex) {
         return DataRef{nullptr,
@@ -1002,7 +1304,11 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     return InputSpan{getter, nofPartsGetter, currentSetOfInputs.size()};
   };
 
-  auto markInputsAsDone = [&relayer = context.relayer](TimesliceSlot slot) -> void {
+  auto markInputsAsDone = [&relayer = context.relayer, handedOff](TimesliceSlot slot) -> void {
+    // Already done when handing the timeslice off.
+    if (handedOff) {
+      return;
+    }
     relayer->updateCacheStatus(slot, CacheEntryStatus::RUNNING, CacheEntryStatus::DONE);
   };
 
@@ -1011,8 +1317,14 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
   // create messages) because the messages need to have the timeslice id into
   // it.
   auto prepareAllocatorForCurrentTimeSlice = [&timingInfo = context.timingInfo,
-                                              &relayer = context.relayer](TimesliceSlot i) {
+                                              &relayer = context.relayer, handedOff](TimesliceSlot i) {
     ZoneScopedN("DataProcessingDevice::prepareForCurrentTimeslice");
+    if (handedOff) {
+      timingInfo->timeslice = handedOff->timeslice.value;
+      timingInfo->tfCounter = handedOff->firstTFCounter;
+      timingInfo->firstTFOrbit = handedOff->firstTFOrbit;
+      return;
+    }
     auto timeslice = relayer->getTimesliceForSlot(i);
     timingInfo->timeslice = timeslice.value;
     timingInfo->tfCounter = relayer->getFirstTFCounterForSlot(i);
@@ -1138,19 +1450,10 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     }
   };
 
-  auto switchState = [&control = context.registry->get<ControlService>(),
-                      &state = context.deviceContext->state](StreamingState newState) {
-    state->streaming = newState;
-    control.notifyStreamingState(state->streaming);
-  };
-
-  if (canDispatchSomeComputation() == false) {
-    return false;
-  }
-
-  auto postUpdateStats = [&stats = context.registry->get<DataProcessingStats>()](DataRelayer::RecordAction const& action, InputRecord const& record, uint64_t tStart) {
+  auto postUpdateStats = [&stats = context.registry->get<DataProcessingStats>(), handedOff](DataRelayer::RecordAction const& action, InputRecord const& record, uint64_t tStart) {
     std::atomic_thread_fence(std::memory_order_release);
-    for (size_t ai = 0; ai != record.size(); ai++) {
+    // The slot of a handed off timeslice might be in use for another one.
+    for (size_t ai = 0; handedOff == nullptr && ai != record.size(); ai++) {
       auto cacheId = action.slot.index * record.size() + ai;
       auto state = record.isValid(ai) ? 3 : 0;
       update_maximum(stats.statesSize, cacheId + 1);
@@ -1164,9 +1467,10 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     stats.lastLatency = calculateInputRecordLatency(record, tStart);
   };
 
-  auto preUpdateStats = [&stats = context.registry->get<DataProcessingStats>()](DataRelayer::RecordAction const& action, InputRecord const& record, uint64_t tStart) {
+  auto preUpdateStats = [&stats = context.registry->get<DataProcessingStats>(), handedOff](DataRelayer::RecordAction const& action, InputRecord const& record, uint64_t tStart) {
     std::atomic_thread_fence(std::memory_order_release);
-    for (size_t ai = 0; ai != record.size(); ai++) {
+    // Already done when handing the timeslice off.
+    for (size_t ai = 0; handedOff == nullptr && ai != record.size(); ai++) {
       auto cacheId = action.slot.index * record.size() + ai;
       auto state = record.isValid(ai) ? 2 : 0;
       update_maximum(stats.statesSize, cacheId + 1);
@@ -1175,7 +1479,22 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     }
   };
 
-  for (auto action : getReadyActions()) {
+  // With --latency-trace, outputs created while processing carry the critical
+  // path of their timeslice. Make sure nothing points to it once we are done.
+  auto latencyArrivals = context.deviceContext->latencyArrivals;
+  LatencyTraceHeader criticalPath;
+  auto deviceHash = LatencyTraceHeader::deviceHash(context.deviceContext->spec->id);
+  auto forgetCriticalPath = make_scope_guard([&timingInfo = context.timingInfo]() noexcept {
+    timingInfo->criticalPath = nullptr;
+  });
+  // Inputs can be sent again by reference, see DataAllocator::forwardPayload.
+  auto& messageContext = context.registry->get<MessageContext>();
+  messageContext.setInputs(&currentSetOfInputs);
+  auto forgetInputs = make_scope_guard([&messageContext]() noexcept {
+    messageContext.setInputs(nullptr);
+  });
+
+  for (auto action : completed) {
     if (action.op == CompletionPolicy::CompletionOp::Wait) {
       continue;
     }
@@ -1189,6 +1508,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       context.registry->preProcessingCallbacks(processContext);
     }
     if (action.op == CompletionPolicy::CompletionOp::Discard) {
+      turn.acquire();
       context.registry->postDispatchingCallbacks(processContext);
       if (context.deviceContext->spec->forwards.empty() == false) {
         forwardInputs(action.slot, record);
@@ -1199,10 +1519,14 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
 
     uint64_t tStart = uv_hrtime();
     preUpdateStats(action, record, tStart);
+    if (latencyArrivals) {
+      fillCriticalPath(record, *latencyArrivals, deviceHash, LatencyTraceHeader::now(), criticalPath);
+      context.timingInfo->criticalPath = &criticalPath;
+    }
 
     static bool noCatch = getenv("O2_NO_CATCHALL_EXCEPTIONS") && strcmp(getenv("O2_NO_CATCHALL_EXCEPTIONS"), "0");
 
-    auto runNoCatch = [&context, &processContext]() {
+    auto runNoCatch = [&context, &processContext, &turn]() {
       if (context.deviceContext->state->quitRequested == false) {
         if (*context.statefulProcess) {
           ZoneScopedN("statefull process");
@@ -1213,6 +1537,7 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
           (*context.statelessProcess)(processContext);
         }
 
+        turn.acquire();
         {
           ZoneScopedN("service post processing");
           context.registry->postProcessingCallbacks(processContext);
@@ -1239,9 +1564,15 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
     }
 
     postUpdateStats(action, record, tStart);
+    context.timingInfo->criticalPath = nullptr;
+    if (latencyArrivals && context.deviceContext->spec->outputs.empty()) {
+      criticalPath.hops[criticalPath.hopsCount - 1].finish = LatencyTraceHeader::now();
+      reportCriticalPath(context.registry->get<o2::monitoring::Monitoring>(), criticalPath);
+    }
     // We forward inputs only when we consume them. If we simply Process them,
     // we keep them for next message arriving.
     if (action.op == CompletionPolicy::CompletionOp::Consume) {
+      turn.acquire();
       context.registry->postDispatchingCallbacks(processContext);
       if (context.deviceContext->spec->forwards.empty() == false) {
         forwardInputs(action.slot, record);
@@ -1253,15 +1584,14 @@ bool DataProcessingDevice::tryDispatchComputation(DataProcessorContext& context,
       cleanTimers(action.slot, record);
     }
   }
-  // We now broadcast the end of stream if it was requested
-  if (context.deviceContext->state->streaming == StreamingState::EndOfStreaming) {
-    for (auto& channel : context.deviceContext->spec->outputChannels) {
-      DataProcessingHelpers::sendEndOfStream(*context.deviceContext->device, channel);
-    }
-    switchState(StreamingState::Idle);
-  }
 
-  return true;
+  // What this stream sent is accounted to its own offer, once it is done.
+  if (handedOff) {
+    turn.acquire();
+    auto& consumers = context.deviceContext->state->offerConsumers;
+    context.offerConsumers.insert(context.offerConsumers.end(), consumers.begin(), consumers.end());
+    consumers.clear();
+  }
 }
 
 void DataProcessingDevice::error(const char* msg)
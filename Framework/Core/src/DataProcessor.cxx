@@ -13,6 +13,7 @@
 #include "Framework/StringContext.h"
 #include "Framework/ArrowContext.h"
 #include "Framework/RawBufferContext.h"
+#include "Framework/LatencyTraceHeader.h"
 #include "Framework/TMessageSerializer.h"
 #include "Framework/ServiceRegistry.h"
 #include "FairMQResizableBuffer.h"
@@ -33,8 +34,49 @@ using DataHeader = o2::header::DataHeader;
 namespace o2::framework
 {
 
+namespace
+{
+/// The hop of this device in the critical path ends when the output leaves.
+void markSent(FairMQMessage& header, uint64_t now)
+{
+  auto trace = o2::header::get<LatencyTraceHeader*>(header.GetData());
+  if (trace == nullptr || trace->hopsCount == 0) {
+    return;
+  }
+  auto& hop = const_cast<LatencyTraceHeader*>(trace)->hops[trace->hopsCount - 1];
+  if (hop.finish == 0) {
+    hop.finish = now;
+  }
+}
+
+void markSent(FairMQParts& parts)
+{
+  auto now = LatencyTraceHeader::now();
+  for (int i = 0; i < parts.Size(); i += 2) {
+    markSent(*parts.At(i), now);
+  }
+}
+
+/// Send a single header / payload pair, together with whatever the tap of
+/// the MessageContext (e.g. the data sampling one) adds for it.
+void sendWithTap(FairMQDevice& device, FairMQParts& parts, std::string const& channel, ServiceRegistry& registry)
+{
+  std::unordered_map<std::string const*, FairMQParts> tapped;
+  if (auto& tap = registry.get<MessageContext>().tap()) {
+    tap(*parts.At(0), *parts.At(1), tapped);
+  }
+  markSent(parts);
+  device.Send(parts, channel, 0);
+  for (auto& [tappedChannel, tappedParts] : tapped) {
+    markSent(tappedParts);
+    device.Send(tappedParts, *tappedChannel, 0);
+  }
+}
+} // namespace
+
 void DataProcessor::doSend(FairMQDevice& device, FairMQParts&& parts, const char* channel, unsigned int index)
 {
+  markSent(parts);
   device.Send(parts, channel, index);
 }
 
@@ -47,16 +89,20 @@ void DataProcessor::doSend(FairMQDevice& device, MessageContext& context, Servic
     FairMQParts parts = std::move(message->finalize());
     assert(message->empty());
     assert(parts.Size() == 2);
+    if (context.tap()) {
+      context.tap()(*parts.At(0), *parts.At(1), outputs);
+    }
     for (auto& part : parts) {
       outputs[&(message->channel())].AddPart(std::move(part));
     }
   }
   for (auto& [channel, parts] : outputs) {
+    markSent(parts);
     device.Send(parts, *channel, 0);
   }
 }
 
-void DataProcessor::doSend(FairMQDevice& device, StringContext& context, ServiceRegistry&)
+void DataProcessor::doSend(FairMQDevice& device, StringContext& context, ServiceRegistry& registry)
 {
   for (auto& messageRef : context) {
     FairMQParts parts;
@@ -71,7 +117,7 @@ void DataProcessor::doSend(FairMQDevice& device, StringContext& context, Service
     dh->payloadSize = payload->GetSize();
     parts.AddPart(std::move(messageRef.header));
     parts.AddPart(std::move(payload));
-    device.Send(parts, messageRef.channel, 0);
+    sendWithTap(device, parts, messageRef.channel, registry);
   }
 }
 
@@ -102,7 +148,7 @@ void DataProcessor::doSend(FairMQDevice& device, ArrowContext& context, ServiceR
     context.updateMessagesSent(1);
     parts.AddPart(std::move(messageRef.header));
     parts.AddPart(std::move(payload));
-    device.Send(parts, messageRef.channel, 0);
+    sendWithTap(device, parts, messageRef.channel, registry);
   }
   static int64_t previousBytesSent = 0;
   auto disposeResources = [bs = context.bytesSent() - previousBytesSent](int taskId, std::array<ComputingQuotaOffer, 16>& offers) {
@@ -144,7 +190,7 @@ void DataProcessor::doSend(FairMQDevice& device, RawBufferContext& context, Serv
     dh->payloadSize = size;
     parts.AddPart(std::move(messageRef.header));
     parts.AddPart(std::move(payload));
-    device.Send(parts, messageRef.channel, 0);
+    sendWithTap(device, parts, messageRef.channel, registry);
   }
 }
 
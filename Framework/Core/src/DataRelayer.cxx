@@ -33,6 +33,8 @@
 
 #include <fmt/format.h>
 #include <gsl/span>
+#include <algorithm>
+#include <chrono>
 #include <numeric>
 #include <string>
 
@@ -57,7 +59,8 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
     mMetrics{metrics},
     mCompletionPolicy{policy},
     mDistinctRoutesIndex{DataRelayerHelpers::createDistinctRouteIndex(routes)},
-    mInputMatchers{DataRelayerHelpers::createInputMatchers(routes)}
+    mInputMatchers{DataRelayerHelpers::createInputMatchers(routes)},
+    mRouteMatchingTable{std::make_unique<RouteMatchingTable>(DataRelayerHelpers::createRouteMatchingTable(routes, mDistinctRoutesIndex))}
 {
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
 
@@ -78,6 +81,8 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
   }
 }
 
+DataRelayer::~DataRelayer() = default;
+
 TimesliceId DataRelayer::getTimesliceForSlot(TimesliceSlot slot)
 {
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
@@ -104,16 +109,41 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
   if (slotsCreatedByHandlers.empty() == false) {
     activity.newSlots++;
   }
+  // If the handlers were not asked for the slots they are due on, there is
+  // nothing which can expire.
+  if (slotsCreatedByHandlers.empty()) {
+    return activity;
+  }
+  auto createdByHandlers = [&slotsCreatedByHandlers](TimesliceSlot slot) {
+    return std::any_of(slotsCreatedByHandlers.begin(), slotsCreatedByHandlers.end(),
+                       [slot](TimesliceSlot const& created) { return created.index == slot.index; });
+  };
+  bool anyCreated = std::any_of(slotsCreatedByHandlers.begin(), slotsCreatedByHandlers.end(),
+                                [](TimesliceSlot const& created) { return created.index != TimesliceSlot::ANY && created.index != TimesliceSlot::INVALID; });
+  uint64_t now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+  // No new slot and none of the old ones is due yet, so there is no need to
+  // look at them.
+  if (anyCreated == false && mTimesliceIndex.getEarliestCheck() > now) {
+    return activity;
+  }
   // Outer loop, we process all the records because the fact that the record
-  // expires is independent from having received data for it.
+  // expires is independent from having received data for it. Only the slots
+  // which were just created by a handler, or which are dangling by now, can
+  // have something to expire, so we skip all the others without looking at
+  // their inputs.
   for (size_t ti = 0; ti < mTimesliceIndex.size(); ++ti) {
     TimesliceSlot slot{ti};
     if (mTimesliceIndex.isValid(slot) == false) {
       continue;
     }
+    if (mTimesliceIndex.isDangling(slot, now) == false && createdByHandlers(slot) == false) {
+      continue;
+    }
     assert(mDistinctRoutesIndex.empty() == false);
     auto timestamp = mTimesliceIndex.getTimesliceForSlot(slot);
     auto& variables = mTimesliceIndex.getVariablesForSlot(slot);
+    // When some input could expire in a later iteration.
+    uint64_t nextCheck = ExpirationHandler::NEVER;
     // We iterate on all the hanlders checking if they need to be expired.
     for (size_t ei = 0; ei < expirationHandlers.size(); ++ei) {
       auto& expirator = expirationHandlers[ei];
@@ -133,7 +163,15 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
       if (slotsCreatedByHandlers[ei] != slot) {
         continue;
       }
-      if (expirator.checker(timestamp.value) == false) {
+      // Checkers which do not know better get asked again on the next
+      // iteration. expireAlways is not one of them, as it never returns false.
+      uint64_t handlerNextCheck = 0;
+      if (expirator.checker(timestamp.value, handlerNextCheck) == false) {
+        // Handlers which are not bound to a given slot might still expire
+        // this one later on.
+        if (slotsCreatedByHandlers[ei].index == TimesliceSlot::ANY) {
+          nextCheck = std::min(nextCheck, handlerNextCheck);
+        }
         continue;
       }
 
@@ -150,7 +188,9 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
       assert(part[0].header != nullptr);
       assert(part[0].payload != nullptr);
     }
+    mTimesliceIndex.markAsDangling(slot, nextCheck);
   }
+  mTimesliceIndex.updateEarliestCheck();
   return activity;
 }
 
@@ -158,20 +198,12 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
 /// reason why these might diffent is that when you have timepipelining
 /// you have one route per timeslice, even if the type is the same.
 size_t matchToContext(void* data,
+                      RouteMatchingTable const& table,
                       std::vector<DataDescriptorMatcher> const& matchers,
                       std::vector<size_t> const& index,
                       VariableContext& context)
 {
-  for (size_t ri = 0, re = index.size(); ri < re; ++ri) {
-    auto& matcher = matchers[index[ri]];
-
-    if (matcher.match(reinterpret_cast<char const*>(data), context)) {
-      context.commit();
-      return ri;
-    }
-    context.discard();
-  }
-  return INVALID_INPUT;
+  return DataRelayerHelpers::matchToContext(table, reinterpret_cast<char const*>(data), matchers, index, context);
 }
 
 /// Send the contents of a context as metrics, so that we can examine them in
@@ -225,13 +257,14 @@ DataRelayer::RelayChoice
   // function because while it's trivial now, the actual matchmaking will
   // become more complicated when we will start supporting ranges.
   auto getInputTimeslice = [&matchers = mInputMatchers,
+                            &table = *mRouteMatchingTable,
                             &distinctRoutes = mDistinctRoutesIndex,
                             &firstPart,
                             &index](VariableContext& context)
     -> std::tuple<int, TimesliceId> {
     /// FIXME: for the moment we only use the first context and reset
     /// between one invokation and the other.
-    auto input = matchToContext(firstPart->GetData(), matchers, distinctRoutes, context);
+    auto input = matchToContext(firstPart->GetData(), table, matchers, distinctRoutes, context);
 
     if (input == INVALID_INPUT) {
       return {
@@ -359,6 +392,8 @@ DataRelayer::RelayChoice
     O2_SIGNPOST(O2_PROBE_DATARELAYER, timeslice.value, 0, 0, 0);
     if (needsCleaning) {
       pruneCache(slot);
+      // The slot was reused for a new timeslice.
+      index.markAsDangling(slot, 0);
     }
     saveInSlot(timeslice, input, slot);
     index.publishSlot(slot);
@@ -547,6 +582,12 @@ void DataRelayer::updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStat
   }
 }
 
+void DataRelayer::markAsPending(TimesliceSlot slot)
+{
+  std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
+  mTimesliceIndex.markAsPending(slot, true);
+}
+
 std::vector<o2::framework::MessageSet> DataRelayer::getInputsForTimeslice(TimesliceSlot slot)
 {
   std::scoped_lock<LockableBase(std::recursive_mutex)> lock(mMutex);
@@ -11,6 +11,7 @@
 
 #include "DataRelayerHelpers.h"
 #include "Framework/DataDescriptorMatcher.h"
+#include "Headers/Stack.h"
 #include <stdexcept>
 
 using namespace o2::framework::data_matcher;
@@ -69,4 +70,69 @@ std::vector<DataDescriptorMatcher>
   return result;
 }
 
+RouteMatchingTable
+  DataRelayerHelpers::createRouteMatchingTable(std::vector<InputRoute> const& routes,
+                                               std::vector<size_t> const& distinctRoutes)
+{
+  RouteMatchingTable result;
+  for (size_t ri = 0; ri < distinctRoutes.size(); ++ri) {
+    auto& route = routes[distinctRoutes[ri]];
+    if (auto pval = std::get_if<ConcreteDataMatcher>(&route.matcher.matcher)) {
+      // In case the same data is requested twice, the first route wins,
+      // like when the matchers are evaluated in order.
+      result.concrete.emplace(RouteMatchingTable::Key{pval->origin, pval->description, pval->subSpec}, ri);
+    } else {
+      result.wildcards.push_back(ri);
+    }
+  }
+  return result;
+}
+
+size_t DataRelayerHelpers::matchToContext(RouteMatchingTable const& table,
+                                          char const* data,
+                                          std::vector<DataDescriptorMatcher> const& matchers,
+                                          std::vector<size_t> const& index,
+                                          VariableContext& context)
+{
+  auto tryRoute = [&](size_t ri) -> bool {
+    if (matchers[index[ri]].match(data, context)) {
+      context.commit();
+      return true;
+    }
+    context.discard();
+    return false;
+  };
+
+  auto dh = o2::header::get<header::DataHeader*>(data);
+  if (dh == nullptr) {
+    // Let the matchers deal with the malformed message.
+    for (size_t ri = 0; ri < index.size(); ++ri) {
+      if (tryRoute(ri)) {
+        return ri;
+      }
+    }
+    return -1;
+  }
+
+  auto candidate = table.concrete.find(RouteMatchingTable::Key{dh->dataOrigin, dh->dataDescription, dh->subSpecification});
+  size_t candidateRoute = candidate != table.concrete.end() ? candidate->second : index.size();
+  // Wildcards before the candidate take precedence, the ones after it are
+  // only used if the candidate itself does not match (e.g. no start time).
+  auto wi = table.wildcards.begin();
+  for (; wi != table.wildcards.end() && *wi < candidateRoute; ++wi) {
+    if (tryRoute(*wi)) {
+      return *wi;
+    }
+  }
+  if (candidateRoute != index.size() && tryRoute(candidateRoute)) {
+    return candidateRoute;
+  }
+  for (; wi != table.wildcards.end(); ++wi) {
+    if (tryRoute(*wi)) {
+      return *wi;
+    }
+  }
+  return -1;
+}
+
 } // namespace o2::framework
@@ -12,17 +12,67 @@
 #define O2_FRAMEWORK_DATARELAYERHELPERS_H_
 
 #include "Framework/InputRoute.h"
+#include "Headers/DataHeader.h"
+#include <cstddef>
+#include <unordered_map>
 #include <vector>
 
 namespace o2::framework
 {
 
+/// Lookup table used to find which distinct input route a message belongs to,
+/// without evaluating the matchers of all the routes. Routes with a concrete
+/// InputSpec are indexed by their (origin, description, subspecification),
+/// the others (wildcards) are kept aside and still need to be evaluated.
+/// Positions refer to the distinct route index, like the result of
+/// DataRelayer's matchToContext.
+struct RouteMatchingTable {
+  struct Key {
+    header::DataOrigin origin;
+    header::DataDescription description;
+    header::DataHeader::SubSpecificationType subSpec;
+
+    bool operator==(Key const& other) const
+    {
+      return origin == other.origin && description == other.description && subSpec == other.subSpec;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(Key const& key) const
+    {
+      uint64_t h = key.description.itg[0] ^ (key.description.itg[1] * 0x9e3779b97f4a7c15ULL);
+      h ^= (uint64_t(key.origin.itg[0]) << 32 | key.subSpec) * 0xc2b2ae3d27d4eb4fULL;
+      return h ^ (h >> 29);
+    }
+  };
+
+  /// First distinct route position with the given concrete matcher.
+  std::unordered_map<Key, size_t, KeyHash> concrete;
+  /// Sorted distinct route positions which need to be evaluated.
+  std::vector<size_t> wildcards;
+};
+
 struct DataRelayerHelpers {
   /// Calculate how many input routes there are, doublecounting different
   /// timeslices.
   static std::vector<size_t> createDistinctRouteIndex(std::vector<InputRoute> const&);
   /// This converts from InputRoute to the associated DataDescriptorMatcher.
   static std::vector<data_matcher::DataDescriptorMatcher> createInputMatchers(std::vector<InputRoute> const&);
+  /// Build the lookup table for the routes at the positions given by
+  /// the distinct route index.
+  static RouteMatchingTable createRouteMatchingTable(std::vector<InputRoute> const& routes,
+                                                     std::vector<size_t> const& distinctRoutes);
+  /// Find the position in @a index of the first route whose matcher accepts
+  /// the header stack pointed by @a data, committing the variables it binds
+  /// to @a context. Gives the same result as trying all the matchers in order,
+  /// but only the wildcard routes and the route found in @a table are
+  /// evaluated. Returns -1 if no route matches.
+  static size_t matchToContext(RouteMatchingTable const& table,
+                               char const* data,
+                               std::vector<data_matcher::DataDescriptorMatcher> const& matchers,
+                               std::vector<size_t> const& index,
+                               data_matcher::VariableContext& context);
 };
 
 } // namespace o2::framework
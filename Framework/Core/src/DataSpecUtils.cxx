@@ -420,6 +420,22 @@ ConcreteDataTypeMatcher DataSpecUtils::asConcreteDataTypeMatcher(InputSpec const
                     spec.matcher);
 }
 
+std::optional<ConcreteDataTypeMatcher> DataSpecUtils::optionalConcreteDataTypeMatcher(InputSpec const& spec)
+{
+  return std::visit(overloaded{
+                      [](ConcreteDataMatcher const& concrete) -> std::optional<ConcreteDataTypeMatcher> {
+                        return ConcreteDataTypeMatcher{concrete.origin, concrete.description};
+                      },
+                      [](DataDescriptorMatcher const& matcher) -> std::optional<ConcreteDataTypeMatcher> {
+                        auto state = extractMatcherInfo(matcher);
+                        if (state.hasError == false && state.hasUniqueOrigin && state.hasUniqueDescription) {
+                          return ConcreteDataTypeMatcher{state.origin, state.description};
+                        }
+                        return {};
+                      }},
+                    spec.matcher);
+}
+
 header::DataOrigin DataSpecUtils::asConcreteOrigin(InputSpec const& spec)
 {
   return std::visit(overloaded{
@@ -0,0 +1,212 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "DeviceMetricsRing.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace o2::framework
+{
+
+/// Lives at the beginning of the segment, followed by the records. head is
+/// only written by the device, tail only by the driver, so they are kept on
+/// different cachelines.
+struct DeviceMetricsRing::Header {
+  static constexpr uint32_t MAGIC = 0x4d4c5044; // "DPLM"
+  uint32_t magic;
+  uint32_t capacity;
+  alignas(64) std::atomic<uint64_t> head;
+  alignas(64) std::atomic<uint64_t> tail;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring indices must be lock free to be shared between processes");
+
+size_t DeviceMetricsRing::segmentSize(uint32_t capacity)
+{
+  return sizeof(Header) + capacity * sizeof(BinaryMetric);
+}
+
+DeviceMetricsRing::DeviceMetricsRing(void* memory, size_t size, std::string name, bool owner)
+  : mHeader{reinterpret_cast<Header*>(memory)},
+    mRecords{reinterpret_cast<BinaryMetric*>(reinterpret_cast<char*>(memory) + sizeof(Header))},
+    mSize{size},
+    mName{std::move(name)},
+    mOwner{owner}
+{
+}
+
+DeviceMetricsRing::~DeviceMetricsRing()
+{
+  munmap(mHeader, mSize);
+  if (mOwner && mName.empty() == false) {
+    shm_unlink(mName.c_str());
+  }
+}
+
+std::string DeviceMetricsRing::segmentName(pid_t driverPid, std::string const& deviceId)
+{
+  auto name = fmt::format("/dpl-metrics-{}-{}", driverPid, deviceId);
+  std::replace(name.begin() + 1, name.end(), '/', '_');
+  return name;
+}
+
+std::unique_ptr<DeviceMetricsRing> DeviceMetricsRing::create(std::string const& name, uint32_t capacity)
+{
+  // Round to a power of two, so that positions can be masked.
+  uint32_t roundedCapacity = 1;
+  while (roundedCapacity < capacity) {
+    roundedCapacity <<= 1;
+  }
+  size_t size = segmentSize(roundedCapacity);
+  void* memory = MAP_FAILED;
+  if (name.empty()) {
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  } else {
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if (fd < 0) {
+      return nullptr;
+    }
+    if (ftruncate(fd, size) == 0) {
+      memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED) {
+      shm_unlink(name.c_str());
+    }
+  }
+  if (memory == MAP_FAILED) {
+    return nullptr;
+  }
+  auto header = new (memory) Header{};
+  header->capacity = roundedCapacity;
+  header->head.store(0, std::memory_order_relaxed);
+  header->tail.store(0, std::memory_order_relaxed);
+  header->magic = Header::MAGIC;
+  return std::unique_ptr<DeviceMetricsRing>(new DeviceMetricsRing(memory, size, name, true));
+}
+
+std::unique_ptr<DeviceMetricsRing> DeviceMetricsRing::attach(std::string const& name)
+{
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat info;
+  void* memory = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(Header)) {
+    memory = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (memory == MAP_FAILED) {
+    return nullptr;
+  }
+  auto header = reinterpret_cast<Header*>(memory);
+  if (header->magic != Header::MAGIC || segmentSize(header->capacity) > (size_t)info.st_size) {
+    munmap(memory, info.st_size);
+    return nullptr;
+  }
+  return std::unique_ptr<DeviceMetricsRing>(new DeviceMetricsRing(memory, info.st_size, name, false));
+}
+
+uint32_t DeviceMetricsRing::capacity() const
+{
+  return mHeader->capacity;
+}
+
+BinaryMetric* DeviceMetricsRing::acquireSlot(std::string_view name, MetricType type, uint64_t timestamp)
+{
+  if (name.size() > BinaryMetric::MAX_KEY_SIZE) {
+    return nullptr;
+  }
+  auto head = mHeader->head.load(std::memory_order_relaxed);
+  if (head - mHeader->tail.load(std::memory_order_acquire) >= mHeader->capacity) {
+    return nullptr;
+  }
+  auto& record = mRecords[head & (mHeader->capacity - 1)];
+  record.timestamp = timestamp;
+  record.type = type;
+  record.keySize = name.size();
+  memcpy(record.key, name.data(), name.size());
+  return &record;
+}
+
+void DeviceMetricsRing::publish()
+{
+  mHeader->head.store(mHeader->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool DeviceMetricsRing::push(std::string_view name, int value, uint64_t timestamp)
+{
+  auto record = acquireSlot(name, MetricType::Int, timestamp);
+  if (record == nullptr) {
+    return false;
+  }
+  record->intValue = value;
+  publish();
+  return true;
+}
+
+bool DeviceMetricsRing::push(std::string_view name, float value, uint64_t timestamp)
+{
+  auto record = acquireSlot(name, MetricType::Float, timestamp);
+  if (record == nullptr) {
+    return false;
+  }
+  record->floatValue = value;
+  publish();
+  return true;
+}
+
+bool DeviceMetricsRing::push(std::string_view name, uint64_t value, uint64_t timestamp)
+{
+  auto record = acquireSlot(name, MetricType::Uint64, timestamp);
+  if (record == nullptr) {
+    return false;
+  }
+  record->uint64Value = value;
+  publish();
+  return true;
+}
+
+size_t DeviceMetricsRing::drain(DeviceMetricsInfo& info, DeviceMetricsHelper::NewMetricCallback newMetricCallback)
+{
+  auto tail = mHeader->tail.load(std::memory_order_relaxed);
+  auto head = mHeader->head.load(std::memory_order_acquire);
+  ParsedMetricMatch match;
+  for (auto pos = tail; pos != head; ++pos) {
+    auto& record = mRecords[pos & (mHeader->capacity - 1)];
+    match.beginKey = record.key;
+    match.endKey = record.key + std::min<size_t>(record.keySize, BinaryMetric::MAX_KEY_SIZE);
+    match.timestamp = record.timestamp;
+    match.type = record.type;
+    match.intValue = record.type == MetricType::Int ? record.intValue : 0;
+    match.floatValue = record.type == MetricType::Float ? record.floatValue : 0;
+    match.uint64Value = record.type == MetricType::Uint64 ? record.uint64Value : 0;
+    match.beginStringValue = nullptr;
+    match.endStringValue = nullptr;
+    DeviceMetricsHelper::processMetric(match, info, newMetricCallback);
+  }
+  // Only now the device is allowed to reuse the slots.
+  mHeader->tail.store(head, std::memory_order_release);
+  return head - tail;
+}
+
+} // namespace o2::framework
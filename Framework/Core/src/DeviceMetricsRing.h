@@ -0,0 +1,99 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DEVICEMETRICSRING_H_
+#define O2_FRAMEWORK_DEVICEMETRICSRING_H_
+
+#include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+
+namespace o2::framework
+{
+
+/// A numeric metric as it is stored in a DeviceMetricsRing. The name is
+/// carried inline, so that no registration step is needed between the
+/// device and the driver.
+struct BinaryMetric {
+  static constexpr size_t MAX_KEY_SIZE = 106;
+  uint64_t timestamp;
+  union {
+    int intValue;
+    float floatValue;
+    uint64_t uint64Value;
+  };
+  MetricType type;
+  uint16_t keySize;
+  char key[MAX_KEY_SIZE];
+};
+
+static_assert(sizeof(BinaryMetric) == 128, "BinaryMetric should be two cachelines");
+
+/// Single producer, single consumer ring of BinaryMetric living in a shared
+/// memory segment. The driver creates one for each device it spawns, before
+/// forking, and drains it in its main loop. The device attaches to it and
+/// uses it instead of printing "[METRIC] ..." lines, which the driver would
+/// otherwise have to parse. Whatever cannot go through the ring (string
+/// metrics, long names, full ring) still uses the text protocol.
+class DeviceMetricsRing
+{
+ public:
+  /// Number of metrics which can be in flight for a given device.
+  static constexpr uint32_t DEFAULT_CAPACITY = 8192;
+
+  ~DeviceMetricsRing();
+
+  /// Create a new ring, backed by the shared memory segment @a name. If
+  /// @a name is empty, the memory is simply shared with the children of the
+  /// current process. @return nullptr if the segment could not be created.
+  static std::unique_ptr<DeviceMetricsRing> create(std::string const& name, uint32_t capacity = DEFAULT_CAPACITY);
+  /// Attach to the ring created by the driver as @a name.
+  /// @return nullptr if there is no such ring.
+  static std::unique_ptr<DeviceMetricsRing> attach(std::string const& name);
+  /// Name of the segment used by the driver @a driverPid for the device @a deviceId.
+  static std::string segmentName(pid_t driverPid, std::string const& deviceId);
+
+  /// Producer side: add a metric to the ring.
+  /// @return false if the metric cannot be represented or the ring is full,
+  ///         in which case the caller is expected to use the text protocol.
+  bool push(std::string_view name, int value, uint64_t timestamp);
+  bool push(std::string_view name, float value, uint64_t timestamp);
+  bool push(std::string_view name, uint64_t value, uint64_t timestamp);
+
+  /// Consumer side: move all the pending metrics to @a info, exactly like
+  /// DeviceMetricsHelper::processMetric would do for the text version.
+  /// @return the number of metrics which were processed.
+  size_t drain(DeviceMetricsInfo& info, DeviceMetricsHelper::NewMetricCallback newMetricCallback = nullptr);
+
+  uint32_t capacity() const;
+
+ private:
+  struct Header;
+  DeviceMetricsRing(void* memory, size_t size, std::string name, bool owner);
+  static size_t segmentSize(uint32_t capacity);
+  BinaryMetric* acquireSlot(std::string_view name, MetricType type, uint64_t timestamp);
+  void publish();
+
+  Header* mHeader;
+  BinaryMetric* mRecords;
+  size_t mSize;
+  std::string mName;
+  bool mOwner;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_DEVICEMETRICSRING_H_
@@ -16,6 +16,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <set>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include "Framework/ChannelConfigurationPolicy.h"
@@ -309,7 +312,7 @@ void DeviceSpecHelpers::processOutEdgeActions(std::vector<DeviceSpec>& devices,
       resourceManager.notifyAcceptedOffer(acceptedOffer);
     }
 
-    auto processor = workflow[edge.producer];
+    auto& processor = workflow[edge.producer];
 
     acceptedOffer.cpu = defaultOffer.cpu;
     acceptedOffer.memory = defaultOffer.memory;
@@ -555,12 +558,11 @@ void DeviceSpecHelpers::processInEdgeActions(std::vector<DeviceSpec>& devices,
     device.resource = {acceptedOffer};
     device.labels = processor.labels;
 
-    // FIXME: maybe I should use an std::map in the end
-    //        but this is really not performance critical
+    // Keep the index sorted by inserting in place, rather than sorting it
+    // again for every new device.
     auto id = DeviceId{edge.consumer, edge.timeIndex, devices.size()};
     devices.push_back(device);
-    deviceIndex.push_back(id);
-    std::sort(deviceIndex.begin(), deviceIndex.end());
+    deviceIndex.insert(std::upper_bound(deviceIndex.begin(), deviceIndex.end(), id), id);
     return devices.size() - 1;
   };
 
@@ -617,11 +619,15 @@ void DeviceSpecHelpers::processInEdgeActions(std::vector<DeviceSpec>& devices,
     return consumerDevice.inputChannels.size() - 1;
   };
 
+  // The (device, timeslice, input) of the routes created so far, so that
+  // we do not need to look through all the routes of a device for each edge.
+  std::set<std::tuple<size_t, size_t, size_t>> knownRoutes;
+
   // This is always called when adding a new channel, so we can simply refer
   // to back. Notice also that this is the place where it makes sense to
   // assign the forwarding, given that the forwarded stuff comes from some
   // input.
-  auto appendInputRouteToDestDeviceChannel = [&devices, &logicalEdges, &workflow](size_t ei, size_t di, size_t ci) {
+  auto appendInputRouteToDestDeviceChannel = [&devices, &logicalEdges, &workflow, &knownRoutes](size_t ei, size_t di, size_t ci) {
     auto const& edge = logicalEdges[ei];
     auto const& consumer = workflow[edge.consumer];
     auto& consumerDevice = devices[di];
@@ -687,14 +693,8 @@ void DeviceSpecHelpers::processInEdgeActions(std::vector<DeviceSpec>& devices,
     // produced the same route, i.e. has the same matcher.  Without this,
     // otherwise, we would end up with as many input routes as the outputs that
     // can be matched by the wildcard.
-    for (size_t iri = 0; iri < consumerDevice.inputs.size(); ++iri) {
-      auto& existingRoute = consumerDevice.inputs[iri];
-      if (existingRoute.timeslice != edge.producerTimeIndex) {
-        continue;
-      }
-      if (existingRoute.inputSpecIndex == edge.consumerInputIndex) {
-        return;
-      }
+    if (knownRoutes.emplace(di, edge.producerTimeIndex, edge.consumerInputIndex).second == false) {
+      return;
     }
 
     consumerDevice.inputs.push_back(route);
@@ -837,17 +837,14 @@ void DeviceSpecHelpers::dataProcessorSpecs2DeviceSpecs(const WorkflowSpec& workf
     device.resourceMonitoringInterval = resourcesMonitoringInterval;
   }
 
+  // The deviceIndex is sorted by (processorIndex, timeslice).
   auto findDeviceIndex = [&deviceIndex](size_t processorIndex, size_t timeslice) {
-    for (auto& deviceEdge : deviceIndex) {
-      if (deviceEdge.processorIndex != processorIndex) {
-        continue;
-      }
-      if (deviceEdge.timeslice != timeslice) {
-        continue;
-      }
-      return deviceEdge.deviceIndex;
+    DeviceId id{processorIndex, timeslice, 0};
+    auto deviceEdge = std::lower_bound(deviceIndex.begin(), deviceIndex.end(), id);
+    if (deviceEdge == deviceIndex.end() || deviceEdge->processorIndex != processorIndex || deviceEdge->timeslice != timeslice) {
+      throw runtime_error("Unable to find device.");
     }
-    throw runtime_error("Unable to find device.");
+    return deviceEdge->deviceIndex;
   };
 
   // Optimize the topology when two devices are
@@ -860,9 +857,13 @@ void DeviceSpecHelpers::dataProcessorSpecs2DeviceSpecs(const WorkflowSpec& workf
       if (device1.resource.hostname != device2.resource.hostname) {
         continue;
       }
+      // Only the channels bound to the port of the connection can match.
       for (auto& input : device1.inputChannels) {
+        if (input.port != connection.port) {
+          continue;
+        }
         for (auto& output : device2.outputChannels) {
-          if (input.hostname == output.hostname && input.port == output.port) {
+          if (output.port == connection.port && input.hostname == output.hostname) {
             input.protocol = ChannelProtocol::IPC;
             output.protocol = ChannelProtocol::IPC;
             input.hostname += uniqueWorkflowId;
@@ -992,6 +993,11 @@ void DeviceSpecHelpers::prepareArguments(bool defaultQuiet, bool defaultStopped,
 {
   assert(deviceSpecs.size() == deviceExecutions.size());
   assert(deviceControls.size() == deviceExecutions.size());
+  // Index the infos by name once, rather than looking for each device.
+  std::unordered_map<std::string, DataProcessorInfo const*> processorInfosByName;
+  for (auto& info : processorInfos) {
+    processorInfosByName.emplace(info.name, &info);
+  }
   for (size_t si = 0; si < deviceSpecs.size(); ++si) {
     auto& spec = deviceSpecs[si];
     auto& control = deviceControls[si];
@@ -1006,7 +1012,7 @@ void DeviceSpecHelpers::prepareArguments(bool defaultQuiet, bool defaultStopped,
     /// Lookup the executable name in the metadata associated with the workflow.
     /// If we find it, we rewrite the command line arguments to be processed
     /// so that they look like the ones passed to the merged workflow.
-    auto pi = std::find_if(processorInfos.begin(), processorInfos.end(), [&](auto const& x) { return x.name == spec.id; });
+    auto pi = processorInfosByName.at(spec.id);
     argc = pi->cmdLineArgs.size() + 1;
     argv = (char**)malloc(sizeof(char**) * (argc + 1));
     argv[0] = strdup(pi->executable.data());
@@ -1118,6 +1124,7 @@ void DeviceSpecHelpers::prepareArguments(bool defaultQuiet, bool defaultStopped,
         realOdesc.add_options()("shm-monitor", bpo::value<std::string>());
         realOdesc.add_options()("channel-prefix", bpo::value<std::string>());
         realOdesc.add_options()("session", bpo::value<std::string>());
+        realOdesc.add_options()("latency-trace", bpo::value<bool>()->zero_tokens());
         filterArgsFct(expansions.we_wordc, expansions.we_wordv, realOdesc);
         wordfree(&expansions);
         return;
@@ -1271,6 +1278,7 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
     ("monitoring-backend", bpo::value<std::string>(), "monitoring connection string")                                                         //
     ("infologger-mode", bpo::value<std::string>(), "O2_INFOLOGGER_MODE override")                                                             //
     ("infologger-severity", bpo::value<std::string>(), "minimun FairLogger severity which goes to info logger")                               //
+    ("latency-trace", bpo::value<bool>()->zero_tokens()->default_value(false), "trace the critical path latency of each timeslice")          //
     ("child-driver", bpo::value<std::string>(), "external driver to start childs with (e.g. valgrind)");                                      //
 
   return forwardedDeviceOptions;
@@ -13,11 +13,15 @@
 #include "Framework/VariantHelpers.h"
 #include "Framework/Logger.h"
 #include "Framework/RuntimeError.h"
+#include "Framework/StringHelpers.h"
 #include "gandiva/tree_expr_builder.h"
 #include "arrow/table.h"
 #include "fmt/format.h"
 #include <stack>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <unordered_map>
 #include <set>
 #include <algorithm>
@@ -304,6 +308,43 @@ Operations createOperations(Filter const& expression)
   return OperationSpecs;
 }
 
+uint32_t hashExpression(Filter const& expression)
+{
+  std::ostringstream os;
+  auto describe = [&os](DatumSpec const& spec) {
+    std::visit(
+      overloaded{
+        [&os](LiteralNode::var_t const& arg) {
+          std::visit(
+            [&os](auto const& value) {
+              // literals must hash differently down to the last bit
+              using T = std::decay_t<decltype(value)>;
+              if constexpr (std::is_floating_point_v<T>) {
+                os << std::setprecision(std::numeric_limits<T>::max_digits10) << value;
+              } else {
+                os << value;
+              }
+            },
+            arg);
+        },
+        [&os](size_t arg) { os << "#" << arg; },
+        [&os](std::string const& arg) { os << arg; },
+        [](std::monostate) {}},
+      spec.datum);
+    os << ":" << static_cast<int>(spec.type);
+  };
+  for (auto& spec : createOperations(expression)) {
+    os << static_cast<int>(spec.op) << "(";
+    describe(spec.left);
+    os << ",";
+    describe(spec.right);
+    os << ")";
+    describe(spec.result);
+    os << ";";
+  }
+  return compile_time_hash(os.str().c_str());
+}
+
 gandiva::ConditionPtr makeCondition(gandiva::NodePtr node)
 {
   return gandiva::TreeExprBuilder::MakeCondition(node);
@@ -12,6 +12,8 @@
 #include "Framework/HistogramRegistry.h"
 #include <regex>
 #include <TList.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
 
 namespace o2::framework
 {
@@ -78,6 +80,10 @@ void HistogramRegistry::insert(const HistogramSpec& histSpec)
 // helper function that checks if histogram name can be used in registry
 void HistogramRegistry::validateHistName(const char* name, const uint32_t hash)
 {
+  // the workers of a parallel process() only have copies of the histograms which existed before
+  if (ProcessingSlot::current() >= 0) {
+    LOGF(FATAL, R"(Histogram "%s" cannot be added to HistogramRegistry "%s" while processing groups concurrently, please add it in init.)", name, mName);
+  }
   // validate that hash is unique
   auto it = std::find(mRegistryKey.begin(), mRegistryKey.end(), hash);
   if (it != mRegistryKey.end()) {
@@ -262,6 +268,76 @@ void HistogramRegistry::print(bool showAxisDetails)
   LOGF(INFO, "");
 }
 
+namespace
+{
+// bring a shadow histogram back to its empty state
+template <typename T>
+void resetShadow(std::shared_ptr<T>& hist)
+{
+  if constexpr (std::is_base_of_v<StepTHn, T>) {
+    auto resetArray = [](TArray* array) {
+      if (auto arrayF = dynamic_cast<TArrayF*>(array)) {
+        arrayF->Reset();
+      } else if (auto arrayD = dynamic_cast<TArrayD*>(array)) {
+        arrayD->Reset();
+      }
+    };
+    for (int step = 0; step < hist->getNSteps(); ++step) {
+      resetArray(hist->getValues(step));
+      resetArray(hist->getSumw2(step));
+    }
+  } else {
+    hist->Reset();
+  }
+}
+} // namespace
+
+void HistogramRegistry::createShadows(int n)
+{
+  if (mShadowValues.size() != static_cast<size_t>(n)) {
+    mShadowValues.clear();
+    mShadowValues.resize(n);
+  }
+  for (auto& shadow : mShadowValues) {
+    for (auto i = 0u; i < MAX_REGISTRY_SIZE; ++i) {
+      std::visit([&](const auto& sharedPtr) {
+        using T = typename std::decay_t<decltype(sharedPtr)>::element_type;
+        auto existing = std::get_if<std::shared_ptr<T>>(&shadow[i]);
+        if (sharedPtr && (existing == nullptr || *existing == nullptr)) {
+          auto clone = std::shared_ptr<T>(static_cast<T*>(sharedPtr->Clone()));
+          resetShadow(clone);
+          shadow[i] = clone;
+        }
+      },
+                 mRegistryValue[i]);
+    }
+  }
+}
+
+void HistogramRegistry::mergeShadows()
+{
+  if (mShadowValues.empty()) {
+    return;
+  }
+  for (auto i = 0u; i < MAX_REGISTRY_SIZE; ++i) {
+    std::visit([&](const auto& sharedPtr) {
+      using T = typename std::decay_t<decltype(sharedPtr)>::element_type;
+      if (!sharedPtr) {
+        return;
+      }
+      TList list;
+      for (auto& shadow : mShadowValues) {
+        list.Add(std::get<std::shared_ptr<T>>(shadow[i]).get());
+      }
+      sharedPtr->Merge(&list);
+      for (auto& shadow : mShadowValues) {
+        resetShadow(std::get<std::shared_ptr<T>>(shadow[i]));
+      }
+    },
+               mRegistryValue[i]);
+  }
+}
+
 // create output structure will be propagated to file-sink
 TList* HistogramRegistry::operator*()
 {
@@ -54,6 +54,24 @@ int InputRecord::getPos(const char* binding) const
   return -1;
 }
 
+bool InputBinding::resolve(std::vector<InputRoute> const& routes)
+{
+  // Same numbering as InputRecord::getPos, but this only happens once.
+  pos = -1;
+  auto inputIndex = 0;
+  for (auto& route : routes) {
+    if (route.timeslice != 0) {
+      continue;
+    }
+    if (route.matcher.binding == name) {
+      pos = inputIndex;
+      return true;
+    }
+    ++inputIndex;
+  }
+  return false;
+}
+
 int InputRecord::getPos(std::string const& binding) const
 {
   return this->getPos(binding.c_str());
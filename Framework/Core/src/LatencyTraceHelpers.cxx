@@ -0,0 +1,120 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/LatencyTraceHelpers.h"
+#include "Framework/LatencyTraceHeader.h"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+
+namespace o2::framework
+{
+
+namespace
+{
+std::vector<LatencyPercentiles> aggregate(std::vector<DeviceSpec> const& specs,
+                                          std::vector<DeviceMetricsInfo> const& metrics,
+                                          std::string_view prefix)
+{
+  std::unordered_map<uint32_t, std::string const*> names;
+  for (auto& spec : specs) {
+    names[LatencyTraceHeader::deviceHash(spec.id)] = &spec.id;
+  }
+
+  // The same edge can be reported by more than one sink, so the samples
+  // are grouped by the devices they refer to.
+  std::map<std::vector<uint32_t>, std::vector<int>> samples;
+  for (auto& info : metrics) {
+    for (size_t mi = 0; mi < info.metricLabels.size(); ++mi) {
+      std::string_view label{info.metricLabels[mi].label, info.metricLabels[mi].size};
+      auto const& metric = info.metrics[mi];
+      if (label.substr(0, prefix.size()) != prefix || metric.type != MetricType::Int) {
+        continue;
+      }
+      std::vector<uint32_t> devices;
+      for (auto pos = prefix.size(); pos < label.size(); pos += 9) {
+        devices.push_back(strtoul(std::string{label.substr(pos + 1, 8)}.c_str(), nullptr, 16));
+      }
+      auto& store = info.intMetrics[metric.storeIdx];
+      auto& values = samples[devices];
+      values.insert(values.end(), store.begin(), store.begin() + std::min(metric.filledMetrics, store.size()));
+    }
+  }
+
+  std::vector<LatencyPercentiles> result;
+  for (auto& [devices, values] : samples) {
+    if (values.empty()) {
+      continue;
+    }
+    LatencyPercentiles percentiles;
+    for (auto device : devices) {
+      auto name = names.find(device);
+      percentiles.devices.push_back(name != names.end() ? *name->second : fmt::format("{:08x}", device));
+    }
+    percentiles.samples = values.size();
+    std::sort(values.begin(), values.end());
+    percentiles.p50 = values[(values.size() - 1) * 50 / 100];
+    percentiles.p99 = values[(values.size() - 1) * 99 / 100];
+    result.push_back(percentiles);
+  }
+  std::sort(result.begin(), result.end(), [](auto const& a, auto const& b) { return a.p99 > b.p99; });
+  return result;
+}
+
+boost::property_tree::ptree toPropertyTree(std::vector<LatencyPercentiles> const& entries)
+{
+  boost::property_tree::ptree result;
+  for (auto& entry : entries) {
+    boost::property_tree::ptree node;
+    boost::property_tree::ptree devices;
+    for (auto& device : entry.devices) {
+      boost::property_tree::ptree name;
+      name.put("", device);
+      devices.push_back(std::make_pair("", name));
+    }
+    node.add_child("devices", devices);
+    node.put("samples", entry.samples);
+    node.put("p50_us", entry.p50);
+    node.put("p99_us", entry.p99);
+    result.push_back(std::make_pair("", node));
+  }
+  return result;
+}
+} // namespace
+
+std::vector<LatencyPercentiles> LatencyTraceHelpers::edges(std::vector<DeviceSpec> const& specs,
+                                                           std::vector<DeviceMetricsInfo> const& metrics)
+{
+  return aggregate(specs, metrics, "latency-edge");
+}
+
+std::vector<LatencyPercentiles> LatencyTraceHelpers::paths(std::vector<DeviceSpec> const& specs,
+                                                           std::vector<DeviceMetricsInfo> const& metrics)
+{
+  return aggregate(specs, metrics, "latency-path");
+}
+
+void LatencyTraceHelpers::dumpToJSON(std::ostream& out,
+                                     std::vector<LatencyPercentiles> const& edges,
+                                     std::vector<LatencyPercentiles> const& paths)
+{
+  boost::property_tree::ptree root;
+  root.add_child("edges", toPropertyTree(edges));
+  root.add_child("paths", toPropertyTree(paths));
+  boost::property_tree::json_parser::write_json(out, root);
+}
+
+} // namespace o2::framework
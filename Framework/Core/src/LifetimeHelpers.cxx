@@ -118,25 +118,29 @@ ExpirationHandler::Creator LifetimeHelpers::timeDrivenCreation(std::chrono::micr
 
 ExpirationHandler::Checker LifetimeHelpers::expireNever()
 {
-  return [](int64_t) -> bool { return false; };
+  return [](int64_t, uint64_t& nextCheck) -> bool {
+    nextCheck = ExpirationHandler::NEVER;
+    return false;
+  };
 }
 
 ExpirationHandler::Checker LifetimeHelpers::expireAlways()
 {
-  return [](int64_t) -> bool { return true; };
+  return [](int64_t, uint64_t&) -> bool { return true; };
 }
 
 ExpirationHandler::Checker LifetimeHelpers::expireTimed(std::chrono::microseconds period)
 {
   auto start = getCurrentTime();
   auto last = std::make_shared<decltype(start)>(start);
-  return [last, period](int64_t) -> bool {
+  return [last, period](int64_t, uint64_t& nextCheck) -> bool {
     auto current = getCurrentTime();
     auto delta = current - *last;
     if (delta > period.count()) {
       *last = current;
       return true;
     }
+    nextCheck = *last + period.count() + 1;
     return false;
   };
 }
@@ -11,6 +11,7 @@
 
 #include "Framework/Output.h"
 #include "Framework/MessageContext.h"
+#include "Framework/MessageSet.h"
 #include "fairmq/FairMQDevice.h"
 
 namespace o2
@@ -45,5 +46,20 @@ o2::header::DataHeader* MessageContext::findMessageHeader(const Output& spec)
   return nullptr;
 }
 
+FairMQMessage const* MessageContext::findInputPayload(const char* payload) const
+{
+  if (mInputs == nullptr || payload == nullptr) {
+    return nullptr;
+  }
+  for (auto& input : *mInputs) {
+    for (auto& part : input) {
+      if (part.payload && static_cast<const char*>(part.payload->GetData()) == payload) {
+        return part.payload.get();
+      }
+    }
+  }
+  return nullptr;
+}
+
 } // namespace framework
 } // namespace o2
@@ -0,0 +1,89 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/ProcessingWorkers.h"
+#include "Framework/ProcessingSlot.h"
+
+namespace o2::framework
+{
+
+ProcessingWorkers::ProcessingWorkers(int nSlots)
+  : mNSlots{nSlots > 1 ? nSlots : 1},
+    mErrors(mNSlots)
+{
+  for (int slot = 1; slot < mNSlots; ++slot) {
+    mThreads.emplace_back([this, slot]() { loop(slot); });
+  }
+}
+
+ProcessingWorkers::~ProcessingWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mWorkReady.notify_all();
+  for (auto& thread : mThreads) {
+    thread.join();
+  }
+}
+
+void ProcessingWorkers::run(std::function<void()> const& job)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mJob = &job;
+    mErrors.assign(mNSlots, nullptr);
+    mPending = mNSlots - 1;
+    mGeneration++;
+  }
+  mWorkReady.notify_all();
+  execute(0);
+  std::unique_lock<std::mutex> lock(mMutex);
+  mWorkDone.wait(lock, [this]() { return mPending == 0; });
+  mJob = nullptr;
+  for (auto& error : mErrors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+void ProcessingWorkers::execute(int slot)
+{
+  ProcessingSlot::current() = slot;
+  try {
+    (*mJob)();
+  } catch (...) {
+    mErrors[slot] = std::current_exception();
+  }
+  ProcessingSlot::current() = -1;
+}
+
+void ProcessingWorkers::loop(int slot)
+{
+  uint64_t done = 0;
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    mWorkReady.wait(lock, [this, done]() { return mStop || mGeneration != done; });
+    if (mStop) {
+      return;
+    }
+    done = mGeneration;
+    lock.unlock();
+    execute(slot);
+    lock.lock();
+    if (--mPending == 0) {
+      mWorkDone.notify_one();
+    }
+  }
+}
+
+} // namespace o2::framework
@@ -75,6 +75,59 @@ void ServiceRegistry::declareService(ServiceSpec const& spec, DeviceState& state
   }
 }
 
+std::unique_ptr<ServiceRegistry> ServiceRegistry::createStreamRegistry(DeviceState& state, fair::mq::ProgOptions& options,
+                                                                       std::vector<std::string> const& perStream) const
+{
+  auto registry = std::make_unique<ServiceRegistry>(*this);
+  registry->mSpecs = mSpecs;
+  registry->mPreProcessingHandles = mPreProcessingHandles;
+  registry->mPostProcessingHandles = mPostProcessingHandles;
+  registry->mPreDanglingHandles = mPreDanglingHandles;
+  registry->mPostDanglingHandles = mPostDanglingHandles;
+  registry->mPreEOSHandles = mPreEOSHandles;
+  registry->mPostEOSHandles = mPostEOSHandles;
+  registry->mPostDispatchingHandles = mPostDispatchingHandles;
+  registry->mPreStartHandles = mPreStartHandles;
+  registry->mPreExitHandles = mPreExitHandles;
+
+  // The same instance might be registered for more than one thread and be
+  // bound to more than one callback, so we replace it everywhere.
+  auto replaceHandles = [](auto& handles, void* oldService, void* newService) {
+    for (auto& handle : handles) {
+      if (handle.service == oldService) {
+        handle.service = newService;
+      }
+    }
+  };
+
+  for (auto& spec : mSpecs) {
+    if (std::find(perStream.begin(), perStream.end(), spec.name) == perStream.end()) {
+      continue;
+    }
+    ServiceHandle handle = spec.init(*registry, state, options);
+    auto pos = registry->getPos(handle.hash, 0);
+    if (pos == -1) {
+      throwError(runtime_error_f("Service %s was not instanciated in the main registry", spec.name.c_str()));
+    }
+    void* oldService = registry->mServicesValue[pos];
+    for (auto& value : registry->mServicesValue) {
+      if (value == oldService) {
+        value = handle.instance;
+      }
+    }
+    replaceHandles(registry->mPreProcessingHandles, oldService, handle.instance);
+    replaceHandles(registry->mPostProcessingHandles, oldService, handle.instance);
+    replaceHandles(registry->mPreDanglingHandles, oldService, handle.instance);
+    replaceHandles(registry->mPostDanglingHandles, oldService, handle.instance);
+    replaceHandles(registry->mPreEOSHandles, oldService, handle.instance);
+    replaceHandles(registry->mPostEOSHandles, oldService, handle.instance);
+    replaceHandles(registry->mPostDispatchingHandles, oldService, handle.instance);
+    replaceHandles(registry->mPreStartHandles, oldService, handle.instance);
+    replaceHandles(registry->mPreExitHandles, oldService, handle.instance);
+  }
+  return registry;
+}
+
 void ServiceRegistry::bindService(ServiceSpec const& spec, void* service)
 {
   static TracyLockableN(std::mutex, bindMutex, "bind mutex");
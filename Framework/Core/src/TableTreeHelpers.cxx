@@ -10,10 +10,16 @@
 // or submit itself to any jurisdiction.
 #include "Framework/TableTreeHelpers.h"
 #include <stdexcept>
+#include <algorithm>
+#include <cstring>
 #include "Framework/Logger.h"
 
 #include "arrow/type_traits.h"
 
+#include <TBufferFile.h>
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+
 namespace o2::framework
 {
 
@@ -104,6 +110,38 @@ class ColumnIterator
   // with this mArray is prepared to be used in arrow::Table::Make
   void finish();
 };
+
+// -----------------------------------------------------------------------------
+// BranchToColumn reads a complete branch basket by basket with the ROOT bulk
+// IO and copies the values into a preallocated arrow buffer. It is used by
+// TreeToTable for all the branches which support bulk reading, i.e. single
+// values or fixed size arrays of a fundamental type. The other branches
+// are read entry by entry with a ColumnIterator.
+// .............................................................................
+class BranchToColumn
+{
+
+ private:
+  TBranch* mBranch = nullptr;
+  EDataType mElementType;
+  int64_t mNumberElements = 1;
+  std::shared_ptr<arrow::DataType> mElementArrowType;
+
+  std::shared_ptr<arrow::Field> mField;
+  std::shared_ptr<arrow::Array> mArray;
+
+ public:
+  BranchToColumn(TBranch* branch);
+
+  // can @a branch be read in bulk
+  static bool supports(TBranch* branch);
+
+  // read the first numEntries entries of the branch
+  bool read(int64_t numEntries);
+
+  std::shared_ptr<arrow::Array> getArray() { return mArray; }
+  std::shared_ptr<arrow::Field> getSchema() { return mField; }
+};
 } // namespace
 
 // is used in TableToTree
@@ -837,6 +875,134 @@ void ColumnIterator::finish()
   }
 }
 
+namespace
+{
+// arrow type and size of the ROOT fundamental types handled by BranchToColumn
+std::pair<std::shared_ptr<arrow::DataType>, int> arrowTypeFor(EDataType type)
+{
+  switch (type) {
+    case EDataType::kBool_t:
+      return {arrow::boolean(), sizeof(bool)};
+    case EDataType::kUChar_t:
+      return {arrow::uint8(), sizeof(uint8_t)};
+    case EDataType::kUShort_t:
+      return {arrow::uint16(), sizeof(uint16_t)};
+    case EDataType::kUInt_t:
+      return {arrow::uint32(), sizeof(uint32_t)};
+    case EDataType::kULong64_t:
+      return {arrow::uint64(), sizeof(uint64_t)};
+    case EDataType::kChar_t:
+      return {arrow::int8(), sizeof(int8_t)};
+    case EDataType::kShort_t:
+      return {arrow::int16(), sizeof(int16_t)};
+    case EDataType::kInt_t:
+      return {arrow::int32(), sizeof(int32_t)};
+    case EDataType::kLong64_t:
+      return {arrow::int64(), sizeof(int64_t)};
+    case EDataType::kFloat_t:
+      return {arrow::float32(), sizeof(float)};
+    case EDataType::kDouble_t:
+      return {arrow::float64(), sizeof(double)};
+    default:
+      return {nullptr, 0};
+  }
+}
+} // namespace
+
+BranchToColumn::BranchToColumn(TBranch* branch)
+  : mBranch{branch}
+{
+  TClass* cl;
+  mBranch->GetExpectedType(cl, mElementType);
+  mElementArrowType = arrowTypeFor(mElementType).first;
+
+  std::string branchTitle = mBranch->GetTitle();
+  Int_t pos0 = branchTitle.find("[");
+  Int_t pos1 = branchTitle.find("]");
+  if (pos0 > 0 && pos1 > 0) {
+    mNumberElements = atoi(branchTitle.substr(pos0 + 1, pos1 - pos0 - 1).c_str());
+  }
+
+  if (mNumberElements == 1) {
+    mField = std::make_shared<arrow::Field>(mBranch->GetName(), mElementArrowType);
+  } else {
+    mField = std::make_shared<arrow::Field>(mBranch->GetName(), arrow::fixed_size_list(mElementArrowType, mNumberElements));
+  }
+}
+
+bool BranchToColumn::supports(TBranch* branch)
+{
+  if (branch == nullptr || !branch->SupportsBulkRead()) {
+    return false;
+  }
+  TClass* cl;
+  EDataType type;
+  branch->GetExpectedType(cl, type);
+  return arrowTypeFor(type).first != nullptr;
+}
+
+bool BranchToColumn::read(int64_t numEntries)
+{
+  auto nValues = numEntries * mNumberElements;
+  auto typeSize = arrowTypeFor(mElementType).second;
+  auto pool = arrow::default_memory_pool();
+
+  // the bulk IO returns all the entries of one basket at the time,
+  // already deserialized to the native byte order
+  TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
+  std::shared_ptr<arrow::Array> values;
+
+  if (mElementType == EDataType::kBool_t) {
+    // arrow packs booleans in bits, they need to go through the builder
+    arrow::BooleanBuilder builder(pool);
+    if (!builder.Reserve(nValues).ok()) {
+      return false;
+    }
+    int64_t readEntries = 0;
+    while (readEntries < numEntries) {
+      auto readLast = mBranch->GetBulkRead().GetBulkEntries(readEntries, buffer);
+      if (readLast <= 0) {
+        return false;
+      }
+      readLast = std::min<int64_t>(readLast, numEntries - readEntries);
+      if (!builder.AppendValues(reinterpret_cast<uint8_t const*>(buffer.GetCurrent()), readLast * mNumberElements).ok()) {
+        return false;
+      }
+      readEntries += readLast;
+    }
+    if (!builder.Finish(&values).ok()) {
+      return false;
+    }
+  } else {
+    auto result = arrow::AllocateBuffer(nValues * typeSize, pool);
+    if (!result.ok()) {
+      return false;
+    }
+    std::shared_ptr<arrow::Buffer> data = std::move(result).ValueOrDie();
+    auto p = data->mutable_data();
+    int64_t readEntries = 0;
+    while (readEntries < numEntries) {
+      auto readLast = mBranch->GetBulkRead().GetBulkEntries(readEntries, buffer);
+      if (readLast <= 0) {
+        return false;
+      }
+      readLast = std::min<int64_t>(readLast, numEntries - readEntries);
+      auto size = readLast * mNumberElements * typeSize;
+      std::memcpy(p, buffer.GetCurrent(), size);
+      p += size;
+      readEntries += readLast;
+    }
+    values = arrow::MakeArray(arrow::ArrayData::Make(mElementArrowType, nValues, {nullptr, data}, 0));
+  }
+
+  if (mNumberElements == 1) {
+    mArray = values;
+  } else {
+    mArray = std::make_shared<arrow::FixedSizeListArray>(mField->type(), numEntries, values);
+  }
+  return true;
+}
+
 void TreeToTable::addColumn(const char* colname)
 {
   mColumnNames.push_back(colname);
@@ -862,22 +1028,52 @@ bool TreeToTable::addAllColumns(TTree* tree)
 void TreeToTable::fill(TTree* tree)
 {
   std::vector<std::unique_ptr<ColumnIterator>> columnIterators;
+  std::vector<std::unique_ptr<BranchToColumn>> bulkColumns;
+  // position of each column in the output table, within
+  // columnIterators (>= 0) or bulkColumns (< 0, as -1 - index)
+  std::vector<int> positions;
   TTreeReader treeReader{tree};
 
   tree->SetCacheSize(50000000);
   tree->SetClusterPrefetch(true);
   for (auto&& columnName : mColumnNames) {
     tree->AddBranchToCache(columnName.c_str(), true);
+    auto branch = tree->GetBranch(columnName.c_str());
+    if (BranchToColumn::supports(branch)) {
+      positions.push_back(-1 - (int)bulkColumns.size());
+      bulkColumns.push_back(std::make_unique<BranchToColumn>(branch));
+      continue;
+    }
     auto colit = std::make_unique<ColumnIterator>(treeReader, columnName.c_str());
     auto stat = colit->getStatus();
     if (!stat) {
       throw std::runtime_error("Unable to convert column " + columnName);
     }
+    positions.push_back(columnIterators.size());
     columnIterators.push_back(std::move(colit));
   }
   tree->StopCacheLearningPhase();
-  auto numEntries = treeReader.GetEntries(true);
-  if (numEntries > 0) {
+  auto numEntries = tree->GetEntries();
+
+  // read the bulk capable columns in one go, one column per task when
+  // ROOT implicit multi-threading is enabled
+  std::vector<char> bulkStatus(bulkColumns.size(), true);
+  auto readBulk = [&](unsigned int i) { bulkStatus[i] = bulkColumns[i]->read(numEntries); };
+  if (ROOT::IsImplicitMTEnabled() && bulkColumns.size() > 1) {
+    ROOT::TThreadExecutor pool;
+    pool.Foreach(readBulk, ROOT::TSeqU(bulkColumns.size()));
+  } else {
+    for (auto i = 0u; i < bulkColumns.size(); ++i) {
+      readBulk(i);
+    }
+  }
+  for (auto i = 0u; i < bulkColumns.size(); ++i) {
+    if (!bulkStatus[i]) {
+      throw std::runtime_error(std::string("Unable to convert column ") + bulkColumns[i]->getSchema()->name());
+    }
+  }
+
+  if (!columnIterators.empty() && numEntries > 0) {
     for (auto&& column : columnIterators) {
       column->reserve(numEntries);
     }
@@ -895,8 +1091,15 @@ void TreeToTable::fill(TTree* tree)
   std::vector<std::shared_ptr<arrow::Field>> schema_vector;
   for (auto&& colit : columnIterators) {
     colit->finish();
-    array_vector.push_back(colit->getArray());
-    schema_vector.push_back(colit->getSchema());
+  }
+  for (auto position : positions) {
+    if (position >= 0) {
+      array_vector.push_back(columnIterators[position]->getArray());
+      schema_vector.push_back(columnIterators[position]->getSchema());
+    } else {
+      array_vector.push_back(bulkColumns[-1 - position]->getArray());
+      schema_vector.push_back(bulkColumns[-1 - position]->getSchema());
+    }
   }
   auto fields = std::make_shared<arrow::Schema>(schema_vector);
 
@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 #include "WorkflowHelpers.h"
 #include "Framework/AlgorithmSpec.h"
+#include "Framework/AnalysisHelpers.h"
 #include "Framework/AODReaderHelpers.h"
 #include "Framework/ChannelMatching.h"
 #include "Framework/ConfigParamsHelper.h"
@@ -29,7 +30,10 @@
 #include "Headers/DataHeader.h"
 #include <algorithm>
 #include <list>
+#include <map>
+#include <optional>
 #include <set>
+#include <tuple>
 #include <utility>
 #include <vector>
 #include <climits>
@@ -50,6 +54,116 @@ enum OutputType : char {
   ANALYSIS = 2,
 };
 
+namespace
+{
+/// Lookup table from the data type of a spec to the positions of the specs
+/// which can possibly match it, so that matching inputs and outputs does not
+/// need to go through all of them. Specs with a fixed subSpec are indexed by
+/// (origin, description, subSpec), the ones with only a fixed data type by
+/// (origin, description), while anything more generic is always a candidate.
+/// Positions are kept sorted, so that the candidates are visited in the same
+/// order in which they were added.
+class DataTypeIndex
+{
+ public:
+  using SubSpec = header::DataHeader::SubSpecificationType;
+
+  static std::pair<std::optional<ConcreteDataTypeMatcher>, std::optional<SubSpec>> keyFor(OutputSpec const& spec)
+  {
+    return {DataSpecUtils::asConcreteDataTypeMatcher(spec), DataSpecUtils::getOptionalSubSpec(spec)};
+  }
+
+  static std::pair<std::optional<ConcreteDataTypeMatcher>, std::optional<SubSpec>> keyFor(InputSpec const& spec)
+  {
+    auto type = DataSpecUtils::optionalConcreteDataTypeMatcher(spec);
+    if (!type) {
+      return {};
+    }
+    return {type, DataSpecUtils::getOptionalSubSpec(spec)};
+  }
+
+  /// @return the position of the newly added spec.
+  template <typename T>
+  size_t add(T const& spec)
+  {
+    auto pos = mKeys.size();
+    mKeys.push_back(keyFor(spec));
+    visitBuckets(pos, [pos](std::set<size_t>& bucket) { bucket.insert(pos); });
+    return pos;
+  }
+
+  /// Removes the spec at @a pos from the candidates, its position is not reused.
+  void remove(size_t pos)
+  {
+    visitBuckets(pos, [pos](std::set<size_t>& bucket) { bucket.erase(pos); });
+  }
+
+  /// @return the first position, in order of insertion, among the candidates
+  /// for @a spec which satisfies @a pred.
+  template <typename T, typename P>
+  std::optional<size_t> findFirst(T const& spec, P&& pred) const
+  {
+    auto [type, subSpec] = keyFor(spec);
+    std::optional<size_t> result;
+    auto firstIn = [&result, &pred](std::set<size_t> const& bucket) {
+      for (auto pos : bucket) {
+        if (result && pos >= *result) {
+          return;
+        }
+        if (pred(pos)) {
+          result = pos;
+          return;
+        }
+      }
+    };
+    if (!type) {
+      firstIn(mAll);
+      return result;
+    }
+    auto dataType = std::make_pair(type->origin, type->description);
+    firstIn(mGeneric);
+    if (!subSpec) {
+      if (auto bucket = mByType.find(dataType); bucket != mByType.end()) {
+        firstIn(bucket->second);
+      }
+      return result;
+    }
+    if (auto bucket = mBySubSpec.find(std::make_tuple(type->origin, type->description, *subSpec)); bucket != mBySubSpec.end()) {
+      firstIn(bucket->second);
+    }
+    if (auto bucket = mTypeOnly.find(dataType); bucket != mTypeOnly.end()) {
+      firstIn(bucket->second);
+    }
+    return result;
+  }
+
+ private:
+  template <typename F>
+  void visitBuckets(size_t pos, F&& f)
+  {
+    auto& [type, subSpec] = mKeys[pos];
+    f(mAll);
+    if (!type) {
+      f(mGeneric);
+      return;
+    }
+    f(mByType[std::make_pair(type->origin, type->description)]);
+    if (subSpec) {
+      f(mBySubSpec[std::make_tuple(type->origin, type->description, *subSpec)]);
+    } else {
+      f(mTypeOnly[std::make_pair(type->origin, type->description)]);
+    }
+  }
+
+  std::vector<std::pair<std::optional<ConcreteDataTypeMatcher>, std::optional<SubSpec>>> mKeys;
+  std::set<size_t> mAll;
+  std::set<size_t> mGeneric;
+  std::map<std::pair<header::DataOrigin, header::DataDescription>, std::set<size_t>> mByType;
+  std::map<std::pair<header::DataOrigin, header::DataDescription>, std::set<size_t>> mTypeOnly;
+  std::map<std::tuple<header::DataOrigin, header::DataDescription, SubSpec>, std::set<size_t>> mBySubSpec;
+};
+} // namespace
+
 std::vector<TopoIndexInfo>
   WorkflowHelpers::topologicalSort(size_t nodeCount,
                                    int const* edgeIn,
@@ -207,8 +321,129 @@ void addMissingOutputsToBuilder(std::vector<InputSpec>&& requestedIDXs,
   }
 }
 
+void WorkflowHelpers::shareSpawnedTables(WorkflowSpec& workflow)
+{
+  // Labels are created by Spawns<T>::label() as <prefix><description>:<hash>
+  std::string_view prefix = spawnsLabelPrefix;
+  struct SpawnedTable {
+    std::string description;
+    std::string hash;
+    std::vector<size_t> spawners;
+  };
+  std::vector<SpawnedTable> spawned;
+
+  for (size_t wi = 0; wi < workflow.size(); ++wi) {
+    auto& processor = workflow[wi];
+    for (auto& label : processor.labels) {
+      if (label.value.compare(0, prefix.size(), prefix) != 0) {
+        continue;
+      }
+      auto separator = label.value.rfind(':');
+      auto description = label.value.substr(prefix.size(), separator - prefix.size());
+      auto hash = label.value.substr(separator + 1);
+      auto it = std::find_if(spawned.begin(), spawned.end(), [&description](SpawnedTable const& table) { return table.description == description; });
+      if (it == spawned.end()) {
+        spawned.push_back({description, hash, {wi}});
+        continue;
+      }
+      if (it->hash != hash) {
+        throw runtime_error_f("Extended table %s is spawned with different definitions by %s and %s",
+                              description.c_str(), workflow[it->spawners.front()].name.c_str(), processor.name.c_str());
+      }
+      it->spawners.push_back(wi);
+    }
+  }
+  if (std::none_of(spawned.begin(), spawned.end(), [](SpawnedTable const& table) { return table.spawners.size() > 1; })) {
+    return;
+  }
+
+  // The processors spawning a table might depend on each other, e.g. one of
+  // them consumes the output of another one. The table is therefore kept by
+  // the spawner which comes first in a topological order of the workflow, so
+  // that all the edges we add go forward and cannot create a cycle. The
+  // spawned tables themselves are not part of the dependencies.
+  auto isSpawned = [&spawned](size_t wi, OutputSpec const& output) {
+    return std::any_of(spawned.begin(), spawned.end(), [wi, &output](SpawnedTable const& table) {
+      header::DataDescription dataDescription;
+      dataDescription.runtimeInit(table.description.c_str());
+      return std::find(table.spawners.begin(), table.spawners.end(), wi) != table.spawners.end() &&
+             DataSpecUtils::partialMatch(output, dataDescription);
+    });
+  };
+  std::vector<std::vector<size_t>> consumers(workflow.size());
+  std::vector<size_t> pending(workflow.size(), 0);
+  for (size_t pi = 0; pi < workflow.size(); ++pi) {
+    for (size_t ci = 0; ci < workflow.size(); ++ci) {
+      if (pi == ci) {
+        continue;
+      }
+      bool consumes = false;
+      for (size_t oi = 0; oi < workflow[pi].outputs.size() && consumes == false; ++oi) {
+        if (isSpawned(pi, workflow[pi].outputs[oi])) {
+          continue;
+        }
+        consumes = std::any_of(workflow[ci].inputs.begin(), workflow[ci].inputs.end(), [&output = workflow[pi].outputs[oi]](InputSpec const& input) {
+          return DataSpecUtils::match(input, output);
+        });
+      }
+      if (consumes) {
+        consumers[pi].push_back(ci);
+        pending[ci]++;
+      }
+    }
+  }
+  std::vector<size_t> rank(workflow.size(), workflow.size());
+  std::set<size_t> ready;
+  for (size_t wi = 0; wi < workflow.size(); ++wi) {
+    if (pending[wi] == 0) {
+      ready.insert(wi);
+    }
+  }
+  size_t nextRank = 0;
+  while (ready.empty() == false) {
+    auto wi = *ready.begin();
+    ready.erase(ready.begin());
+    rank[wi] = nextRank++;
+    for (auto ci : consumers[wi]) {
+      if (--pending[ci] == 0) {
+        ready.insert(ci);
+      }
+    }
+  }
+
+  for (auto& table : spawned) {
+    if (table.spawners.size() < 2) {
+      continue;
+    }
+    auto producer = *std::min_element(table.spawners.begin(), table.spawners.end(), [&rank](size_t a, size_t b) {
+      return std::make_pair(rank[a], a) < std::make_pair(rank[b], b);
+    });
+    header::DataDescription dataDescription;
+    dataDescription.runtimeInit(table.description.c_str());
+    for (auto wi : table.spawners) {
+      if (wi == producer) {
+        continue;
+      }
+      auto& processor = workflow[wi];
+      auto output = std::find_if(processor.outputs.begin(), processor.outputs.end(), [&dataDescription](OutputSpec const& spec) {
+        return DataSpecUtils::partialMatch(spec, dataDescription);
+      });
+      if (output == processor.outputs.end()) {
+        continue;
+      }
+      auto input = DataSpecUtils::matchingInput(*output);
+      if (std::none_of(processor.inputs.begin(), processor.inputs.end(), [&input](InputSpec const& spec) { return spec.binding == input.binding; })) {
+        processor.inputs.push_back(input);
+      }
+      processor.outputs.erase(output);
+    }
+  }
+}
+
 void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext const& ctx)
 {
+  shareSpawnedTables(workflow);
+
   auto fakeCallback = AlgorithmSpec{[](InitContext& ic) {
     LOG(INFO) << "This is not a real device, merely a placeholder for external inputs";
     LOG(INFO) << "To be hidden / removed at some point.";
@@ -263,6 +498,8 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
     {ConfigParamSpec{"aod-file", VariantType::String, {"Input AOD file"}},
      ConfigParamSpec{"aod-reader-json", VariantType::String, {"json configuration file"}},
      ConfigParamSpec{"time-limit", VariantType::Int64, 0ll, {"Maximum run time limit in seconds"}},
+     ConfigParamSpec{"aod-read-ahead", VariantType::Int, 0, {"Number of time frames read ahead in a separate thread (0: disabled)"}},
+     ConfigParamSpec{"aod-reader-threads", VariantType::Int, 0, {"Number of threads to decompress and convert the columns of a table (0: disabled)"}},
      ConfigParamSpec{"orbit-offset-enumeration", VariantType::Int64, 0ll, {"initial value for the orbit"}},
      ConfigParamSpec{"orbit-multiplier-enumeration", VariantType::Int64, 0ll, {"multiplier to get the orbit from the counter"}},
      ConfigParamSpec{"start-value-enumeration", VariantType::Int64, 0ll, {"initial value for the enumeration"}},
@@ -349,8 +586,6 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
       }
     }
 
-    std::stable_sort(timer.outputs.begin(), timer.outputs.end(), [](OutputSpec const& a, OutputSpec const& b) { return *DataSpecUtils::getOptionalSubSpec(a) < *DataSpecUtils::getOptionalSubSpec(b); });
-
     for (size_t oi = 0; oi < processor.outputs.size(); ++oi) {
       auto& output = processor.outputs[oi];
       if (DataSpecUtils::partialMatch(output, header::DataOrigin{"AOD"})) {
@@ -371,6 +606,10 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
       }
     }
   }
+  // Sorting once all the timers are known gives the same result as keeping
+  // them sorted while they are added, since the sort is stable.
+  std::stable_sort(timer.outputs.begin(), timer.outputs.end(), [](OutputSpec const& a, OutputSpec const& b) { return *DataSpecUtils::getOptionalSubSpec(a) < *DataSpecUtils::getOptionalSubSpec(b); });
+
   auto sortingEquals = [](InputSpec const& a, InputSpec const& b) { return DataSpecUtils::describe(a) == DataSpecUtils::describe(b); };
   std::sort(requestedDYNs.begin(), requestedDYNs.end(), sortingEquals);
   auto last = std::unique(requestedDYNs.begin(), requestedDYNs.end());
@@ -502,13 +741,14 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
 
   // Select dangling outputs which are not of type AOD
   std::vector<InputSpec> redirectedOutputsInputs;
+  auto forwardingPolicy = ctx.options().get<std::string>("forwarding-policy");
   for (auto ii = 0u; ii < outputsInputs.size(); ii++) {
-    if (ctx.options().get<std::string>("forwarding-policy") == "none") {
+    if (forwardingPolicy == "none") {
       continue;
     }
     // We forward to the output proxy all the inputs only if they are dangling
     // or if the forwarding policy is "proxy".
-    if (!(outputTypes[ii] & DANGLING) && (ctx.options().get<std::string>("forwarding-policy") != "all")) {
+    if (!(outputTypes[ii] & DANGLING) && (forwardingPolicy != "all")) {
       continue;
     }
     // AODs are skipped in any case.
@@ -548,24 +788,32 @@ void WorkflowHelpers::constructGraph(const WorkflowSpec& workflow,
 {
   assert(!workflow.empty());
 
-  // This is the state. Oif is the iterator I use for the searches.
-  std::list<LogicalOutputInfo> availableOutputsInfo;
+  // This is the state. Oif is the position of the last match. The outputs
+  // are kept in the order in which they become available, while the index
+  // restricts the search to the ones which can match a given input.
+  std::vector<LogicalOutputInfo> availableOutputsInfo;
+  DataTypeIndex availableOutputsIndex;
   auto const& constOutputs = outputs; // const version of the outputs
-  decltype(availableOutputsInfo.begin()) oif;
+  size_t oif = 0;
   // Forwards is a local cache to avoid adding forwards before time.
   std::vector<LogicalOutputInfo> forwards;
 
-  // Notice that availableOutputsInfo MUST be updated first, since it relies on
-  // the size of outputs to be the one before the update.
-  auto enumerateAvailableOutputs = [&workflow, &outputs, &availableOutputsInfo]() {
+  auto addAvailableOutput = [&availableOutputsInfo, &availableOutputsIndex, &constOutputs](LogicalOutputInfo const& info) {
+    availableOutputsIndex.add(constOutputs[info.outputGlobalIndex]);
+    availableOutputsInfo.push_back(info);
+  };
+
+  // Notice that the uniqueOutputId MUST be taken before outputs is updated,
+  // while the index needs the output to be there.
+  auto enumerateAvailableOutputs = [&workflow, &outputs, &addAvailableOutput]() {
     for (size_t wi = 0; wi < workflow.size(); ++wi) {
       auto& producer = workflow[wi];
 
       for (size_t oi = 0; oi < producer.outputs.size(); ++oi) {
         auto& out = producer.outputs[oi];
         auto uniqueOutputId = outputs.size();
-        availableOutputsInfo.emplace_back(LogicalOutputInfo{wi, uniqueOutputId, false});
         outputs.push_back(out);
+        addAvailableOutput(LogicalOutputInfo{wi, uniqueOutputId, false});
       }
     }
   };
@@ -574,40 +822,30 @@ void WorkflowHelpers::constructGraph(const WorkflowSpec& workflow,
   // information so that when we add it at device level we know which output
   // channel we need to connect it too.
   auto hasMatchingOutputFor = [&workflow, &constOutputs,
-                               &availableOutputsInfo, &oif,
+                               &availableOutputsInfo, &availableOutputsIndex, &oif,
                                &forwardedInputsInfo](size_t ci, size_t ii) {
     assert(ci < workflow.size());
     assert(ii < workflow[ci].inputs.size());
     auto& input = workflow[ci].inputs[ii];
-    auto matcher = [&input, &constOutputs](const LogicalOutputInfo& outputInfo) -> bool {
-      auto& output = constOutputs[outputInfo.outputGlobalIndex];
+    auto matcher = [&input, &constOutputs, &availableOutputsInfo](size_t pos) -> bool {
+      auto& output = constOutputs[availableOutputsInfo[pos].outputGlobalIndex];
       return DataSpecUtils::match(input, output);
     };
-    oif = std::find_if(availableOutputsInfo.begin(),
-                       availableOutputsInfo.end(),
-                       matcher);
-    if (oif != availableOutputsInfo.end() && oif->forward) {
-      LogicalForwardInfo forward;
-      forward.consumer = ci;
-      forward.inputLocalIndex = ii;
-      forward.outputGlobalIndex = oif->outputGlobalIndex;
-      forwardedInputsInfo.emplace_back(LogicalForwardInfo{ci, ii, oif->outputGlobalIndex});
+    auto found = availableOutputsIndex.findFirst(input, matcher);
+    if (!found) {
+      return false;
+    }
+    oif = *found;
+    if (availableOutputsInfo[oif].forward) {
+      forwardedInputsInfo.emplace_back(LogicalForwardInfo{ci, ii, availableOutputsInfo[oif].outputGlobalIndex});
     }
-    return oif != availableOutputsInfo.end();
+    return true;
   };
 
-  // We have consumed the input, therefore we remove it from the list.
+  // We have consumed the input, therefore we remove it from the candidates.
   // We will insert the forwarded inputs only at the end of the iteration.
-  auto findNextOutputFor = [&availableOutputsInfo, &constOutputs, &oif, &workflow](
-                             size_t ci, size_t& ii) {
-    auto& input = workflow[ci].inputs[ii];
-    auto matcher = [&input, &constOutputs](const LogicalOutputInfo& outputInfo) -> bool {
-      auto& output = constOutputs[outputInfo.outputGlobalIndex];
-      return DataSpecUtils::match(input, output);
-    };
-    oif = availableOutputsInfo.erase(oif);
-    oif = std::find_if(oif, availableOutputsInfo.end(), matcher);
-    return oif;
+  auto consumeOutput = [&availableOutputsIndex, &oif]() {
+    availableOutputsIndex.remove(oif);
   };
 
   auto numberOfInputsFor = [&workflow](size_t ci) {
@@ -621,17 +859,17 @@ void WorkflowHelpers::constructGraph(const WorkflowSpec& workflow,
   };
 
   // Trivial, but they make reading easier..
-  auto getOutputAssociatedProducer = [&oif]() {
-    return oif->specIndex;
+  auto getOutputAssociatedProducer = [&availableOutputsInfo, &oif]() {
+    return availableOutputsInfo[oif].specIndex;
   };
 
   // Trivial, but they make reading easier..
-  auto getAssociateOutput = [&oif]() {
-    return oif->outputGlobalIndex;
+  auto getAssociateOutput = [&availableOutputsInfo, &oif]() {
+    return availableOutputsInfo[oif].outputGlobalIndex;
   };
 
-  auto isForward = [&oif]() {
-    return oif->forward;
+  auto isForward = [&availableOutputsInfo, &oif]() {
+    return availableOutputsInfo[oif].forward;
   };
 
   // Trivial but makes reasing easier in the outer loop.
@@ -669,9 +907,9 @@ void WorkflowHelpers::constructGraph(const WorkflowSpec& workflow,
   // the the global list of outputs, so that they can be matched
   // and we need to add a ForwardRoute for the current consumer
   // because it is the one who will actually do the forwarding.
-  auto appendForwardsToPossibleOutputs = [&availableOutputsInfo, &forwards]() {
+  auto appendForwardsToPossibleOutputs = [&addAvailableOutput, &forwards]() {
     for (auto& forward : forwards) {
-      availableOutputsInfo.push_back(forward);
+      addAvailableOutput(forward);
     }
   };
 
@@ -716,7 +954,7 @@ void WorkflowHelpers::constructGraph(const WorkflowSpec& workflow,
           }
           forwardOutputFrom(consumer, uniqueOutputId);
         }
-        findNextOutputFor(consumer, input);
+        consumeOutput();
       }
       if (noMatchingOutputFound()) {
         errorDueToMissingOutputFor(consumer, input);
@@ -895,6 +1133,12 @@ std::shared_ptr<DataOutputDirector> WorkflowHelpers::getDataOutputDirector(Confi
       ntfmerge = ntfm;
     }
   }
+  if (options.isSet("aod-writer-format")) {
+    auto format = options.get<std::string>("aod-writer-format");
+    if (!format.empty()) {
+      dod->setOutputFormat(format);
+    }
+  }
   // parse the keepString
   if (options.isSet("aod-writer-keep")) {
     auto keepString = options.get<std::string>("aod-writer-keep");
@@ -948,16 +1192,19 @@ std::tuple<std::vector<InputSpec>, std::vector<unsigned char>> WorkflowHelpers::
   outputTypes.reserve(totalOutputs);
 
   /// Prepare an index to do the iterations quickly.
+  DataTypeIndex inputsIndex;
   for (size_t wi = 0, we = workflow.size(); wi != we; ++wi) {
     auto& spec = workflow[wi];
     for (size_t ii = 0, ie = spec.inputs.size(); ii != ie; ++ii) {
       inputs.emplace_back(DataMatcherId{wi, ii});
+      inputsIndex.add(spec.inputs[ii]);
     }
     for (size_t oi = 0, oe = spec.outputs.size(); oi != oe; ++oi) {
       outputs.emplace_back(DataMatcherId{wi, oi});
     }
   }
 
+  DataTypeIndex resultsIndex;
   for (size_t oi = 0, oe = outputs.size(); oi != oe; ++oi) {
     auto& output = outputs[oi];
     auto& outputSpec = workflow[output.workflowId].outputs[output.id];
@@ -975,19 +1222,15 @@ std::tuple<std::vector<InputSpec>, std::vector<unsigned char>> WorkflowHelpers::
     }
 
     // is dangling output?
-    bool matched = false;
-    for (size_t ii = 0, ie = inputs.size(); ii != ie; ++ii) {
+    auto matched = inputsIndex.findFirst(outputSpec, [&workflow, &inputs, &output, &outputSpec](size_t ii) {
       auto& input = inputs[ii];
       // Inputs of the same workflow cannot match outputs
       if (output.workflowId == input.workflowId) {
-        continue;
+        return false;
       }
       auto& inputSpec = workflow[input.workflowId].inputs[input.id];
-      if (DataSpecUtils::match(inputSpec, outputSpec)) {
-        matched = true;
-        break;
-      }
-    }
+      return DataSpecUtils::match(inputSpec, outputSpec);
+    });
     if (!matched) {
       outputType |= DANGLING;
     }
@@ -997,8 +1240,13 @@ std::tuple<std::vector<InputSpec>, std::vector<unsigned char>> WorkflowHelpers::
     char buf[64];
     input.binding = (snprintf(buf, 63, "output_%zu_%zu", output.workflowId, output.id), buf);
 
-    // make sure that entries are unique
-    if (std::find(results.begin(), results.end(), input) == results.end()) {
+    // make sure that entries are unique. Equal results come from outputs
+    // with the same matcher, so only those need to be compared.
+    auto previous = resultsIndex.findFirst(outputSpec, [&results, &input](size_t ri) {
+      return results[ri] == input;
+    });
+    if (!previous) {
+      resultsIndex.add(outputSpec);
       results.emplace_back(input);
       outputTypes.emplace_back(outputType);
     }
@@ -171,6 +171,14 @@ struct WorkflowHelpers {
   // it contains no empty labels.
   [[nodiscard]] static WorkflowParsingState verifyWorkflow(const WorkflowSpec& workflow);
 
+  // Make sure that extended tables spawned with the same definition by several
+  // data processors are computed only once: the processor advertising a
+  // given table which comes first in the data flow keeps its output, the
+  // others get it as an input instead.
+  // Throws if the same table is spawned with different definitions.
+  // @a workflow the workflow to modify
+  static void shareSpawnedTables(WorkflowSpec& workflow);
+
   // Depending on the workflow and the dangling inputs inside it, inject "fake"
   // devices to mark the fact we might need some extra action to make sure
   // dangling inputs are satisfied.
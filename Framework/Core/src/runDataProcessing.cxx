@@ -37,6 +37,8 @@
 #include "Framework/SimpleRawDeviceService.h"
 #define O2_SIGNPOST_DEFINE_CONTEXT
 #include "Framework/Signpost.h"
+#include "Framework/SignpostRecorder.h"
+#include "Framework/LatencyTraceHelpers.h"
 #include "Framework/ControlService.h"
 #include "Framework/CallbackService.h"
 #include "Framework/WorkflowSpec.h"
@@ -56,6 +58,7 @@
 #include "DataProcessingStatus.h"
 #include "DDSConfigHelpers.h"
 #include "O2ControlHelpers.h"
+#include "DeviceMetricsRing.h"
 #include "DeviceSpecHelpers.h"
 #include "GraphvizHelpers.h"
 #include "PropertyTreeHelpers.h"
@@ -95,6 +98,7 @@
 #include <set>
 #include <string>
 #include <type_traits>
+#include <unordered_set>
 #include <tuple>
 #include <chrono>
 #include <utility>
@@ -151,6 +155,8 @@ using DataProcessorSpecs = std::vector<DataProcessorSpec>;
 template class std::vector<DeviceSpec>;
 
 std::vector<DeviceMetricsInfo> gDeviceMetricsInfos;
+// Binary metrics coming from the device with the same index, if any.
+std::vector<std::unique_ptr<DeviceMetricsRing>> gDeviceMetricsRings;
 
 // FIXME: probably find a better place
 // these are the device options added by the framework, but they can be
@@ -420,6 +426,7 @@ void spawnRemoteDevice(std::string const& forwardedStdin,
   deviceInfos.emplace_back(info);
   // Let's add also metrics information for the given device
   gDeviceMetricsInfos.emplace_back(DeviceMetricsInfo{});
+  gDeviceMetricsRings.emplace_back(nullptr);
 }
 
 struct DeviceLogContext {
@@ -805,6 +812,9 @@ void spawnDevice(DeviceRef ref,
       service.preFork(serviceRegistry, varmap);
     }
   }
+  // Created before forking, so that the device finds it when it starts.
+  // If this fails, the device will simply send its metrics as text.
+  auto metricsRing = DeviceMetricsRing::create(DeviceMetricsRing::segmentName(getpid(), spec.id));
   // If we have a framework id, it means we have already been respawned
   // and that we are in a child. If not, we need to fork and re-exec, adding
   // the framework-id as one of the options.
@@ -901,6 +911,7 @@ void spawnDevice(DeviceRef ref,
   deviceInfos.emplace_back(info);
   // Let's add also metrics information for the given device
   gDeviceMetricsInfos.emplace_back(DeviceMetricsInfo{});
+  gDeviceMetricsRings.emplace_back(std::move(metricsRing));
 }
 
 struct LogProcessingState {
@@ -939,6 +950,22 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
     assert(specs.size() == infos.size());
     DeviceSpec const& spec = specs[di];
 
+    auto updateMetricsViews =
+      Metric2DViewIndex::getUpdater({&info.dataRelayerViewIndex,
+                                     &info.variablesViewIndex,
+                                     &info.queriesViewIndex});
+
+    auto newMetricCallback = [&updateMetricsViews, &driverInfo, &metricsInfos, &hasNewMetric](std::string const& name, MetricInfo const& metric, int value, size_t metricIndex) {
+      updateMetricsViews(name, metric, value, metricIndex);
+      hasNewMetric = true;
+    };
+
+    // Numeric metrics sent in binary form do not need to be parsed.
+    if (di < gDeviceMetricsRings.size() && gDeviceMetricsRings[di] &&
+        gDeviceMetricsRings[di]->drain(metrics, newMetricCallback) > 0) {
+      result.didProcessMetric = true;
+    }
+
     if (info.unprinted.empty()) {
       continue;
     }
@@ -950,16 +977,6 @@ LogProcessingState processChildrenOutput(DriverInfo& driverInfo,
     info.history.resize(info.historySize);
     info.historyLevel.resize(info.historySize);
 
-    auto updateMetricsViews =
-      Metric2DViewIndex::getUpdater({&info.dataRelayerViewIndex,
-                                     &info.variablesViewIndex,
-                                     &info.queriesViewIndex});
-
-    auto newMetricCallback = [&updateMetricsViews, &driverInfo, &metricsInfos, &hasNewMetric](std::string const& name, MetricInfo const& metric, int value, size_t metricIndex) {
-      updateMetricsViews(name, metric, value, metricIndex);
-      hasNewMetric = true;
-    };
-
     while ((pos = s.find(delimiter)) != std::string::npos) {
       std::string token{s.substr(0, pos)};
       auto logLevel = LogParsingHelpers::parseTokenLevel(token);
@@ -1089,6 +1106,7 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
   fair::Logger::SetConsoleColor(false);
   DeviceSpec const& spec = runningWorkflow.devices[ref.index];
   LOG(INFO) << "Spawing new device " << spec.id << " in process with pid " << getpid();
+  SignpostRecorder::setProcessName(spec.id);
 
   fair::mq::DeviceRunner runner{argc, argv};
 
@@ -1101,7 +1119,8 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
       ("driver-client-backend", bpo::value<std::string>()->default_value(defaultDriverClient), "backend for device -> driver communicataon: stdout://: use stdout, ws://: use websockets") //
       ("infologger-severity", bpo::value<std::string>()->default_value(""), "minimum FairLogger severity to send to InfoLogger")                                                           //
       ("configuration,cfg", bpo::value<std::string>()->default_value("command-line"), "configuration backend")                                                                             //
-      ("infologger-mode", bpo::value<std::string>()->default_value(""), "O2_INFOLOGGER_MODE override");
+      ("infologger-mode", bpo::value<std::string>()->default_value(""), "O2_INFOLOGGER_MODE override")                                                                                    //
+      ("latency-trace", bpo::value<bool>()->zero_tokens()->default_value(false), "trace the critical path latency of each timeslice");
     r.fConfig.AddToCmdLineOptions(optsDesc, true);
   });
 
@@ -1195,6 +1214,11 @@ void single_step_callback(uv_timer_s* ctx)
   killChildren(*infos, SIGUSR1);
 }
 
+// Nothing to do, the metrics rings are drained after each loop iteration.
+void drain_metrics_callback(uv_timer_s*)
+{
+}
+
 void dumpMetricsCallback(uv_timer_t* handle)
 {
   DriverServerContext* context = (DriverServerContext*)handle->data;
@@ -1364,6 +1388,11 @@ int runStateMachine(DataProcessorSpecs const& workflow,
   uv_timer_t force_step_timer;
   uv_timer_init(loop, &force_step_timer);
 
+  // Devices do not signal when they add metrics to their ring, so we wake
+  // up regularly to drain them.
+  uv_timer_t metrics_ring_timer;
+  uv_timer_init(loop, &metrics_ring_timer);
+
   bool guiDeployedOnce = false;
   bool once = false;
 
@@ -1441,15 +1470,16 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         LOGF(info, "Optimised build. O2DEBUG / LOG(DEBUG) / LOGF(DEBUG) / assert statement will not be shown.");
 #endif
         break;
-      case DriverState::IMPORT_CURRENT_WORKFLOW:
+      case DriverState::IMPORT_CURRENT_WORKFLOW: {
         // This state is needed to fill the metadata structure
         // which contains how to run the current workflow
         dataProcessorInfos = previousDataProcessorInfos;
+        std::unordered_set<std::string> knownInfos;
+        for (auto const& info : dataProcessorInfos) {
+          knownInfos.insert(info.name);
+        }
         for (auto const& device : runningWorkflow.devices) {
-          auto exists = std::find_if(dataProcessorInfos.begin(),
-                                     dataProcessorInfos.end(),
-                                     [id = device.id](DataProcessorInfo const& info) -> bool { return info.name == id; });
-          if (exists != dataProcessorInfos.end()) {
+          if (knownInfos.insert(device.id).second == false) {
             continue;
           }
           std::vector<std::string> channels;
@@ -1467,7 +1497,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
               workflowInfo.options,
               channels});
         }
-        break;
+      } break;
       case DriverState::MATERIALISE_WORKFLOW:
         try {
           auto workflowState = WorkflowHelpers::verifyWorkflow(workflow);
@@ -1590,6 +1620,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           const auto uniformOptions = {
             "--aod-file",
             "--aod-memory-rate-limit",
+            "--aod-writer-format",
             "--aod-writer-json",
             "--aod-writer-ntfmerge",
             "--aod-writer-resfile",
@@ -1668,6 +1699,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         }
         handleSignals();
         handleChildrenStdio(loop, forwardedStdin.str(), infos, childFds, pollHandles);
+        uv_timer_start(&metrics_ring_timer, drain_metrics_callback, 0, 100);
         for (auto& callback : postScheduleCallbacks) {
           callback(serviceRegistry, varmap);
         }
@@ -1795,6 +1827,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         }
       } break;
       case DriverState::EXIT: {
+        uv_timer_stop(&metrics_ring_timer);
         if (ResourcesMonitoringHelper::isResourcesMonitoringEnabled(driverInfo.resourcesMonitoringInterval)) {
           if (driverInfo.resourcesMonitoringDumpInterval) {
             uv_timer_stop(&metricDumpTimer);
@@ -1820,6 +1853,29 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         }
         LOG(INFO) << "Dumping used configuration in dpl-config.json";
         boost::property_tree::write_json("dpl-config.json", finalConfig);
+        if (auto edges = LatencyTraceHelpers::edges(runningWorkflow.devices, metricsInfos); edges.empty() == false) {
+          LOGP(INFO, "Dumping critical path latency in dpl-latency.json");
+          std::ofstream latency("dpl-latency.json");
+          LatencyTraceHelpers::dumpToJSON(latency, edges, LatencyTraceHelpers::paths(runningWorkflow.devices, metricsInfos));
+        }
+        if (SignpostRecorder::enabled()) {
+          // The devices dumped their signposts when exiting. Put them
+          // together with the ones of the driver in a single timeline.
+          std::vector<std::string> traces{SignpostRecorder::traceFile(getpid())};
+          if (FILE* driverTrace = fopen(traces.front().c_str(), "w")) {
+            SignpostRecorder::setProcessName("driver");
+            SignpostRecorder::dump(driverTrace);
+            fclose(driverTrace);
+          }
+          for (auto& info : infos) {
+            traces.push_back(SignpostRecorder::traceFile(info.pid));
+          }
+          if (FILE* merged = fopen("dpl-signposts.json", "w")) {
+            auto found = SignpostRecorder::merge(traces, merged);
+            fclose(merged);
+            LOGP(INFO, "Dumping signposts of {} processes in dpl-signposts.json", found);
+          }
+        }
         if (driverInfo.noSHMCleanup) {
           LOGP(warning, "Not cleaning up shared memory.");
         } else {
@@ -714,4 +714,110 @@ static void BM_ASoAHelpersCombGenCollisionsFivesCategories(benchmark::State& sta
 
 BENCHMARK(BM_ASoAHelpersCombGenCollisionsFivesCategories)->RangeMultiplier(2)->Range(8, 8 << (maxFivesRange + 1));
 
+static void BM_ASoAHelpersCombGenBatchedSimplePairs(benchmark::State& state)
+{
+  // Seed with a real random value, if available
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float>({"x", "y"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist(e1), uniform_dist(e1));
+  }
+  auto table = builder.finalize();
+
+  using Test = o2::soa::Table<test::X>;
+  Test tests{table};
+  float const* xs = std::static_pointer_cast<arrow::FloatArray>(table->column(0)->chunk(0))->raw_values();
+
+  int64_t count = 0;
+  float sum = 0;
+  CombinationsIndexBatch<2> batch;
+
+  for (auto _ : state) {
+    count = 0;
+    auto generator = selfCombinationsBatched<2>(tests);
+    while (generator.next(batch)) {
+      for (uint64_t n = 0; n < batch.size(); n++) {
+        sum += xs[batch.indices[0][n]] + xs[batch.indices[1][n]];
+      }
+      count += batch.size();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.counters["Combinations"] = count;
+  state.SetBytesProcessed(state.iterations() * sizeof(float) * count);
+}
+
+BENCHMARK(BM_ASoAHelpersCombGenBatchedSimplePairs)->Range(8, 8 << maxPairsRange);
+
+static void BM_ASoAHelpersCombGenBatchedSimplePairsSameCategories(benchmark::State& state)
+{
+  // Seed with a real random value, if available
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+  std::uniform_int_distribution<int> uniform_dist_int(0, 10);
+
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int, float, float>({"x", "y", "z"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist_int(e1), uniform_dist(e1), uniform_dist(e1));
+  }
+  auto table = builder.finalize();
+
+  using Test = o2::soa::Table<test::X>;
+  Test tests{table};
+
+  int64_t count = 0;
+  CombinationsIndexBatch<2> batch;
+
+  for (auto _ : state) {
+    count = 0;
+    auto generator = selfCombinationsBatched<2>("x", 2, -1, tests);
+    while (generator.next(batch)) {
+      count += batch.size();
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.counters["Combinations"] = count;
+  state.SetBytesProcessed(state.iterations() * sizeof(float) * count);
+}
+
+BENCHMARK(BM_ASoAHelpersCombGenBatchedSimplePairsSameCategories)->Range(8, 8 << maxPairsRange);
+
+static void BM_ASoAHelpersCombGenBatchedSimpleTriplesSameCategories(benchmark::State& state)
+{
+  // Seed with a real random value, if available
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+  std::uniform_int_distribution<int> uniform_dist_int(0, 10);
+
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int, float, float>({"x", "y", "z"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist_int(e1), uniform_dist(e1), uniform_dist(e1));
+  }
+  auto table = builder.finalize();
+
+  using Test = o2::soa::Table<test::X>;
+  Test tests{table};
+
+  int64_t count = 0;
+  CombinationsIndexBatch<3> batch;
+
+  for (auto _ : state) {
+    count = 0;
+    auto generator = selfCombinationsBatched<3>("x", 10, -1, tests);
+    while (generator.next(batch)) {
+      count += batch.size();
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.counters["Combinations"] = count;
+  state.SetBytesProcessed(state.iterations() * sizeof(float) * count);
+}
+
+BENCHMARK(BM_ASoAHelpersCombGenBatchedSimpleTriplesSameCategories)->Range(8, 8 << maxPairsRange);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,88 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ArrowFileHelpers.h"
+#include "Framework/TableBuilder.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include <arrow/table.h>
+
+using namespace o2::framework;
+
+// Same table and sizes as in benchmark_TableToTree and benchmark_TreeToTable
+// so that the MB/s can be compared directly.
+#ifdef __APPLE__
+constexpr unsigned int maxrange = 15;
+#else
+constexpr unsigned int maxrange = 16;
+#endif
+
+static const char* codecs[] = {"", "lz4", "zstd"};
+
+static std::shared_ptr<arrow::Table> makeTable(int64_t n)
+{
+  // initialize a random generator
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<double> rd(0, 1);
+  std::normal_distribution<float> rf(5., 2.);
+  std::discrete_distribution<uint64_t> rl({10, 20, 30, 30, 5, 5});
+  std::discrete_distribution<int> ri({10, 20, 30, 30, 5, 5});
+
+  // create a table and fill the columns with random numbers
+  TableBuilder builder;
+  auto rowWriter =
+    builder.persist<double, float, uint64_t, int>({"a", "b", "c", "d"});
+  for (auto i = 0; i < n; ++i) {
+    rowWriter(0, rd(e1), rf(e1), rl(e1), ri(e1));
+  }
+  return builder.finalize();
+}
+
+static void BM_ArrowFileWrite(benchmark::State& state)
+{
+  auto table = makeTable(state.range(0));
+
+  for (auto _ : state) {
+    ArrowFileHelpers::write(table, "table2arrow.arrow", codecs[state.range(1)]);
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 24);
+}
+
+// table size x codec
+static void codecArguments(benchmark::internal::Benchmark* b)
+{
+  for (auto codec = 0; codec < 3; ++codec) {
+    for (auto n = 8; n <= (8 << maxrange); n *= 8) {
+      b->Args({n, codec});
+    }
+  }
+}
+
+BENCHMARK(BM_ArrowFileWrite)->Apply(codecArguments);
+
+static void BM_ArrowFileRead(benchmark::State& state)
+{
+  ArrowFileHelpers::write(makeTable(state.range(0)), "arrow2table.arrow", codecs[state.range(1)]);
+
+  for (auto _ : state) {
+    auto table = ArrowFileHelpers::read("arrow2table.arrow");
+    benchmark::DoNotOptimize(table);
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 24);
+}
+
+BENCHMARK(BM_ArrowFileRead)->Apply(codecArguments);
+
+BENCHMARK_MAIN();
@@ -10,9 +10,14 @@
 // or submit itself to any jurisdiction.
 #include <benchmark/benchmark.h>
 #include "Headers/DataHeader.h"
+#include "Headers/Stack.h"
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/InputRoute.h"
+#include "../src/DataRelayerHelpers.h"
 
 using namespace o2::header;
+using namespace o2::framework;
 using namespace o2::framework::data_matcher;
 
 static void BM_MatchedSingleQuery(benchmark::State& state)
@@ -179,4 +184,70 @@ static void BM_OneVariableMatchUnmatch(benchmark::State& state)
 // Register the function as a benchmark
 BENCHMARK(BM_OneVariableMatchUnmatch);
 
+namespace
+{
+// One route per subspecification, like a device receiving data from many links.
+std::vector<InputRoute> createLinkRoutes(size_t n)
+{
+  std::vector<InputRoute> routes;
+  for (size_t i = 0; i < n; ++i) {
+    routes.push_back(InputRoute{InputSpec{"link", "TST", "RAWDATA", static_cast<DataHeader::SubSpecificationType>(i)}, i, "from_proxy", 0});
+  }
+  return routes;
+}
+
+// The data of the last route, which is the worst case when checking the
+// routes one after the other.
+Stack createLastLinkStack(size_t n)
+{
+  DataHeader dh;
+  dh.dataOrigin = "TST";
+  dh.dataDescription = "RAWDATA";
+  dh.subSpecification = n - 1;
+  return Stack{dh, DataProcessingHeader{0, 1}};
+}
+} // namespace
+
+static void BM_RelayerMatchAllRoutes(benchmark::State& state)
+{
+  auto routes = createLinkRoutes(state.range(0));
+  auto index = DataRelayerHelpers::createDistinctRouteIndex(routes);
+  auto matchers = DataRelayerHelpers::createInputMatchers(routes);
+  auto stack = createLastLinkStack(routes.size());
+  auto data = reinterpret_cast<char const*>(stack.data());
+  VariableContext context;
+
+  for (auto _ : state) {
+    for (size_t ri = 0; ri < index.size(); ++ri) {
+      if (matchers[index[ri]].match(data, context)) {
+        context.commit();
+        benchmark::DoNotOptimize(ri);
+        break;
+      }
+      context.discard();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RelayerMatchAllRoutes)->Range(8, 1024);
+
+static void BM_RelayerMatchRouteTable(benchmark::State& state)
+{
+  auto routes = createLinkRoutes(state.range(0));
+  auto index = DataRelayerHelpers::createDistinctRouteIndex(routes);
+  auto matchers = DataRelayerHelpers::createInputMatchers(routes);
+  auto table = DataRelayerHelpers::createRouteMatchingTable(routes, index);
+  auto stack = createLastLinkStack(routes.size());
+  auto data = reinterpret_cast<char const*>(stack.data());
+  VariableContext context;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DataRelayerHelpers::matchToContext(table, data, matchers, index, context));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RelayerMatchRouteTable)->Range(8, 1024);
+
 BENCHMARK_MAIN();
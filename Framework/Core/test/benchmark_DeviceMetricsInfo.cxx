@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "../src/DeviceMetricsRing.h"
 
 #include <benchmark/benchmark.h>
 #include <regex>
@@ -92,10 +93,31 @@ static void BM_ProcessIntMetric(benchmark::State& state)
     }
   }
   state.SetBytesProcessed(state.iterations() * metrics.size() * metric.size());
+  state.SetItemsProcessed(state.iterations() * metrics.size());
 }
 
 BENCHMARK(BM_ProcessIntMetric);
 
+// Same as above, but with the metrics coming from the binary ring
+static void BM_DrainIntMetricRing(benchmark::State& state)
+{
+  using namespace o2::framework;
+  DeviceMetricsInfo info;
+  auto ring = DeviceMetricsRing::create("", 1024);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (size_t i = 0; i < 1000; ++i) {
+      ring->push("bkey", 12, 1789372894);
+    }
+    state.ResumeTiming();
+    ring->drain(info);
+  }
+  state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+BENCHMARK(BM_DrainIntMetricRing);
+
 static void BM_ParseFloatMetric(benchmark::State& state)
 {
   using namespace o2::framework;
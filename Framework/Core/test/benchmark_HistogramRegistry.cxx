@@ -16,14 +16,36 @@
 
 #include <benchmark/benchmark.h>
 #include <boost/format.hpp>
+#include <random>
 
 using namespace o2::framework;
 using namespace arrow;
 using namespace o2::soa;
 
+namespace test
+{
+DECLARE_SOA_COLUMN_FULL(X, x, float, "x");
+DECLARE_SOA_COLUMN_FULL(Y, y, float, "y");
+} // namespace test
+
+using TestXY = o2::soa::Table<o2::soa::Index<>, test::X, test::Y>;
+
 /// Number of lookups to perform
 const int nLookups = 100000;
 
+/// Create a table with state.range(0) random (x, y) entries
+static TestXY createTable(benchmark::State& state)
+{
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(-1, 1);
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float>({"x", "y"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist(e1), uniform_dist(e1));
+  }
+  return TestXY{builder.finalize()};
+}
+
 /// Lookup a histogram by name literal in a HistogramRegistry
 static void BM_HashedNameLookup(benchmark::State& state)
 {
@@ -62,7 +84,36 @@ static void BM_StandardNameLookup(benchmark::State& state)
     }
   }
 }
+/// Fill a 2D histogram from the table columns in one go
+static void BM_TableFill(benchmark::State& state)
+{
+  auto table = createTable(state);
+  HistogramRegistry registry{"registry", {{"xy", "xy", {HistType::kTH2F, {{100, -1, 1}, {100, -1, 1}}}}}};
+  for (auto _ : state) {
+    registry.fill<test::X, test::Y>(HIST("xy"), table, test::x > -0.5f);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Fill a 2D histogram row by row with the same selection as above
+static void BM_RowFill(benchmark::State& state)
+{
+  auto table = createTable(state);
+  HistogramRegistry registry{"registry", {{"xy", "xy", {HistType::kTH2F, {{100, -1, 1}, {100, -1, 1}}}}}};
+  for (auto _ : state) {
+    for (auto& row : table) {
+      if (row.x() > -0.5f) {
+        registry.fill(HIST("xy"), row.x(), row.y());
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 BENCHMARK(BM_HashedNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 BENCHMARK(BM_StandardNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 
+BENCHMARK(BM_TableFill)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_RowFill)->Range(1 << 10, 1 << 20);
+
 BENCHMARK_MAIN();
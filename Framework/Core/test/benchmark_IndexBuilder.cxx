@@ -0,0 +1,118 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ASoA.h"
+#include "Framework/TableBuilder.h"
+#include "Framework/AnalysisHelpers.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace o2::framework;
+using namespace arrow;
+using namespace o2::soa;
+
+DECLARE_SOA_STORE();
+namespace test
+{
+DECLARE_SOA_COLUMN_FULL(X, x, float, "x");
+} // namespace test
+DECLARE_SOA_TABLE(Points, "TST", "POINTS", Index<>, test::X);
+
+namespace extra
+{
+DECLARE_SOA_INDEX_COLUMN(Point, point);
+DECLARE_SOA_COLUMN_FULL(D, d, float, "d");
+} // namespace extra
+DECLARE_SOA_TABLE(Distances, "TST", "DISTANCES", Index<>, extra::PointId, extra::D);
+DECLARE_SOA_TABLE(Weights, "TST", "WEIGHTS", Index<>, extra::PointId, extra::D);
+
+namespace indices
+{
+DECLARE_SOA_INDEX_COLUMN(Point, point);
+DECLARE_SOA_INDEX_COLUMN(Distance, distance);
+DECLARE_SOA_INDEX_COLUMN(Weight, weight);
+} // namespace indices
+DECLARE_SOA_TABLE(IDXs, "TST", "INDEX", Index<>, indices::PointId, indices::DistanceId, indices::WeightId);
+
+#ifdef __APPLE__
+constexpr unsigned int maxrange = 10;
+#else
+constexpr unsigned int maxrange = 16;
+#endif
+
+/// Fill @a points and two tables pointing to 3/4 of them. If @a shuffle
+/// is set the secondary tables are not sorted by the Point index.
+static auto makeTables(int64_t n, bool shuffle)
+{
+  std::default_random_engine e1(1234567891);
+  std::vector<int> ids(n);
+  std::iota(ids.begin(), ids.end(), 0);
+
+  TableBuilder b1;
+  auto w1 = b1.cursor<Points>();
+  for (auto i = 0; i < n; ++i) {
+    w1(0, i * 0.1f);
+  }
+
+  auto fill = [&](auto& builder, auto cursor) {
+    std::shuffle(ids.begin(), ids.end(), e1);
+    std::vector<int> selected(ids.begin(), ids.begin() + (3 * n) / 4);
+    if (!shuffle) {
+      std::sort(selected.begin(), selected.end());
+    }
+    for (auto i : selected) {
+      cursor(0, i, i * 0.2f);
+    }
+    return builder.finalize();
+  };
+  TableBuilder b2;
+  auto t2 = fill(b2, b2.cursor<Distances>());
+  TableBuilder b3;
+  auto t3 = fill(b3, b3.cursor<Weights>());
+  return std::make_tuple(b1.finalize(), t2, t3);
+}
+
+static void BM_IndexSparse(benchmark::State& state)
+{
+  auto [t1, t2, t3] = makeTables(state.range(0), state.range(1));
+  Points points{t1};
+  Distances distances{t2};
+  Weights weights{t3};
+
+  for (auto _ : state) {
+    auto t = IndexSparse::indexBuilder(typename IDXs::persistent_columns_t{}, points, std::tie(points, distances, weights));
+    benchmark::DoNotOptimize(t);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_IndexSparse)->Ranges({{8, 8 << maxrange}, {0, 1}});
+
+static void BM_IndexExclusive(benchmark::State& state)
+{
+  auto [t1, t2, t3] = makeTables(state.range(0), state.range(1));
+  Points points{t1};
+  Distances distances{t2};
+  Weights weights{t3};
+
+  for (auto _ : state) {
+    auto t = IndexExclusive::indexBuilder(typename IDXs::persistent_columns_t{}, points, std::tie(points, distances, weights));
+    benchmark::DoNotOptimize(t);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_IndexExclusive)->Ranges({{8, 8 << maxrange}, {0, 1}});
+
+BENCHMARK_MAIN();
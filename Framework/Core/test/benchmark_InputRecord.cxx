@@ -20,6 +20,8 @@
 #include <Monitoring/Monitoring.h>
 #include <fairmq/FairMQTransportFactory.h>
 #include <cstring>
+#include <deque>
+#include <memory>
 
 using Monitoring = o2::monitoring::Monitoring;
 using namespace o2::framework;
@@ -102,4 +104,115 @@ static void BM_InputRecordGenericGetters(benchmark::State& state)
 
 BENCHMARK(BM_InputRecordGenericGetters);
 
+namespace
+{
+/// A record with @a nInputs inputs, bound to "input0", "input1", ... and
+/// each of them with @a nParts parts of @a nInts integers.
+struct MultipartRecord {
+  MultipartRecord(size_t nInputs, size_t nParts, size_t nInts)
+    : inputs(nInputs)
+  {
+    for (size_t ii = 0; ii < nInputs; ++ii) {
+      bindings.push_back("input" + std::to_string(ii));
+      specs.emplace_back(InputSpec{bindings.back(), "TST", "A", static_cast<uint32_t>(ii), Lifetime::Timeframe});
+    }
+    for (size_t ii = 0; ii < nInputs; ++ii) {
+      schema.emplace_back(InputRoute{specs[ii], ii, "source"});
+      DataHeader dh;
+      dh.dataOrigin = "TST";
+      dh.dataDescription = "A";
+      dh.subSpecification = ii;
+      dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+      dh.payloadSize = nInts * sizeof(int);
+      for (size_t pi = 0; pi < nParts; ++pi) {
+        DataProcessingHeader dph{0, 1};
+        Stack stack{dh, dph};
+        auto& header = buffers.emplace_back(stack.size());
+        memcpy(header.data(), stack.data(), stack.size());
+        auto& payload = buffers.emplace_back(dh.payloadSize);
+        inputs[ii].emplace_back(header.data());
+        inputs[ii].emplace_back(payload.data());
+      }
+    }
+    span = std::make_unique<InputSpan>([this](size_t i, size_t part) { return DataRef{nullptr, inputs[i][2 * part], inputs[i][2 * part + 1]}; },
+                                       [this](size_t i) { return inputs[i].size() / 2; },
+                                       inputs.size());
+    record = std::make_unique<InputRecord>(schema, *span);
+  }
+
+  std::vector<std::string> bindings;
+  std::vector<InputSpec> specs;
+  std::vector<InputRoute> schema;
+  std::deque<std::vector<char>> buffers;
+  std::vector<std::vector<char const*>> inputs;
+  std::unique_ptr<InputSpan> span;
+  std::unique_ptr<InputRecord> record;
+};
+} // namespace
+
+// Typical high rate device: a few tens of inputs, all accessed by name.
+static void BM_InputRecordGetByName(benchmark::State& state)
+{
+  MultipartRecord setup(state.range(0), 1, 16);
+  auto& record = *setup.record;
+  for (auto _ : state) {
+    for (auto& binding : setup.bindings) {
+      benchmark::DoNotOptimize(record.get<gsl::span<int>>(binding.c_str()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_InputRecordGetByName)->Arg(4)->Arg(16)->Arg(64);
+
+// Same, but with the bindings resolved once upfront.
+static void BM_InputRecordGetByBinding(benchmark::State& state)
+{
+  MultipartRecord setup(state.range(0), 1, 16);
+  auto& record = *setup.record;
+  std::vector<InputBinding> bindings;
+  for (auto& binding : setup.bindings) {
+    bindings.emplace_back(binding.c_str()).resolve(setup.schema);
+  }
+  for (auto _ : state) {
+    for (auto& binding : bindings) {
+      benchmark::DoNotOptimize(record.get<gsl::span<int>>(binding));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_InputRecordGetByBinding)->Arg(4)->Arg(16)->Arg(64);
+
+// All the parts of a multipart input, one by one.
+static void BM_InputRecordPartsByName(benchmark::State& state)
+{
+  MultipartRecord setup(16, state.range(0), 16);
+  auto& record = *setup.record;
+  auto binding = setup.bindings.back().c_str();
+  for (auto _ : state) {
+    for (size_t pi = 0, pe = record.getNofParts(record.getPos(binding)); pi < pe; ++pi) {
+      benchmark::DoNotOptimize(record.get<gsl::span<int>>(binding, pi));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_InputRecordPartsByName)->Arg(8)->Arg(64)->Arg(512);
+
+// All the parts of a multipart input, in one go.
+static void BM_InputRecordPartsAsSpans(benchmark::State& state)
+{
+  MultipartRecord setup(16, state.range(0), 16);
+  auto& record = *setup.record;
+  InputBinding binding{setup.bindings.back().c_str()};
+  binding.resolve(setup.schema);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(record.getSpans<int>(binding));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_InputRecordPartsAsSpans)->Arg(8)->Arg(64)->Arg(512);
+
 BENCHMARK_MAIN();
@@ -95,6 +95,23 @@ static void BM_TableBuilderScalarBulk(benchmark::State& state)
 
 BENCHMARK(BM_TableBuilderScalarBulk)->Range(256, 1 << 20);
 
+static void BM_TableBuilderScalarColumnar(benchmark::State& state)
+{
+  using namespace o2::framework;
+  auto chunkSize = state.range(0) / 256;
+  std::vector<float> buffer(chunkSize, 0.); // We assume data is chunked in blocks 256th of the total size
+  for (auto _ : state) {
+    TableBuilder builder;
+    auto columnWriter = builder.columnarPersist<float>({"x"}, state.range(0));
+    for (size_t i = 0; i < state.range(0) / chunkSize; ++i) {
+      columnWriter(0, chunkSize, buffer.data());
+    }
+    auto table = builder.finalize();
+  }
+}
+
+BENCHMARK(BM_TableBuilderScalarColumnar)->Range(256, 1 << 20);
+
 static void BM_TableBuilderSimple(benchmark::State& state)
 {
   using namespace o2::framework;
@@ -149,6 +166,22 @@ static void BM_TableBuilderSoA(benchmark::State& state)
 
 BENCHMARK(BM_TableBuilderSoA)->Range(8, 8 << 16);
 
+static void BM_TableBuilderSoAColumnar(benchmark::State& state)
+{
+  using namespace o2::framework;
+  std::vector<float> x(state.range(0), 0.f);
+  std::vector<float> y(state.range(0), 0.f);
+  std::vector<float> z(state.range(0), 0.f);
+  for (auto _ : state) {
+    TableBuilder builder;
+    auto columnWriter = builder.columnarCursor<TestVectors>(state.range(0));
+    columnWriter(0, state.range(0), x.data(), y.data(), z.data());
+    auto table = builder.finalize();
+  }
+}
+
+BENCHMARK(BM_TableBuilderSoAColumnar)->Range(8, 8 << 16);
+
 static void BM_TableBuilderComplex(benchmark::State& state)
 {
   using namespace o2::framework;
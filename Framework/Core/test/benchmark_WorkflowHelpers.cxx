@@ -14,9 +14,21 @@
 #include "Framework/DataSpecUtils.h"
 #include "Framework/OutputSpec.h"
 #include "Framework/SimpleOptionsRetriever.h"
+#include "Framework/ChannelConfigurationPolicy.h"
+#include "Framework/CompletionPolicy.h"
+#include "Framework/ComputingResource.h"
+#include "Framework/CommandInfo.h"
+#include "Framework/DataProcessorInfo.h"
+#include "Framework/DeviceControl.h"
+#include "Framework/DeviceExecution.h"
 #include "../src/WorkflowHelpers.h"
+#include "../src/DeviceSpecHelpers.h"
+#include "../src/DDSConfigHelpers.h"
+#include "../src/SimpleResourceManager.h"
 #include <benchmark/benchmark.h>
+#include <fmt/format.h>
 #include <algorithm>
+#include <sstream>
 
 using namespace o2::framework;
 
@@ -107,4 +119,101 @@ static void BM_CreateGraphReverseOverhead(benchmark::State& state)
 }
 
 BENCHMARK(BM_CreateGraphReverseOverhead)->Range(1, 1 << 10);
+
+// A topology with N producers, each feeding its own processor, whose
+// outputs are then merged by a single device. Together with the clock this
+// gives 2N + 2 devices, so that the largest case has more than 5000 of them.
+// With @a typeOnlyMerger the merger subscribes to TST/PROCESSED for any
+// subSpec with a single input, as the QC mergers do, rather than to each of
+// the processors.
+WorkflowSpec makeLargeWorkflow(size_t n, bool typeOnlyMerger)
+{
+  WorkflowSpec workflow;
+  std::vector<InputSpec> mergerInputs;
+  for (size_t i = 0; i < n; ++i) {
+    auto subSpec = static_cast<o2::header::DataHeader::SubSpecificationType>(i);
+    workflow.push_back(DataProcessorSpec{fmt::format("producer-{}", i),
+                                         {},
+                                         {OutputSpec{{"data"}, "TST", "DATA", subSpec}}});
+    workflow.push_back(DataProcessorSpec{fmt::format("processor-{}", i),
+                                         {InputSpec{"data", "TST", "DATA", subSpec}},
+                                         {OutputSpec{{"processed"}, "TST", "PROCESSED", subSpec}}});
+    if (typeOnlyMerger == false) {
+      mergerInputs.emplace_back(InputSpec{fmt::format("processed-{}", i), "TST", "PROCESSED", subSpec});
+    }
+  }
+  if (typeOnlyMerger) {
+    mergerInputs.emplace_back(InputSpec{"processed", ConcreteDataTypeMatcher{"TST", "PROCESSED"}});
+  }
+  workflow.push_back(DataProcessorSpec{"merger", mergerInputs});
+  return workflow;
+}
+
+std::vector<DeviceSpec> makeLargeTopology(WorkflowSpec& workflow)
+{
+  if (WorkflowHelpers::verifyWorkflow(workflow) != WorkflowParsingState::Valid) {
+    throw std::runtime_error("invalid workflow");
+  };
+  auto context = makeEmptyConfigContext();
+  WorkflowHelpers::injectServiceDevices(workflow, *context);
+
+  ComputingResource resource;
+  resource.cpu = 1e6;
+  resource.memory = 1e12;
+  resource.hostname = "localhost";
+  resource.startPort = 22000;
+  resource.lastPort = 62000;
+  SimpleResourceManager rm{{resource}};
+  std::vector<DeviceSpec> devices;
+  DeviceSpecHelpers::dataProcessorSpecs2DeviceSpecs(workflow,
+                                                    ChannelConfigurationPolicy::createDefaultPolicies(*context),
+                                                    CompletionPolicy::createDefaultPolicies(),
+                                                    devices,
+                                                    rm, "workflow-id", true);
+  return devices;
+}
+
+// range(0) is the number of producers, range(1) whether the merger uses a
+// type-only input.
+static void BM_CreateLargeTopology(benchmark::State& state)
+{
+  size_t n = state.range(0);
+  for (auto _ : state) {
+    auto workflow = makeLargeWorkflow(n, state.range(1));
+    auto devices = makeLargeTopology(workflow);
+    if (devices.size() != 2 * n + 2) {
+      throw std::runtime_error("unexpected number of devices");
+    }
+  }
+  state.counters["devices"] = 2 * n + 2;
+}
+
+BENCHMARK(BM_CreateLargeTopology)->RangeMultiplier(4)->Ranges({{16, 2560}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+// Serialising the topology once it is built: the command line of every
+// device, including its channel configuration, and the DDS topology made
+// out of them.
+static void BM_SerialiseLargeTopology(benchmark::State& state)
+{
+  size_t n = state.range(0);
+  auto workflow = makeLargeWorkflow(n, state.range(1));
+  auto devices = makeLargeTopology(workflow);
+  std::vector<DataProcessorInfo> infos;
+  for (auto& spec : workflow) {
+    infos.push_back(DataProcessorInfo{spec.name, "o2-benchmark-workflow", {}, {}});
+  }
+  CommandInfo command{"o2-benchmark-workflow"};
+
+  for (auto _ : state) {
+    std::vector<DeviceExecution> executions(devices.size());
+    std::vector<DeviceControl> controls(devices.size());
+    DeviceSpecHelpers::prepareArguments(false, false, 8080, infos, devices, executions, controls, "workflow-id");
+    std::ostringstream out;
+    dumpDeviceSpec2DDS(out, devices, executions, command);
+    benchmark::DoNotOptimize(out.str());
+  }
+  state.counters["devices"] = devices.size();
+}
+
+BENCHMARK(BM_SerialiseLargeTopology)->RangeMultiplier(4)->Ranges({{16, 2560}, {0, 1}})->Unit(benchmark::kMillisecond);
 BENCHMARK_MAIN();
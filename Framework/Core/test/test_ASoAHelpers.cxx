@@ -1348,3 +1348,83 @@ BOOST_AUTO_TEST_CASE(CombinationsHelpers)
   }
   BOOST_CHECK_EQUAL(count, expectedStrictlyUpperTriples.size());
 }
+
+BOOST_AUTO_TEST_CASE(BatchedCombinations)
+{
+  TableBuilder builderA;
+  auto rowWriterA = builderA.persist<int32_t, int32_t>({"x", "y"});
+  for (int i = 0; i < 20; i++) {
+    rowWriterA(0, i, (i * 7) % 4 - 1);
+  }
+  auto tableA = builderA.finalize();
+  BOOST_REQUIRE_EQUAL(tableA->num_rows(), 20);
+
+  using TestA = o2::soa::Table<o2::soa::Index<>, test::X, test::Y>;
+  TestA testsA{tableA};
+
+  // Plain strictly upper pairs, with a block size which does not divide the number of combinations
+  CombinationsIndexBatch<2> pairs;
+  auto pairGenerator = selfCombinationsBatched<2>(testsA);
+  int count = 0;
+  int blocks = 0;
+  while (pairGenerator.next(pairs, 7)) {
+    BOOST_CHECK(pairs.size() <= 7);
+    blocks++;
+    for (uint64_t n = 0; n < pairs.size(); n++) {
+      BOOST_CHECK(pairs.indices[0][n] < pairs.indices[1][n]);
+      count++;
+    }
+  }
+  BOOST_CHECK_EQUAL(count, 190);
+  BOOST_CHECK_EQUAL(blocks, 28);
+  BOOST_CHECK(pairGenerator.isEnd());
+
+  // Same combinations and order as with the iterator based policy
+  std::vector<std::tuple<int32_t, int32_t>> expectedPairs;
+  for (auto& [c0, c1] : selfPairCombinations("y", 2, -1, testsA)) {
+    expectedPairs.emplace_back(c0.x(), c1.x());
+  }
+  count = 0;
+  auto pairCatGenerator = selfCombinationsBatched<2>("y", 2, -1, testsA);
+  while (pairCatGenerator.next(pairs, 4)) {
+    for (uint64_t n = 0; n < pairs.size(); n++) {
+      BOOST_REQUIRE(count < expectedPairs.size());
+      BOOST_CHECK_EQUAL(testsA.iteratorAt(pairs.indices[0][n]).x(), std::get<0>(expectedPairs[count]));
+      BOOST_CHECK_EQUAL(testsA.iteratorAt(pairs.indices[1][n]).x(), std::get<1>(expectedPairs[count]));
+      count++;
+    }
+  }
+  BOOST_CHECK_EQUAL(count, expectedPairs.size());
+
+  std::vector<std::tuple<int32_t, int32_t, int32_t>> expectedTriples;
+  for (auto& [c0, c1, c2] : selfTripleCombinations("y", 3, -1, testsA)) {
+    expectedTriples.emplace_back(c0.x(), c1.x(), c2.x());
+  }
+  CombinationsIndexBatch<3> triples;
+  count = 0;
+  auto tripleGenerator = selfCombinationsBatched<3>("y", 3, -1, testsA);
+  while (tripleGenerator.next(triples)) {
+    for (uint64_t n = 0; n < triples.size(); n++) {
+      BOOST_REQUIRE(count < expectedTriples.size());
+      BOOST_CHECK_EQUAL(testsA.iteratorAt(triples.indices[0][n]).x(), std::get<0>(expectedTriples[count]));
+      BOOST_CHECK_EQUAL(testsA.iteratorAt(triples.indices[1][n]).x(), std::get<1>(expectedTriples[count]));
+      BOOST_CHECK_EQUAL(testsA.iteratorAt(triples.indices[2][n]).x(), std::get<2>(expectedTriples[count]));
+      count++;
+    }
+  }
+  BOOST_CHECK_EQUAL(count, expectedTriples.size());
+
+  // Rewinding gives the same combinations again
+  tripleGenerator.reset();
+  count = 0;
+  while (tripleGenerator.next(triples)) {
+    count += triples.size();
+  }
+  BOOST_CHECK_EQUAL(count, expectedTriples.size());
+
+  // Window smaller than the combination size
+  auto emptyGenerator = selfCombinationsBatched<3>("y", 1, -1, testsA);
+  BOOST_CHECK(emptyGenerator.isEnd());
+  BOOST_CHECK(!emptyGenerator.next(triples));
+  BOOST_CHECK_EQUAL(triples.size(), 0);
+}
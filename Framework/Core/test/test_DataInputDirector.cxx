@@ -17,6 +17,11 @@
 
 #include "Headers/DataHeader.h"
 #include "Framework/DataInputDirector.h"
+#include "Framework/ArrowFileHelpers.h"
+#include "Framework/TableBuilder.h"
+
+#include <arrow/table.h>
+#include <filesystem>
 
 BOOST_AUTO_TEST_CASE(TestDatainputDirector)
 {
@@ -108,3 +113,56 @@ BOOST_AUTO_TEST_CASE(TestDatainputDirector)
   BOOST_CHECK(didesc);
   BOOST_CHECK_EQUAL(didesc->getNumberInputfiles(), 3);
 }
+
+BOOST_AUTO_TEST_CASE(TestDatainputDirectorArrow)
+{
+  using namespace o2::header;
+  using namespace o2::framework;
+
+  // two time frames stored as Arrow IPC files
+  std::filesystem::remove_all("Cresults.arrow");
+  for (auto tf : {3, 1}) {
+    std::filesystem::create_directories("Cresults.arrow/DF_" + std::to_string(tf));
+    TableBuilder builder;
+    auto rowWriter = builder.persist<int, float>({"x", "y"});
+    for (auto i = 0; i < 10 * tf; ++i) {
+      rowWriter(0, i, i * 0.5f);
+    }
+    BOOST_REQUIRE(ArrowFileHelpers::write(builder.finalize(), "Cresults.arrow/DF_" + std::to_string(tf) + "/uno.arrow", tf == 3 ? "lz4" : ""));
+  }
+
+  std::string jsonFile("testO2configArrow.json");
+  std::ofstream jf(jsonFile, std::ofstream::out);
+  jf << R"({)" << std::endl;
+  jf << R"(  "InputDirector": {)" << std::endl;
+  jf << R"(    "resfiles": [)" << std::endl;
+  jf << R"(      "Cresults.arrow")" << std::endl;
+  jf << R"(    ],)" << std::endl;
+  jf << R"(    "InputDescriptors": [)" << std::endl;
+  jf << R"(      {)" << std::endl;
+  jf << R"(        "table": "AOD/UNO/0",)" << std::endl;
+  jf << R"(        "treename": "uno")" << std::endl;
+  jf << R"(      })" << std::endl;
+  jf << R"(    ])" << std::endl;
+  jf << R"(  })" << std::endl;
+  jf << R"(})" << std::endl;
+  jf.close();
+
+  DataInputDirector didir;
+  BOOST_CHECK(didir.readJson(jsonFile));
+
+  auto dh = DataHeader(DataDescription{"UNO"},
+                       DataOrigin{"AOD"},
+                       DataHeader::SubSpecificationType{0});
+  BOOST_CHECK(didir.isArrowFile(dh, 0));
+  BOOST_CHECK(didir.getDataTree(dh, 0, 0) == nullptr);
+  BOOST_CHECK_EQUAL(didir.getTimeFrameNumber(dh, 0, 0), 1);
+  BOOST_CHECK_EQUAL(didir.getTimeFramesInFile(dh, 0), 2);
+  BOOST_CHECK_EQUAL(didir.getTimeFrameNumber(dh, 0, 1), 3);
+
+  auto table = didir.getArrowTable(dh, 0, 1);
+  BOOST_REQUIRE(table != nullptr);
+  BOOST_CHECK_EQUAL(table->num_rows(), 30);
+  BOOST_CHECK_EQUAL(table->num_columns(), 2);
+  BOOST_CHECK(didir.getArrowTable(dh, 0, 2) == nullptr);
+}
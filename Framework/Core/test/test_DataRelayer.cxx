@@ -20,6 +20,8 @@
 #include "Framework/DataRelayer.h"
 #include "../src/DataRelayerHelpers.h"
 #include "Framework/DataProcessingHeader.h"
+#include "Framework/LifetimeHelpers.h"
+#include "Framework/ServiceRegistry.h"
 #include "Framework/WorkflowSpec.h"
 #include <Monitoring/Monitoring.h>
 #include <fairmq/FairMQTransportFactory.h>
@@ -199,6 +201,80 @@ BOOST_AUTO_TEST_CASE(TestRelay)
   BOOST_REQUIRE_EQUAL(result.at(1).size(), 1);
 }
 
+// A slot which is waiting for data-driven inputs, like in test_DanglingInputs,
+// is checked again only when its checkers ask for it.
+BOOST_AUTO_TEST_CASE(TestDanglingChecks)
+{
+  Monitoring metrics;
+  InputSpec spec1{"clusters", "TPC", "CLUSTERS"};
+  InputSpec spec2{"clusters_its", "ITS", "CLUSTERS"};
+  InputSpec spec3{"clusters_tof", "TOF", "CLUSTERS"};
+
+  std::vector<InputRoute> inputs = {
+    InputRoute{spec1, 0, "Fake1", 0},
+    InputRoute{spec2, 1, "Fake2", 0},
+    InputRoute{spec3, 2, "Fake3", 0}};
+
+  TimesliceIndex index;
+  auto policy = CompletionPolicyHelpers::consumeWhenAll();
+  DataRelayer relayer(policy, inputs, metrics, index);
+  relayer.setPipelineLength(4);
+
+  int neverChecks = 0;
+  int laterChecks = 0;
+  auto expireNever = LifetimeHelpers::expireNever();
+  std::vector<ExpirationHandler> handlers{
+    {RouteIndex{0}, Lifetime::Timeframe, LifetimeHelpers::dataDrivenCreation(), expireNever, LifetimeHelpers::doNothing()},
+    {RouteIndex{1}, Lifetime::Timeframe, LifetimeHelpers::dataDrivenCreation(),
+     [&neverChecks, expireNever](uint64_t timestamp, uint64_t& nextCheck) {
+       neverChecks++;
+       return expireNever(timestamp, nextCheck);
+     },
+     LifetimeHelpers::doNothing()},
+    {RouteIndex{2}, Lifetime::Timeframe, LifetimeHelpers::dataDrivenCreation(),
+     [&laterChecks](uint64_t, uint64_t& nextCheck) {
+       laterChecks++;
+       nextCheck = ExpirationHandler::NEVER - 1;
+       return false;
+     },
+     LifetimeHelpers::doNothing()}};
+
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  DataHeader dh;
+  dh.dataDescription = "CLUSTERS";
+  dh.dataOrigin = "TPC";
+  dh.subSpecification = 0;
+  dh.splitPayloadIndex = 0;
+  dh.splitPayloadParts = 1;
+  DataProcessingHeader dph{0, 1};
+  Stack stack{dh, dph};
+  FairMQMessagePtr header = transport->CreateMessage(stack.size());
+  FairMQMessagePtr payload = transport->CreateMessage(1000);
+  memcpy(header->GetData(), stack.data(), stack.size());
+  relayer.relay(header, payload);
+  BOOST_CHECK_EQUAL(index.getEarliestCheck(), 0);
+
+  ServiceRegistry registry;
+  for (int i = 0; i < 10; ++i) {
+    auto activity = relayer.processDanglingInputs(handlers, registry, true);
+    BOOST_CHECK_EQUAL(activity.expiredSlots, 0);
+  }
+  // The new slot is looked at once, then it is not due anymore.
+  BOOST_CHECK_EQUAL(neverChecks, 1);
+  BOOST_CHECK_EQUAL(laterChecks, 1);
+  BOOST_CHECK_EQUAL(index.getEarliestCheck(), ExpirationHandler::NEVER - 1);
+
+  // New data for the same timeslice does not make it due again.
+  dh.dataOrigin = "ITS";
+  Stack stack2{dh, dph};
+  header = transport->CreateMessage(stack2.size());
+  payload = transport->CreateMessage(1000);
+  memcpy(header->GetData(), stack2.data(), stack2.size());
+  relayer.relay(header, payload);
+  relayer.processDanglingInputs(handlers, registry, true);
+  BOOST_CHECK_EQUAL(laterChecks, 1);
+}
+
 // This test a more complicated set of inputs, and verifies that data is
 // correctly relayed before being processed.
 BOOST_AUTO_TEST_CASE(TestRelayBug)
@@ -593,3 +669,45 @@ BOOST_AUTO_TEST_CASE(SplitParts)
   BOOST_CHECK_NE(header2.get(), nullptr);
   BOOST_CHECK_NE(payload2.get(), nullptr);
 }
+
+BOOST_AUTO_TEST_CASE(RouteMatchingTable)
+{
+  using namespace o2::framework::data_matcher;
+  // A wildcard has precedence over the concrete routes after it, but not on
+  // the ones before.
+  std::vector<InputRoute> inputs = {
+    InputRoute{InputSpec{"clusters", "TPC", "CLUSTERS", 0}, 0, "Fake", 0},
+    InputRoute{InputSpec{"tpc", o2::header::DataOrigin{"TPC"}}, 1, "Fake", 0},
+    InputRoute{InputSpec{"tracks", "TPC", "TRACKS", 0}, 2, "Fake", 0},
+    InputRoute{InputSpec{"its", "ITS", "CLUSTERS", 0}, 3, "Fake", 0},
+    InputRoute{InputSpec{"its2", "ITS", "CLUSTERS", 0}, 4, "Fake", 0}};
+
+  auto index = DataRelayerHelpers::createDistinctRouteIndex(inputs);
+  auto matchers = DataRelayerHelpers::createInputMatchers(inputs);
+  auto table = DataRelayerHelpers::createRouteMatchingTable(inputs, index);
+  BOOST_CHECK_EQUAL(table.concrete.size(), 3);
+  BOOST_REQUIRE_EQUAL(table.wildcards.size(), 1);
+  BOOST_CHECK_EQUAL(table.wildcards[0], 1);
+
+  auto match = [&](char const* origin, char const* description, DataHeader::SubSpecificationType subSpec) {
+    DataHeader dh;
+    dh.dataOrigin = origin;
+    dh.dataDescription = description;
+    dh.subSpecification = subSpec;
+    Stack stack{dh, DataProcessingHeader{3, 1}};
+    VariableContext context;
+    auto ri = DataRelayerHelpers::matchToContext(table, reinterpret_cast<char const*>(stack.data()), matchers, index, context);
+    if (ri != (size_t)-1) {
+      auto startTime = std::get_if<uint64_t>(&context.get(0));
+      BOOST_REQUIRE(startTime != nullptr);
+      BOOST_CHECK_EQUAL(*startTime, 3);
+    }
+    return ri;
+  };
+
+  BOOST_CHECK_EQUAL(match("TPC", "CLUSTERS", 0), 0);
+  BOOST_CHECK_EQUAL(match("TPC", "TRACKS", 0), 1);
+  BOOST_CHECK_EQUAL(match("TPC", "DIGITS", 1), 1);
+  BOOST_CHECK_EQUAL(match("ITS", "CLUSTERS", 0), 3);
+  BOOST_CHECK_EQUAL(match("ITS", "CLUSTERS", 1), (size_t)-1);
+}
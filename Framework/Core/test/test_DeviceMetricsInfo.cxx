@@ -14,7 +14,10 @@
 
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "../src/DeviceMetricsRing.h"
 #include <boost/test/unit_test.hpp>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <iostream>
 #include <regex>
 #include <string_view>
@@ -223,3 +226,51 @@ BOOST_AUTO_TEST_CASE(TestHelpers)
   BOOST_CHECK_EQUAL(metric2, 0);
   BOOST_CHECK_EQUAL(metric3, 1);
 }
+
+BOOST_AUTO_TEST_CASE(TestMetricsRing)
+{
+  using namespace o2::framework;
+  auto ring = DeviceMetricsRing::create("", 3);
+  BOOST_REQUIRE(ring.get() != nullptr);
+  BOOST_CHECK_EQUAL(ring->capacity(), 4);
+
+  // The producer lives in a different process, like a device.
+  pid_t pid = fork();
+  if (pid == 0) {
+    bool ok = ring->push("bkey", 12, 1789372894);
+    ok &= ring->push("akey", 16.0f, 1789372895);
+    ok &= ring->push("ckey", (uint64_t)1 << 40, 1789372896);
+    ok &= ring->push("bkey", 13, 1789372897);
+    // Full: the device falls back to text.
+    ok &= ring->push("bkey", 14, 1789372898) == false;
+    ok &= ring->push(std::string(BinaryMetric::MAX_KEY_SIZE + 1, 'x'), 1, 1789372899) == false;
+    _exit(ok ? 0 : 1);
+  }
+  int status = 0;
+  waitpid(pid, &status, 0);
+  BOOST_REQUIRE(WIFEXITED(status));
+  BOOST_CHECK_EQUAL(WEXITSTATUS(status), 0);
+
+  DeviceMetricsInfo info;
+  size_t newMetrics = 0;
+  auto callback = [&newMetrics](std::string const&, MetricInfo const&, int, size_t) { ++newMetrics; };
+  BOOST_CHECK_EQUAL(ring->drain(info, callback), 4);
+  BOOST_CHECK_EQUAL(newMetrics, 3);
+  BOOST_REQUIRE_EQUAL(info.metrics.size(), 3);
+  BOOST_CHECK_EQUAL(std::string(info.metricLabels[0].label), "bkey");
+  BOOST_CHECK(info.metrics[0].type == MetricType::Int);
+  BOOST_CHECK_EQUAL(info.metrics[0].filledMetrics, 2);
+  BOOST_CHECK_EQUAL(info.intMetrics[0][0], 12);
+  BOOST_CHECK_EQUAL(info.intMetrics[0][1], 13);
+  BOOST_CHECK_EQUAL(info.timestamps[0][1], 1789372897);
+  BOOST_CHECK(info.metrics[1].type == MetricType::Float);
+  BOOST_CHECK_EQUAL(info.floatMetrics[0][0], 16.0f);
+  BOOST_CHECK(info.metrics[2].type == MetricType::Uint64);
+  BOOST_CHECK_EQUAL(info.uint64Metrics[0][0], (uint64_t)1 << 40);
+
+  // Space is available again once drained.
+  BOOST_CHECK(ring->push("bkey", 14, 1789372898));
+  BOOST_CHECK_EQUAL(ring->drain(info), 1);
+  BOOST_CHECK_EQUAL(ring->drain(info), 0);
+  BOOST_CHECK_EQUAL(info.metrics[0].filledMetrics, 3);
+}
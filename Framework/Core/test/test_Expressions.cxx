@@ -203,3 +203,16 @@ BOOST_AUTO_TEST_CASE(TestGandivaTreeCreation)
   BOOST_REQUIRE(s.ok());
 #endif
 }
+
+BOOST_AUTO_TEST_CASE(TestHashExpression)
+{
+  Filter f1 = o2::aod::track::pt > 0.1234567f;
+  Filter f2 = o2::aod::track::pt > 0.1234568f;
+  Filter f3 = o2::aod::track::pt > 0.1234567f;
+  BOOST_CHECK_NE(hashExpression(f1), hashExpression(f2));
+  BOOST_CHECK_EQUAL(hashExpression(f1), hashExpression(f3));
+
+  Filter d1 = o2::aod::track::pt > 0.12345678901;
+  Filter d2 = o2::aod::track::pt > 0.12345678902;
+  BOOST_CHECK_NE(hashExpression(d1), hashExpression(d2));
+}
@@ -74,6 +74,40 @@ BOOST_AUTO_TEST_CASE(HistogramRegistryLookup)
   */
 }
 
+BOOST_AUTO_TEST_CASE(HistogramRegistryShadows)
+{
+  HistogramRegistry registry{"registry", {{"eta", "#Eta", {HistType::kTH1F, {{100, -2.0, 2.0}}}}}};
+  registry.createShadows(2);
+
+  /// fills from the processing slot 0 go to the registry, from the others to their shadow
+  registry.fill(HIST("eta"), 0.5);
+  ProcessingSlot::current() = 1;
+  registry.fill(HIST("eta"), 0.5);
+  registry.fill(HIST("eta"), -0.5);
+  ProcessingSlot::current() = 2;
+  registry.fill(HIST("eta"), 1.5);
+  ProcessingSlot::current() = -1;
+  BOOST_CHECK_EQUAL(registry.get<TH1>(HIST("eta"))->GetEntries(), 1);
+
+  /// merging moves the content of the shadows to the registry and resets them
+  registry.mergeShadows();
+  BOOST_CHECK_EQUAL(registry.get<TH1>(HIST("eta"))->GetEntries(), 4);
+  BOOST_CHECK_EQUAL(registry.get<TH1>(HIST("eta"))->GetBinContent(registry.get<TH1>(HIST("eta"))->FindBin(0.5)), 2);
+  registry.mergeShadows();
+  BOOST_CHECK_EQUAL(registry.get<TH1>(HIST("eta"))->GetEntries(), 4);
+
+  /// histograms added later get their shadows with the next call
+  registry.add("phi", "#Phi", {HistType::kTH1F, {{100, 0., 6.3}}});
+  registry.createShadows(2);
+  ProcessingSlot::current() = 2;
+  registry.fill(HIST("phi"), 1.);
+  ProcessingSlot::current() = -1;
+  BOOST_CHECK_EQUAL(registry.get<TH1>(HIST("phi"))->GetEntries(), 0);
+  registry.mergeShadows();
+  BOOST_CHECK_EQUAL(registry.get<TH1>(HIST("phi"))->GetEntries(), 1);
+  BOOST_CHECK_EQUAL(registry.get<TH1>(HIST("eta"))->GetEntries(), 4);
+}
+
 BOOST_AUTO_TEST_CASE(HistogramRegistryExpressionFill)
 {
   TableBuilder builderA;
@@ -107,6 +141,34 @@ BOOST_AUTO_TEST_CASE(HistogramRegistryExpressionFill)
   /// Fill histogram with expression and table
   registry.fill<test::X, test::Y>(HIST("xy"), tests, test::x > 3.0f && test::y > -5.0f);
   BOOST_CHECK_EQUAL(registry.get<TH2>(HIST("xy"))->GetEntries(), 2);
+
+  /// Table fill with fixed binning must give the same result as filling row by row
+  HistogramRegistry reference{
+    "reference", {
+                   {"xy", "test xy", {HistType::kTH2F, {{100, -10.0f, 10.01f}, {100, -10.0f, 10.01f}}}}, //
+                   {"xyw", "test xyw", {HistType::kTH2F, {{7, 0.0f, 5.0f}, {3, -5.0f, 0.0f}}}}           //
+                 }                                                                                       //
+  };
+  registry.add("xyw", "test xyw", kTH2F, {{7, 0.0f, 5.0f}, {3, -5.0f, 0.0f}});
+  registry.fill<test::X, test::Y, test::X>(HIST("xyw"), tests, test::x >= 0.0f);
+  for (auto& t : tests) {
+    if (t.x() > 3.0f && t.y() > -5.0f) {
+      reference.fill(HIST("xy"), t.x(), t.y());
+    }
+    reference.fill(HIST("xyw"), t.x(), t.y(), t.x());
+  }
+  auto compare = [](TH2* lhs, TH2* rhs) {
+    BOOST_CHECK_EQUAL(lhs->GetEntries(), rhs->GetEntries());
+    BOOST_CHECK_EQUAL(lhs->GetSumw2N(), rhs->GetSumw2N());
+    for (int bin = 0; bin < lhs->GetNcells(); ++bin) {
+      BOOST_CHECK_EQUAL(lhs->GetBinContent(bin), rhs->GetBinContent(bin));
+      BOOST_CHECK_EQUAL(lhs->GetBinError(bin), rhs->GetBinError(bin));
+    }
+    BOOST_CHECK_CLOSE(lhs->GetMean(1), rhs->GetMean(1), 1e-6);
+    BOOST_CHECK_CLOSE(lhs->GetRMS(2), rhs->GetRMS(2), 1e-6);
+  };
+  compare(registry.get<TH2>(HIST("xy")).get(), reference.get<TH2>(HIST("xy")).get());
+  compare(registry.get<TH2>(HIST("xyw")).get(), reference.get<TH2>(HIST("xyw")).get());
 }
 
 BOOST_AUTO_TEST_CASE(HistogramRegistryStepTHn)
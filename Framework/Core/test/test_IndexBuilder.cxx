@@ -133,3 +133,74 @@ BOOST_AUTO_TEST_CASE(TestIndexBuilder)
     ++i;
   }
 }
+
+BOOST_AUTO_TEST_CASE(TestIndexBuilderUnsorted)
+{
+  TableBuilder b1;
+  auto w1 = b1.cursor<Points>();
+  TableBuilder b2;
+  auto w2 = b2.cursor<Distances>();
+  TableBuilder b3;
+  auto w3 = b3.cursor<Flags>();
+  TableBuilder b4;
+  auto w4 = b4.cursor<Categorys>();
+
+  for (auto i = 0; i < 10; ++i) {
+    w1(0, i * 2., i * 3., i * 4.);
+  }
+
+  std::array<int, 7> d{9, 0, 4, 2, 8, 1, 7};
+  std::array<int, 6> f{8, 5, 0, 2, 1, -1};
+  std::array<int, 8> c{3, 7, 0, 5, 8, 2, 1, 1};
+
+  for (auto i : d) {
+    w2(0, i, i * 10.);
+  }
+
+  for (auto i : f) {
+    w3(0, i, static_cast<bool>(i % 2));
+  }
+
+  for (auto i : c) {
+    w4(0, i, i + 2);
+  }
+
+  auto t1 = b1.finalize();
+  Points st1{t1};
+  auto t2 = b2.finalize();
+  Distances st2{t2};
+  auto t3 = b3.finalize();
+  Flags st3{t3};
+  auto t4 = b4.finalize();
+  Categorys st4{t4};
+
+  auto t5 = IndexExclusive::indexBuilder(typename IDXs::persistent_columns_t{}, st1, std::tie(st1, st2, st3, st4));
+  BOOST_REQUIRE_EQUAL(t5->num_rows(), 4);
+  IDXs idxt{t5};
+  idxt.bindExternalIndices(&st1, &st2, &st3, &st4);
+  std::array<int, 4> ps{0, 1, 2, 8};
+  auto i = 0;
+  for (auto& row : idxt) {
+    BOOST_REQUIRE_EQUAL(row.pointId(), ps[i]);
+    BOOST_REQUIRE(row.distance().pointId() == row.pointId());
+    BOOST_REQUIRE(row.flag().pointId() == row.pointId());
+    BOOST_REQUIRE(row.category().pointId() == row.pointId());
+    ++i;
+  }
+
+  auto t6 = IndexSparse::indexBuilder(typename IDX2s::persistent_columns_t{}, st1, std::tie(st2, st1, st3, st4));
+  BOOST_REQUIRE_EQUAL(t6->num_rows(), st2.size());
+  IDX2s idxs{t6};
+  // the first Categorys row pointing to a given Point is used
+  std::array<int, 7> fs{-1, 2, -1, 3, 0, 4, -1};
+  std::array<int, 7> cs{-1, 2, -1, 5, 4, 6, 1};
+  idxs.bindExternalIndices(&st1, &st2, &st3, &st4);
+  i = 0;
+  for (auto const& row : idxs) {
+    BOOST_REQUIRE_EQUAL(row.distanceId(), i);
+    BOOST_REQUIRE_EQUAL(row.pointId(), d[i]);
+    BOOST_REQUIRE_EQUAL(row.flagId(), fs[i]);
+    BOOST_REQUIRE_EQUAL(row.categoryId(), cs[i]);
+    ++i;
+  }
+}
@@ -161,6 +161,67 @@ BOOST_AUTO_TEST_CASE(TestInputRecord)
   BOOST_CHECK(record.end().begin() == record.end().end());
 }
 
+BOOST_AUTO_TEST_CASE(TestInputBinding)
+{
+  InputSpec spec1{"x", "TPC", "CLUSTERS", 0, Lifetime::Timeframe};
+  InputSpec spec2{"y", "ITS", "CLUSTERS", 0, Lifetime::Timeframe};
+  std::vector<InputRoute> schema = {
+    InputRoute{spec1, 0, "x_source"},
+    InputRoute{spec2, 1, "y_source"}};
+
+  InputBinding x{"x"};
+  InputBinding y{"y"};
+  InputBinding missing{"err"};
+  BOOST_CHECK_EQUAL(x.resolved(), false);
+  BOOST_CHECK_EQUAL(y.resolve(schema), true);
+  BOOST_CHECK_EQUAL(y.pos, 1);
+  BOOST_CHECK_EQUAL(missing.resolve(schema), false);
+
+  // "y" comes in three parts, with one, two and three elements.
+  std::vector<std::vector<void*>> inputs(2);
+  auto createMessage = [&inputs](size_t pos, DataHeader dh, std::vector<int> const& values) {
+    dh.payloadSize = values.size() * sizeof(int);
+    DataProcessingHeader dph{0, 1};
+    Stack stack{dh, dph};
+    void* header = malloc(stack.size());
+    void* payload = malloc(dh.payloadSize);
+    memcpy(header, stack.data(), stack.size());
+    memcpy(payload, values.data(), dh.payloadSize);
+    inputs[pos].emplace_back(header);
+    inputs[pos].emplace_back(payload);
+  };
+  DataHeader dh;
+  dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+  createMessage(0, dh, {7});
+  createMessage(1, dh, {1});
+  createMessage(1, dh, {2, 3});
+  createMessage(1, dh, {4, 5, 6});
+
+  InputSpan span{[&inputs](size_t i, size_t part) { return DataRef{nullptr, static_cast<char const*>(inputs[i][2 * part]), static_cast<char const*>(inputs[i][2 * part + 1])}; },
+                 [&inputs](size_t i) { return inputs[i].size() / 2; },
+                 inputs.size()};
+  InputRecord record{schema, span};
+
+  // Unresolved bindings are looked up by name.
+  BOOST_CHECK_EQUAL(record.get<int>(x), 7);
+  BOOST_CHECK_EQUAL(record.get<int>(y), 1);
+  BOOST_CHECK_EQUAL(record.get(y, 2).payload, record.getByPos(1, 2).payload);
+  BOOST_CHECK_EXCEPTION(record.get(missing), RuntimeErrorRef, any_exception);
+
+  auto spans = record.getSpans<int>(y);
+  BOOST_REQUIRE_EQUAL(spans.size(), 3);
+  BOOST_CHECK_EQUAL(spans[0].size(), 1);
+  BOOST_CHECK_EQUAL(spans[1].size(), 2);
+  BOOST_CHECK_EQUAL(spans[2][2], 6);
+  BOOST_CHECK_EQUAL(record.getSpans<int>("x").size(), 1);
+
+  for (auto& input : inputs) {
+    for (auto& buffer : input) {
+      free(buffer);
+    }
+  }
+}
+
 // TODO:
 // - test all `get` implementations
 // - create a list of supported types and check that the API compiles
@@ -78,3 +78,50 @@ BOOST_AUTO_TEST_CASE(TestSlicingFramework)
     BOOST_REQUIRE_EQUAL(slices[i].table()->num_rows(), sizes[i]);
   }
 }
+
+BOOST_AUTO_TEST_CASE(TestGroupingFramework)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t, int32_t>({"x", "y"});
+
+  rowWriter(0, -1, 3);
+  rowWriter(0, 1, 4);
+  rowWriter(0, 1, 5);
+  rowWriter(0, 1, 6);
+  rowWriter(0, 1, 7);
+  rowWriter(0, 2, 7);
+  rowWriter(0, -1, 2);
+  rowWriter(0, 4, 8);
+  rowWriter(0, 5, 9);
+  rowWriter(0, 5, 10);
+  auto table = builder.finalize();
+
+  std::vector<uint64_t> offsets;
+  std::vector<int> sizes;
+  auto status = groupByColumn<int32_t>("x", table, 12, &offsets, &sizes);
+  BOOST_REQUIRE(status.ok());
+  BOOST_REQUIRE_EQUAL(offsets.size(), 12);
+  BOOST_REQUIRE_EQUAL(sizes.size(), 12);
+  std::array<int, 12> expectedSizes{0, 4, 1, 0, 1, 2, 0, 0, 0, 0, 0, 0};
+  std::array<uint64_t, 12> expectedOffsets{0, 1, 5, 6, 7, 8, 10, 10, 10, 10, 10, 10};
+  for (auto i = 0u; i < sizes.size(); ++i) {
+    BOOST_CHECK_EQUAL(sizes[i], expectedSizes[i]);
+    BOOST_CHECK_EQUAL(offsets[i], expectedOffsets[i]);
+  }
+
+  /// unsorted index or index out of range are refused
+  BOOST_CHECK(groupByColumn<int32_t>("y", table, 12, &offsets, &sizes).ok() == false);
+  BOOST_CHECK(groupByColumn<int32_t>("x", table, 5, &offsets, &sizes).ok() == false);
+
+  /// unassigned rows inside a group would be part of its slice, so they are
+  /// refused as well
+  TableBuilder builder2;
+  auto rowWriter2 = builder2.persist<int32_t>({"x"});
+  rowWriter2(0, 1);
+  rowWriter2(0, -1);
+  rowWriter2(0, 1);
+  auto table2 = builder2.finalize();
+  status = groupByColumn<int32_t>("x", table2, 3, &offsets, &sizes);
+  BOOST_CHECK(status.ok() == false);
+  BOOST_CHECK(status.IsInvalid());
+}
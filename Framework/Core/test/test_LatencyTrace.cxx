@@ -0,0 +1,105 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework LatencyTrace
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/DataProcessingDevice.h"
+#include "Framework/LatencyTraceHeader.h"
+#include "Framework/LatencyTraceHelpers.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include "Headers/Stack.h"
+#include <boost/test/unit_test.hpp>
+#include <fmt/format.h>
+#include <sstream>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestLatencyTraceHeader)
+{
+  LatencyTraceHeader trace;
+  for (uint32_t i = 0; i < LatencyTraceHeader::MAX_HOPS + 2; ++i) {
+    trace.addHop({i, 0, i * 10, i * 10 + 1, i * 10 + 2});
+  }
+  BOOST_CHECK_EQUAL(trace.hopsCount, LatencyTraceHeader::MAX_HOPS);
+  BOOST_CHECK_EQUAL(trace.droppedHops, 2);
+  BOOST_CHECK_EQUAL(trace.hops[0].device, 2);
+  BOOST_CHECK_EQUAL(trace.hops[LatencyTraceHeader::MAX_HOPS - 1].device, LatencyTraceHeader::MAX_HOPS + 1);
+
+  o2::header::DataHeader dh;
+  o2::header::Stack stack{dh, trace};
+  auto found = o2::header::get<LatencyTraceHeader*>(stack.data());
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->hopsCount, trace.hopsCount);
+  BOOST_CHECK_EQUAL(found->hops[0].start, 21);
+  BOOST_CHECK(LatencyTraceHeader::deviceHash("producer") != LatencyTraceHeader::deviceHash("consumer"));
+}
+
+BOOST_AUTO_TEST_CASE(TestLatencyArrivals)
+{
+  LatencyArrivals arrivals;
+  int first = 0;
+  int second = 0;
+  arrivals.add(&first, 10);
+  arrivals.add(&second, 20);
+  BOOST_CHECK_EQUAL(arrivals.take(&first), 10);
+  BOOST_CHECK_EQUAL(arrivals.take(&first), 0);
+
+  // Entries which are never taken, e.g. of dropped inputs, are eventually forgotten.
+  arrivals.add(&first, 61000000000ull);
+  BOOST_CHECK_EQUAL(arrivals.byHeader.size(), 1);
+  BOOST_CHECK_EQUAL(arrivals.take(&second), 0);
+  BOOST_CHECK_EQUAL(arrivals.take(&first), 61000000000ull);
+}
+
+BOOST_AUTO_TEST_CASE(TestLatencyTraceHelpers)
+{
+  std::vector<DeviceSpec> specs(3);
+  specs[0].id = "producer";
+  specs[1].id = "processor";
+  specs[2].id = "sink";
+  auto edgeName = [](std::string const& from, std::string const& to) {
+    return fmt::format("latency-edge-{:08x}-{:08x}", LatencyTraceHeader::deviceHash(from), LatencyTraceHeader::deviceHash(to));
+  };
+
+  // Two sinks report the same edge, so the samples are merged.
+  std::vector<DeviceMetricsInfo> metrics(3);
+  auto fromSink = DeviceMetricsHelper::createNumericMetric<int>(metrics[2], edgeName("producer", "processor").c_str());
+  auto fromOtherSink = DeviceMetricsHelper::createNumericMetric<int>(metrics[1], edgeName("producer", "processor").c_str());
+  auto slowEdge = DeviceMetricsHelper::createNumericMetric<int>(metrics[2], edgeName("processor", "sink").c_str());
+  auto path = DeviceMetricsHelper::createNumericMetric<int>(metrics[2], fmt::format("latency-path-{:08x}-{:08x}-{:08x}", LatencyTraceHeader::deviceHash("producer"), LatencyTraceHeader::deviceHash("processor"), LatencyTraceHeader::deviceHash("sink")).c_str());
+  for (int i = 1; i <= 50; ++i) {
+    fromSink(metrics[2], i, i);
+    fromOtherSink(metrics[1], 50 + i, i);
+    slowEdge(metrics[2], 1000, i);
+    path(metrics[2], 2000 + i, i);
+  }
+
+  auto edges = LatencyTraceHelpers::edges(specs, metrics);
+  BOOST_REQUIRE_EQUAL(edges.size(), 2);
+  BOOST_CHECK_EQUAL(edges[0].devices[0], "processor");
+  BOOST_CHECK_EQUAL(edges[0].devices[1], "sink");
+  BOOST_CHECK_EQUAL(edges[0].p99, 1000);
+  BOOST_CHECK_EQUAL(edges[1].devices[0], "producer");
+  BOOST_CHECK_EQUAL(edges[1].samples, 100);
+  BOOST_CHECK_EQUAL(edges[1].p50, 50);
+  BOOST_CHECK_EQUAL(edges[1].p99, 99);
+
+  auto paths = LatencyTraceHelpers::paths(specs, metrics);
+  BOOST_REQUIRE_EQUAL(paths.size(), 1);
+  BOOST_CHECK_EQUAL(paths[0].devices.size(), 3);
+  BOOST_CHECK_EQUAL(paths[0].devices[2], "sink");
+  BOOST_CHECK_EQUAL(paths[0].p50, 2025);
+
+  std::ostringstream out;
+  LatencyTraceHelpers::dumpToJSON(out, edges, paths);
+  BOOST_CHECK(out.str().find("\"processor\"") != std::string::npos);
+}
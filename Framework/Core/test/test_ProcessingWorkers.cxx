@@ -0,0 +1,49 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework ProcessingWorkers
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include "Framework/ProcessingWorkers.h"
+#include "Framework/ProcessingSlot.h"
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+using namespace o2::framework;
+
+BOOST_AUTO_TEST_CASE(TestProcessingWorkers)
+{
+  ProcessingWorkers workers(4);
+  BOOST_REQUIRE_EQUAL(workers.size(), 4);
+  std::vector<long> perSlot(workers.size());
+  // The same threads are reused for every timeframe
+  for (int tf = 0; tf < 100; ++tf) {
+    std::atomic<int> nextGroup{0};
+    workers.run([&]() {
+      for (int group = nextGroup++; group < 1000; group = nextGroup++) {
+        perSlot[ProcessingSlot::current()] += group;
+      }
+    });
+  }
+  BOOST_CHECK_EQUAL(std::accumulate(perSlot.begin(), perSlot.end(), 0l), 100l * 999 * 1000 / 2);
+  BOOST_CHECK_EQUAL(ProcessingSlot::current(), -1);
+
+  // Errors in any of the workers are reported to the caller
+  BOOST_CHECK_THROW(workers.run([]() {
+    if (ProcessingSlot::current() == 2) {
+      throw std::runtime_error("failed");
+    }
+  }),
+                    std::runtime_error);
+  workers.run([]() {});
+}
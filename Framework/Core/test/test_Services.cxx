@@ -21,6 +21,7 @@
 #include <options/FairMQProgOptions.h>
 #include <iostream>
 #include <memory>
+#include <thread>
 
 BOOST_AUTO_TEST_CASE(TestServiceRegistry)
 {
@@ -184,3 +185,46 @@ BOOST_AUTO_TEST_CASE(TestServiceDeclaration)
   BOOST_CHECK(registry.active<CallbackService>() == true);
   BOOST_CHECK(registry.active<DummyService>() == false);
 }
+
+BOOST_AUTO_TEST_CASE(TestStreamRegistry)
+{
+  using namespace o2::framework;
+  ServiceRegistry registry;
+  DeviceState state;
+  FairMQProgOptions options;
+
+  static int created = 0;
+  ServiceSpec spec;
+  spec.name = "dummy-stream";
+  spec.init = [](ServiceRegistry&, DeviceState&, fair::mq::ProgOptions&) -> ServiceHandle {
+    return ServiceHandle{TypeIdHelpers::uniqueId<DummyService>(), new DummyService{created++}};
+  };
+  spec.configure = CommonServices::noConfiguration();
+  spec.preProcessing = [](ProcessingContext&, void*) {};
+  spec.kind = ServiceKind::Serial;
+
+  registry.declareService(spec, state, options);
+  registry.declareService(CommonServices::callbacksSpec(), state, options);
+  auto& mainService = registry.get<DummyService>();
+  BOOST_CHECK_EQUAL(mainService.threadId, 0);
+
+  auto streamRegistry = registry.createStreamRegistry(state, options, {"dummy-stream"});
+  auto& streamService = streamRegistry->get<DummyService>();
+  BOOST_CHECK_EQUAL(streamService.threadId, 1);
+  // The main registry is untouched, also for other threads
+  BOOST_CHECK_EQUAL(&registry.get<DummyService>(), &mainService);
+  DummyService* fromOtherThread[2] = {nullptr, nullptr};
+  std::thread([&]() {
+    fromOtherThread[0] = &registry.get<DummyService>();
+    fromOtherThread[1] = &streamRegistry->get<DummyService>();
+  }).join();
+  BOOST_CHECK_EQUAL(fromOtherThread[0], &mainService);
+  BOOST_CHECK_EQUAL(fromOtherThread[1], &streamService);
+  // Other services are shared
+  BOOST_CHECK_EQUAL(&streamRegistry->get<CallbackService>(), &registry.get<CallbackService>());
+
+  // Callbacks are bound to the instance of the stream
+  BOOST_REQUIRE_EQUAL(streamRegistry->mPreProcessingHandles.size(), 1);
+  BOOST_CHECK_EQUAL(streamRegistry->mPreProcessingHandles[0].service, &streamService);
+  BOOST_CHECK_EQUAL(registry.mPreProcessingHandles[0].service, &mainService);
+}
@@ -185,6 +185,36 @@ BOOST_AUTO_TEST_CASE(TestTableBuilderBulk)
   }
 }
 
+BOOST_AUTO_TEST_CASE(TestTableBuilderColumnar)
+{
+  using namespace o2::framework;
+  TableBuilder builder;
+  auto columnWriter = builder.columnarPersist<float, bool, int[2]>({"x", "flag", "pos"}, 8);
+  float x[] = {0, 1, 2, 3, 4, 5, 6, 7};
+  bool flag[] = {true, false, true, false, true, false, true, false};
+  int pos[] = {0, 0, 1, 10, 2, 20, 3, 30, 4, 40, 5, 50, 6, 60, 7, 70};
+
+  columnWriter(0, 5, x, flag, pos);
+  columnWriter(0, 3, x + 5, flag + 5, pos + 10);
+
+  auto table = builder.finalize();
+  BOOST_REQUIRE_EQUAL(table->num_columns(), 3);
+  BOOST_REQUIRE_EQUAL(table->num_rows(), 8);
+  BOOST_REQUIRE_EQUAL(table->schema()->field(0)->type()->id(), arrow::float32()->id());
+  BOOST_REQUIRE_EQUAL(table->schema()->field(1)->type()->id(), arrow::boolean()->id());
+  BOOST_REQUIRE_EQUAL(table->schema()->field(2)->type()->id(), arrow::fixed_size_list(arrow::int32(), 2)->id());
+
+  auto xs = std::static_pointer_cast<arrow::FloatArray>(table->column(0)->chunk(0));
+  auto flags = std::static_pointer_cast<arrow::BooleanArray>(table->column(1)->chunk(0));
+  auto values = std::static_pointer_cast<arrow::FixedSizeListArray>(table->column(2)->chunk(0))->values()->data()->GetValues<int>(1);
+  for (size_t i = 0; i < 8; ++i) {
+    BOOST_CHECK_EQUAL(xs->Value(i), i);
+    BOOST_CHECK_EQUAL(flags->Value(i), i % 2 == 0);
+    BOOST_CHECK_EQUAL(values[2 * i], i);
+    BOOST_CHECK_EQUAL(values[2 * i + 1], 10 * i);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(TestTableBuilderMore)
 {
   using namespace o2::framework;
@@ -98,3 +98,83 @@ BOOST_AUTO_TEST_CASE(TestLRUReplacement)
     BOOST_CHECK(action == TimesliceIndex::ActionTaken::Wait);
   }
 }
+
+BOOST_AUTO_TEST_CASE(TestPendingSlotsAreKept)
+{
+  using namespace o2::framework;
+  TimesliceIndex index;
+  index.resize(2);
+  index.setBackpressurePolicy(TimesliceIndex::BackpressureOp::DropAncient);
+  data_matcher::VariableContext context;
+
+  for (uint64_t timestamp : {10, 20}) {
+    context.put({0, timestamp});
+    context.commit();
+    auto [action, slot] = index.replaceLRUWith(context);
+    BOOST_CHECK(action == TimesliceIndex::ActionTaken::ReplaceUnused);
+  }
+  index.markAsPending({0}, true);
+  BOOST_CHECK(index.isPending({0}));
+  BOOST_CHECK(index.isPending({1}) == false);
+  {
+    // The oldest slot is waiting to be processed, so the next one is dropped.
+    context.put({0, uint64_t{30}});
+    context.commit();
+    auto [action, slot] = index.replaceLRUWith(context);
+    BOOST_CHECK(action == TimesliceIndex::ActionTaken::ReplaceObsolete);
+    BOOST_CHECK_EQUAL(slot.index, 1);
+    BOOST_CHECK_EQUAL(index.getTimesliceForSlot({0}).value, 10);
+  }
+  index.markAsPending({1}, true);
+  {
+    context.put({0, uint64_t{40}});
+    context.commit();
+    auto [action, slot] = index.replaceLRUWith(context);
+    BOOST_CHECK(action == TimesliceIndex::ActionTaken::Wait);
+    BOOST_CHECK_EQUAL(slot.index, TimesliceSlot::INVALID);
+  }
+  // Taking the inputs of a slot makes it available again.
+  index.markAsInvalid({0});
+  BOOST_CHECK(index.isPending({0}) == false);
+  {
+    auto [action, slot] = index.replaceLRUWith(context);
+    BOOST_CHECK(action == TimesliceIndex::ActionTaken::ReplaceUnused);
+    BOOST_CHECK_EQUAL(slot.index, 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestDangling)
+{
+  using namespace o2::framework;
+  TimesliceIndex index;
+  index.resize(2);
+  BOOST_CHECK(index.isDangling({0}, 100) == false);
+  BOOST_CHECK_EQUAL(index.getEarliestCheck(), ExpirationHandler::NEVER);
+  index.associate(TimesliceId{10}, TimesliceSlot{0});
+  BOOST_CHECK(index.isDangling({0}, 0));
+  BOOST_CHECK(index.isDangling({1}, 100) == false);
+  BOOST_CHECK_EQUAL(index.getEarliestCheck(), 0);
+  index.markAsDangling({0}, 50);
+  BOOST_CHECK(index.isDangling({0}, 49) == false);
+  BOOST_CHECK(index.isDangling({0}, 50));
+  index.updateEarliestCheck();
+  BOOST_CHECK_EQUAL(index.getEarliestCheck(), 50);
+  index.markAsDangling({0}, ExpirationHandler::NEVER);
+  index.updateEarliestCheck();
+  BOOST_CHECK(index.isDangling({0}, 100) == false);
+  BOOST_CHECK_EQUAL(index.getEarliestCheck(), ExpirationHandler::NEVER);
+  index.markAsDangling({0}, 0);
+  index.markAsInvalid({0});
+  BOOST_CHECK(index.isDangling({0}, 100) == false);
+  // Only recomputed on request, so it can be earlier than needed.
+  BOOST_CHECK_EQUAL(index.getEarliestCheck(), 0);
+  index.updateEarliestCheck();
+  BOOST_CHECK_EQUAL(index.getEarliestCheck(), ExpirationHandler::NEVER);
+
+  data_matcher::VariableContext context;
+  context.put({0, uint64_t{20}});
+  context.commit();
+  auto [action, slot] = index.replaceLRUWith(context);
+  BOOST_CHECK(action == TimesliceIndex::ActionTaken::ReplaceUnused);
+  BOOST_CHECK(index.isDangling(slot, 0));
+}
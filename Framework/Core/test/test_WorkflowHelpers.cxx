@@ -18,6 +18,7 @@
 #include "Framework/WorkflowSpec.h"
 #include "Framework/DataSpecUtils.h"
 #include "Framework/SimpleOptionsRetriever.h"
+#include "Framework/RuntimeError.h"
 #include "../src/WorkflowHelpers.h"
 #include <boost/test/unit_test.hpp>
 #include <boost/test/tools/detail/per_element_manip.hpp>
@@ -591,3 +592,66 @@ BOOST_AUTO_TEST_CASE(TestOriginWildcard)
     BOOST_CHECK_EQUAL(inActions[ai].requiresNewChannel, expectedInActions[ai].requiresNewChannel);
   }
 }
+
+BOOST_AUTO_TEST_CASE(TestShareSpawnedTables)
+{
+  WorkflowSpec workflow{
+    {"A",
+     {InputSpec{"x", "AOD", "BASE"}},
+     {OutputSpec{{"ext"}, "AOD", "BASEEXT"}, OutputSpec{"TST", "A1"}},
+     AlgorithmSpec{},
+     {},
+     CommonServices::defaultServices(),
+     {{"spawns:BASEEXT:1234"}}},
+    {"B",
+     {InputSpec{"x", "AOD", "BASE"}},
+     {OutputSpec{{"ext"}, "AOD", "BASEEXT"}},
+     AlgorithmSpec{},
+     {},
+     CommonServices::defaultServices(),
+     {{"spawns:BASEEXT:1234"}}},
+    {"C",
+     {InputSpec{"y", "TST", "A1"}},
+     {},
+     AlgorithmSpec{}}};
+
+  WorkflowHelpers::shareSpawnedTables(workflow);
+  // The first producer keeps the output, the second consumes it
+  BOOST_REQUIRE_EQUAL(workflow[0].outputs.size(), 2);
+  BOOST_REQUIRE_EQUAL(workflow[0].inputs.size(), 1);
+  BOOST_REQUIRE_EQUAL(workflow[1].outputs.size(), 0);
+  BOOST_REQUIRE_EQUAL(workflow[1].inputs.size(), 2);
+  BOOST_CHECK_EQUAL(workflow[1].inputs[1].binding, "ext");
+  BOOST_CHECK(DataSpecUtils::match(workflow[1].inputs[1], ConcreteDataMatcher{"AOD", "BASEEXT", 0}));
+  BOOST_CHECK_EQUAL(workflow[2].inputs.size(), 1);
+
+  // Same table with a different definition
+  workflow[1].outputs.emplace_back(OutputSpec{{"ext"}, "AOD", "BASEEXT"});
+  workflow[1].labels[0].value = "spawns:BASEEXT:4321";
+  BOOST_CHECK_THROW(WorkflowHelpers::shareSpawnedTables(workflow), o2::framework::RuntimeErrorRef);
+
+  // The first spawner in workflow order depends on the second one, which
+  // must therefore keep the output to avoid a cycle.
+  WorkflowSpec dependent{
+    {"A",
+     {InputSpec{"x", "AOD", "BASE"}, InputSpec{"y", "TST", "B1"}},
+     {OutputSpec{{"ext"}, "AOD", "BASEEXT"}},
+     AlgorithmSpec{},
+     {},
+     CommonServices::defaultServices(),
+     {{"spawns:BASEEXT:1234"}}},
+    {"B",
+     {InputSpec{"x", "AOD", "BASE"}},
+     {OutputSpec{{"ext"}, "AOD", "BASEEXT"}, OutputSpec{"TST", "B1"}},
+     AlgorithmSpec{},
+     {},
+     CommonServices::defaultServices(),
+     {{"spawns:BASEEXT:1234"}}}};
+
+  WorkflowHelpers::shareSpawnedTables(dependent);
+  BOOST_REQUIRE_EQUAL(dependent[0].outputs.size(), 0);
+  BOOST_REQUIRE_EQUAL(dependent[0].inputs.size(), 3);
+  BOOST_CHECK(DataSpecUtils::match(dependent[0].inputs[2], ConcreteDataMatcher{"AOD", "BASEEXT", 0}));
+  BOOST_CHECK_EQUAL(dependent[1].outputs.size(), 2);
+  BOOST_CHECK_EQUAL(dependent[1].inputs.size(), 1);
+}
@@ -17,7 +17,7 @@
 ///
 /// * macOS 10.15 onwards os_signpost
 /// * macOS 10.14 and below (either kdebug_signpost or kdebug)
-/// * linux SystemTap
+/// * linux: the built-in SignpostRecorder, plus SystemTap when available
 ///
 /// Supported systems will have O2_SIGNPOST_API_AVAILABLE defined.
 ///
@@ -60,6 +60,38 @@ static os_log_t gDPLLog;
 #define O2_SIGNPOST_START(code, arg1, arg2, arg3, arg4) syscall(SYS_kdebug_trace, APPSDBG_CODE(DBG_MACH_CHUD, (uint32_t)code) | DBG_FUNC_START, (uintptr_t)arg1, (uintptr_t)arg2, (uintptr_t)arg3, (uintptr_t)arg4);
 #define O2_SIGNPOST_END(code, arg1, arg2, arg3, arg4) syscall(SYS_kdebug_trace, APPSDBG_CODE(DBG_MACH_CHUD, (uintptr_t)code) | DBG_FUNC_END, (uintptr_t)arg1, (uintptr_t)arg2, (uintptr_t)arg3, (uintptr_t)arg4);
 #define O2_SIGNPOST_API_AVAILABLE
+#elif defined(__linux__)
+#include "Framework/CompilerBuiltins.h"
+#include "Framework/SignpostRecorder.h"
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define O2_SIGNPOST_PROBE(name, arg1, arg2, arg3, arg4) STAP_PROBE4(dpl, name, arg1, arg2, arg3, arg4)
+#else
+#define O2_SIGNPOST_PROBE(name, arg1, arg2, arg3, arg4)
+#endif
+// The callers stringify the code before it gets expanded, so that the
+// recorded name is e.g. O2_PROBE_DATARELAYER rather than its value.
+#define O2_SIGNPOST_RECORD(phase, name, arg1, arg2, arg3, arg4)                                                                   \
+  if (O2_BUILTIN_UNLIKELY(o2::framework::SignpostRecorder::enabled())) {                                                        \
+    o2::framework::SignpostRecorder::record(phase, name, (uint64_t)(arg1), (uint64_t)(arg2), (uint64_t)(arg3), (uint64_t)(arg4)); \
+  }
+#define O2_SIGNPOST_INIT() o2::framework::SignpostRecorder::init()
+#define O2_SIGNPOST(code, arg1, arg2, arg3, arg4)           \
+  do {                                                     \
+    O2_SIGNPOST_PROBE(probe##code, arg1, arg2, arg3, arg4); \
+    O2_SIGNPOST_RECORD('I', #code, arg1, arg2, arg3, arg4); \
+  } while (0)
+#define O2_SIGNPOST_START(code, arg1, arg2, arg3, arg4)           \
+  do {                                                           \
+    O2_SIGNPOST_PROBE(start_probe##code, arg1, arg2, arg3, arg4); \
+    O2_SIGNPOST_RECORD('B', #code, arg1, arg2, arg3, arg4);       \
+  } while (0)
+#define O2_SIGNPOST_END(code, arg1, arg2, arg3, arg4)            \
+  do {                                                          \
+    O2_SIGNPOST_PROBE(stop_probe##code, arg1, arg2, arg3, arg4); \
+    O2_SIGNPOST_RECORD('E', #code, arg1, arg2, arg3, arg4);      \
+  } while (0)
+#define O2_SIGNPOST_API_AVAILABLE
 #elif (!defined(__APPLE__)) && __has_include(<sys/sdt.h>) // Dtrace support is being dropped by Apple
 #include <sys/sdt.h>
 #define O2_SIGNPOST_INIT()
@@ -0,0 +1,80 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_SIGNPOSTRECORDER_H_
+#define O2_FRAMEWORK_SIGNPOSTRECORDER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace o2::framework
+{
+
+/// A signpost as it is kept in memory until it is dumped. The name
+/// is the stringified code of the signpost, so it lives forever.
+struct SignpostRecord {
+  uint64_t timestamp;
+  char const* name;
+  uint64_t args[4];
+  char phase;
+};
+
+/// Backend for the O2_SIGNPOST macros on Linux. Every thread records its
+/// signposts in its own ring buffer, so that no locking is needed, and
+/// only the most recent RING_SIZE ones are kept. At exit the process
+/// dumps them in the Chrome trace event format, which can be opened in
+/// Perfetto (ui.perfetto.dev) or chrome://tracing.
+///
+/// Recording is enabled by setting O2_SIGNPOST_TRACE to the directory
+/// where the traces should be written. When it is not, a signpost costs
+/// a relaxed load and a branch.
+class SignpostRecorder
+{
+ public:
+  static constexpr size_t RING_SIZE = 1 << 15;
+
+  /// Enable the recording if O2_SIGNPOST_TRACE is set, dumping the
+  /// trace at exit.
+  static void init();
+  /// Enable the recording, without dumping anything at exit.
+  static void enable();
+  static bool enabled()
+  {
+    return sEnabled.load(std::memory_order_relaxed);
+  }
+
+  /// Record a signpost for the calling thread. @a phase is 'B' for the
+  /// beginning of an interval (identified by the first argument), 'E' for
+  /// its end and 'I' for a single event.
+  static void record(char phase, char const* name, uint64_t arg1, uint64_t arg2, uint64_t arg3, uint64_t arg4);
+
+  /// Name used for this process in the timeline.
+  static void setProcessName(std::string const& name);
+  /// Write all the signposts recorded by this process to @a out.
+  static void dump(FILE* out);
+  /// Where the trace of process @a pid is dumped at exit.
+  /// @return an empty string if recording is not enabled.
+  static std::string traceFile(pid_t pid);
+  /// Merge the traces written by dump in @a files in a single timeline,
+  /// skipping the ones which cannot be read.
+  /// @return the number of traces which were merged.
+  static size_t merge(std::vector<std::string> const& files, FILE* out);
+
+ private:
+  inline static std::atomic<bool> sEnabled = false;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_SIGNPOSTRECORDER_H_
@@ -0,0 +1,180 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/SignpostRecorder.h"
+
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace o2::framework
+{
+
+namespace
+{
+static_assert((SignpostRecorder::RING_SIZE & (SignpostRecorder::RING_SIZE - 1)) == 0, "RING_SIZE must be a power of two");
+
+/// Only the owning thread writes in it, the dump reads it.
+struct SignpostRing {
+  SignpostRecord records[SignpostRecorder::RING_SIZE];
+  std::atomic<uint64_t> head = 0;
+  pid_t tid = 0;
+};
+
+std::mutex gRingsMutex;
+// Rings are never deleted, so that the signposts of threads which
+// already exited are still part of the dump.
+std::vector<SignpostRing*> gRings;
+std::string gProcessName;
+std::string gTraceDirectory;
+
+SignpostRing* createRing()
+{
+  auto ring = new SignpostRing;
+#ifdef SYS_gettid
+  ring->tid = syscall(SYS_gettid);
+#else
+  static std::atomic<pid_t> lastTid = 0;
+  ring->tid = ++lastTid;
+#endif
+  std::scoped_lock<std::mutex> lock(gRingsMutex);
+  gRings.push_back(ring);
+  return ring;
+}
+
+uint64_t now()
+{
+  // CLOCK_MONOTONIC is the same for all the processes, so that the
+  // traces of the different devices can be merged as they are.
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void dumpAtExit()
+{
+  auto filename = SignpostRecorder::traceFile(getpid());
+  FILE* out = fopen(filename.c_str(), "w");
+  if (out == nullptr) {
+    fprintf(stderr, "Unable to write signposts to %s\n", filename.c_str());
+    return;
+  }
+  SignpostRecorder::dump(out);
+  fclose(out);
+}
+} // namespace
+
+void SignpostRecorder::init()
+{
+  char const* directory = getenv("O2_SIGNPOST_TRACE");
+  if (directory == nullptr || directory[0] == '\0' || enabled()) {
+    return;
+  }
+  gTraceDirectory = directory;
+  atexit(dumpAtExit);
+  enable();
+}
+
+void SignpostRecorder::enable()
+{
+  sEnabled.store(true, std::memory_order_relaxed);
+}
+
+void SignpostRecorder::record(char phase, char const* name, uint64_t arg1, uint64_t arg2, uint64_t arg3, uint64_t arg4)
+{
+  static thread_local SignpostRing* ring = createRing();
+  auto head = ring->head.load(std::memory_order_relaxed);
+  ring->records[head & (RING_SIZE - 1)] = SignpostRecord{now(), name, {arg1, arg2, arg3, arg4}, phase};
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+void SignpostRecorder::setProcessName(std::string const& name)
+{
+  std::scoped_lock<std::mutex> lock(gRingsMutex);
+  gProcessName = name;
+}
+
+std::string SignpostRecorder::traceFile(pid_t pid)
+{
+  if (gTraceDirectory.empty()) {
+    return "";
+  }
+  return gTraceDirectory + "/dpl-signposts-" + std::to_string(pid) + ".json";
+}
+
+void SignpostRecorder::dump(FILE* out)
+{
+  int pid = getpid();
+  std::scoped_lock<std::mutex> lock(gRingsMutex);
+  // One event per line, so that merge does not need to parse JSON.
+  fprintf(out, "{\"traceEvents\":[\n");
+  fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"%s\"}}\n",
+          pid, gProcessName.empty() ? "dpl" : gProcessName.c_str());
+  for (auto ring : gRings) {
+    auto head = ring->head.load(std::memory_order_acquire);
+    auto begin = head > RING_SIZE ? head - RING_SIZE : 0;
+    for (auto pos = begin; pos != head; ++pos) {
+      auto const& record = ring->records[pos & (RING_SIZE - 1)];
+      double ts = record.timestamp / 1000.;
+      switch (record.phase) {
+        case 'B':
+        case 'E':
+          // Intervals can end on a different thread, so they are async
+          // events, scoped to the process.
+          fprintf(out, ",{\"name\":\"%s\",\"cat\":\"signpost\",\"ph\":\"%c\",\"id2\":{\"local\":\"0x%" PRIx64 "\"},\"ts\":%.3f,\"pid\":%d,\"tid\":%d,"
+                       "\"args\":{\"arg2\":%" PRIu64 ",\"arg3\":%" PRIu64 ",\"color\":%" PRIu64 "}}\n",
+                  record.name, record.phase == 'B' ? 'b' : 'e', record.args[0], ts, pid, ring->tid,
+                  record.args[1], record.args[2], record.args[3]);
+          break;
+        default:
+          fprintf(out, ",{\"name\":\"%s\",\"cat\":\"signpost\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d,"
+                       "\"args\":{\"arg1\":%" PRIu64 ",\"arg2\":%" PRIu64 ",\"arg3\":%" PRIu64 ",\"arg4\":%" PRIu64 "}}\n",
+                  record.name, ts, pid, ring->tid,
+                  record.args[0], record.args[1], record.args[2], record.args[3]);
+          break;
+      }
+    }
+  }
+  fprintf(out, "]}\n");
+}
+
+size_t SignpostRecorder::merge(std::vector<std::string> const& files, FILE* out)
+{
+  size_t merged = 0;
+  bool first = true;
+  fprintf(out, "{\"traceEvents\":[\n");
+  for (auto& file : files) {
+    FILE* in = fopen(file.c_str(), "r");
+    if (in == nullptr) {
+      continue;
+    }
+    char* line = nullptr;
+    size_t size = 0;
+    while (getline(&line, &size, in) != -1) {
+      char* event = line[0] == ',' ? line + 1 : line;
+      if (event[0] != '{' || strncmp(event, "{\"traceEvents\"", 14) == 0) {
+        continue;
+      }
+      fprintf(out, first ? "%s" : ",%s", event);
+      first = false;
+    }
+    free(line);
+    fclose(in);
+    merged++;
+  }
+  fprintf(out, "]}\n");
+  return merged;
+}
+
+} // namespace o2::framework
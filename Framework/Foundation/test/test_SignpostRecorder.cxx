@@ -0,0 +1,100 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test Framework SignpostRecorder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "Framework/Signpost.h"
+#include "Framework/SignpostRecorder.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+#define O2_PROBE_TEST 7
+
+using namespace o2::framework;
+
+namespace
+{
+std::string dumpToString(FILE* file)
+{
+  std::string result;
+  rewind(file);
+  char buffer[4096];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    result.append(buffer, read);
+  }
+  return result;
+}
+
+size_t countOf(std::string const& haystack, std::string const& needle)
+{
+  size_t count = 0;
+  for (auto pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1)) {
+    count++;
+  }
+  return count;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TestSignpostRecorder)
+{
+#ifdef __linux__
+  // Nothing is recorded until enabled.
+  O2_SIGNPOST(O2_PROBE_TEST, 1, 2, 3, 4);
+  SignpostRecorder::enable();
+  SignpostRecorder::setProcessName("test-device");
+  O2_SIGNPOST(O2_PROBE_TEST, 1, 2, 3, 4);
+  O2_SIGNPOST_START(O2_PROBE_TEST, 42, 0, 0, O2_SIGNPOST_BLUE);
+  std::thread other([]() {
+    O2_SIGNPOST_END(O2_PROBE_TEST, 42, 0, 0, O2_SIGNPOST_BLUE);
+  });
+  other.join();
+
+  FILE* file = tmpfile();
+  SignpostRecorder::dump(file);
+  auto trace = dumpToString(file);
+  fclose(file);
+
+  BOOST_CHECK_EQUAL(countOf(trace, "\"name\":\"O2_PROBE_TEST\""), 3);
+  BOOST_CHECK_EQUAL(countOf(trace, "\"ph\":\"i\""), 1);
+  BOOST_CHECK_EQUAL(countOf(trace, "\"ph\":\"b\""), 1);
+  BOOST_CHECK_EQUAL(countOf(trace, "\"ph\":\"e\""), 1);
+  BOOST_CHECK_EQUAL(countOf(trace, "\"local\":\"0x2a\""), 2);
+  BOOST_CHECK_EQUAL(countOf(trace, "\"name\":\"test-device\""), 1);
+
+  // Merging two traces gives one valid list of events.
+  char first[] = "/tmp/signpost-XXXXXX";
+  char second[] = "/tmp/signpost-XXXXXX";
+  for (auto name : {first, second}) {
+    int fd = mkstemp(name);
+    FILE* out = fdopen(fd, "w");
+    SignpostRecorder::dump(out);
+    fclose(out);
+  }
+  FILE* merged = tmpfile();
+  BOOST_CHECK_EQUAL(SignpostRecorder::merge({first, second, "/tmp/does-not-exist"}, merged), 2);
+  auto mergedTrace = dumpToString(merged);
+  fclose(merged);
+  unlink(first);
+  unlink(second);
+  BOOST_CHECK_EQUAL(countOf(mergedTrace, "\"name\":\"O2_PROBE_TEST\""), 6);
+  BOOST_CHECK_EQUAL(countOf(mergedTrace, "traceEvents"), 1);
+  BOOST_CHECK_EQUAL(mergedTrace.find("[\n,"), std::string::npos);
+  BOOST_CHECK_EQUAL(mergedTrace.substr(mergedTrace.size() - 3), "]}\n");
+#endif
+}
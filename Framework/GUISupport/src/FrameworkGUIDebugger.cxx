@@ -17,6 +17,7 @@
 #include "Framework/DriverControl.h"
 #include "Framework/DriverInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/LatencyTraceHelpers.h"
 #include "FrameworkGUIDeviceInspector.h"
 #include "FrameworkGUIDevicesGraph.h"
 #include "FrameworkGUIDataRelayerUsage.h"
@@ -965,6 +966,47 @@ void displayDriverInfo(DriverInfo const& driverInfo, DriverControl& driverContro
   ImGui::End();
 }
 
+/// Display the p50 / p99 latency of the edges and paths which were on the
+/// critical path of some timeslice, as reported by the sinks.
+void displayCriticalPath(std::vector<DeviceSpec> const& devices, std::vector<DeviceMetricsInfo> const& metricsInfos)
+{
+  auto table = [](char const* title, std::vector<LatencyPercentiles> const& entries) {
+    if (ImGui::CollapsingHeader(title, ImGuiTreeNodeFlags_DefaultOpen) == false) {
+      return;
+    }
+    if (ImGui::BeginTable(title, 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg) == false) {
+      return;
+    }
+    ImGui::TableSetupColumn("Devices");
+    ImGui::TableSetupColumn("p50 (ms)", ImGuiTableColumnFlags_WidthFixed, 70);
+    ImGui::TableSetupColumn("p99 (ms)", ImGuiTableColumnFlags_WidthFixed, 70);
+    ImGui::TableSetupColumn("Samples", ImGuiTableColumnFlags_WidthFixed, 70);
+    ImGui::TableHeadersRow();
+    for (auto& entry : entries) {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      std::string label;
+      for (auto& device : entry.devices) {
+        label += label.empty() ? device : " -> " + device;
+      }
+      ImGui::TextUnformatted(label.c_str());
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", entry.p50 / 1000.f);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", entry.p99 / 1000.f);
+      ImGui::TableNextColumn();
+      ImGui::Text("%zu", entry.samples);
+    }
+    ImGui::EndTable();
+  };
+
+  if (ImGui::Begin("Critical path latency")) {
+    table("Edges", LatencyTraceHelpers::edges(devices, metricsInfos));
+    table("Paths", LatencyTraceHelpers::paths(devices, metricsInfos));
+  }
+  ImGui::End();
+}
+
 // FIXME: return empty function in case we were not built
 // with GLFW support.
 ///
@@ -1022,6 +1064,7 @@ std::function<void(void)> getGUIDebugger(std::vector<DeviceInfo> const& infos,
     metricsStore.specs[DRIVER_METRICS] = &driverNodesInfos;
     displayMetrics(guiState, driverInfo, infos, metadata, controls, metricsStore);
     displayDriverInfo(driverInfo, driverControl);
+    displayCriticalPath(devices, metricsInfos);
 
     int windowPosStepping = (ImGui::GetIO().DisplaySize.y - 500) / guiState.devices.size();
 
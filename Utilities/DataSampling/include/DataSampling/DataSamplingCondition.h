@@ -38,6 +38,9 @@ class DataSamplingCondition
   virtual void configure(const boost::property_tree::ptree&) = 0;
   /// \brief Makes decision whether to pass a data sample or not.
   virtual bool decide(const o2::framework::DataRef&) = 0;
+  /// \brief Returns true if the decision depends only on the headers of the data sample, so that it is the same
+  /// wherever it is taken and it can be taken before the payload is sent (e.g. by the data producer).
+  virtual bool isStateless() const { return false; }
 };
 
 } // namespace o2::utilities
@@ -71,11 +71,15 @@ class DataSamplingPolicy
   void registerCondition(std::unique_ptr<DataSamplingCondition>&&);
   /// \brief Sets a raw FairMQChannel. Deprecated, do not use.
   void setFairMQOutputChannel(std::string);
+  /// \brief Asks to take the decisions in the data producers instead of the Dispatcher, if the policy is stateless.
+  void setSampleOnProducer(bool);
 
   /// \brief Returns true if this policy requires data with given InputSpec.
   bool match(const framework::ConcreteDataMatcher& input) const;
   /// \brief Returns true if user-defined conditions of sampling are fulfilled.
   bool decide(const o2::framework::DataRef&);
+  /// \brief Returns true if all the conditions are stateless, i.e. the decision can be taken anywhere.
+  bool isStateless() const;
   /// \brief Returns Output for given InputSpec to pass data forward.
   framework::Output prepareOutput(const framework::ConcreteDataMatcher& input, framework::Lifetime lifetime = framework::Lifetime::Timeframe) const;
 
@@ -84,6 +88,7 @@ class DataSamplingPolicy
   // optional fairmq channel to send stuff outside of DPL
   const std::string& getFairMQOutputChannel() const;
   std::string getFairMQOutputChannelName() const;
+  bool getSampleOnProducer() const;
   uint32_t getTotalAcceptedMessages() const;
   uint32_t getTotalEvaluatedMessages() const;
 
@@ -95,6 +100,7 @@ class DataSamplingPolicy
   PathMap mPaths;
   std::vector<std::unique_ptr<DataSamplingCondition>> mConditions;
   std::string mFairMQOutputChannel;
+  bool mSampleOnProducer = false;
 
   // stats
   uint32_t mTotalAcceptedMessages = 0;
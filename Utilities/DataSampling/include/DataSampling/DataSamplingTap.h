@@ -0,0 +1,68 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DataSamplingTap.h
+/// \brief Declaration of DataSamplingTap, which samples data directly in the devices producing it
+
+#ifndef ALICEO2_DATASAMPLINGTAP_H
+#define ALICEO2_DATASAMPLINGTAP_H
+
+#include "Framework/ServiceSpec.h"
+
+#include <fairmq/FairMQMessage.h>
+#include <fairmq/FairMQParts.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::framework
+{
+class MessageContext;
+struct DeviceSpec;
+} // namespace o2::framework
+
+namespace o2::utilities
+{
+
+class DataSamplingPolicy;
+
+/// Takes the decisions of stateless DataSamplingPolicies in the device which produces the data, right before the data
+/// is sent. Only the accepted samples leave the producer towards the outputs of the policies, sharing the payload
+/// with the original message, and the Dispatcher is not involved at all.
+///
+/// Since the decisions of stateless conditions depend only on the headers (e.g. the random condition on the
+/// TimesliceID), they are the same as the ones which a Dispatcher would take.
+class DataSamplingTap
+{
+ public:
+  using Outputs = std::unordered_map<std::string const*, FairMQParts>;
+
+  /// \brief Constructor, the policies are expected to be stateless.
+  DataSamplingTap(std::vector<std::shared_ptr<DataSamplingPolicy>> policies);
+
+  /// \brief Evaluates the policies for the message made of header and payload, adding the accepted samples to outputs.
+  void sample(framework::MessageContext& context, const framework::DeviceSpec& spec,
+              FairMQMessage& header, FairMQMessage& payload, Outputs& outputs);
+
+  /// \brief The service which installs the tap in the MessageContext of the device.
+  static framework::ServiceSpec serviceSpec(std::shared_ptr<DataSamplingTap> tap);
+
+  const std::vector<std::shared_ptr<DataSamplingPolicy>>& getPolicies() const;
+
+ private:
+  std::vector<std::shared_ptr<DataSamplingPolicy>> mPolicies;
+};
+
+} // namespace o2::utilities
+
+#endif //ALICEO2_DATASAMPLINGTAP_H
@@ -62,16 +62,20 @@ class Dispatcher : public framework::Task
   framework::Outputs getOutputSpecs();
   framework::Options getOptions();
 
+  /// \brief Prepares the DataSamplingHeader of a sample accepted by the policy in the device described by spec.
+  static DataSamplingHeader prepareDataSamplingHeader(const DataSamplingPolicy& policy, const framework::DeviceSpec& spec);
+  /// \brief Copies all the headers which are not DataHeader or DataProcessingHeader.
+  static header::Stack extractAdditionalHeaders(const char* inputHeaderStack);
+
  private:
-  DataSamplingHeader prepareDataSamplingHeader(const DataSamplingPolicy& policy, const framework::DeviceSpec& spec);
-  header::Stack extractAdditionalHeaders(const char* inputHeaderStack) const;
   void reportStats(monitoring::Monitoring& monitoring) const;
-  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, framework::Output&& output) const;
+  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, framework::Output&& output);
 
   std::string mName;
   std::string mReconfigurationSource;
   // policies should be shared between all pipeline threads
   std::vector<std::shared_ptr<DataSamplingPolicy>> mPolicies;
+  uint64_t mTotalSentBytes = 0;
 };
 
 } // namespace o2::utilities
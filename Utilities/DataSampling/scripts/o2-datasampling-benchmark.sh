@@ -71,7 +71,7 @@ function benchmark() {
   printf "Warm up cycles:         %s\n" "$warm_up_cycles" >> $results_filename
   printf "Available memory [B]:   %s\n" "$available_memory_bytes" >> $results_filename
   printf "Memory soft limit [MB]: %s\n" "$memory_soft_limit_mbytes" >> $results_filename
-  echo "fraction       , payload size   , nb producers   , nb dispatchers , messages per second" >> $results_filename
+  echo "fraction       , payload size   , nb producers   , nb dispatchers , messages per second , sampled GB/s" >> $results_filename
 
   local common_args="--run -b --infologger-severity info --shm-segment-size "$available_memory_bytes" --test-duration "$test_duration" --throttling "$memory_soft_limit_mbytes
   if [[ $fill == "yes" ]]; then
@@ -101,14 +101,21 @@ function benchmark() {
               # fixme: we assume that the metrics are produced in even (10s) time intervals and all are printed,
               #        we should at least be able notice when something doesn't seem right
 
+              local log_file=$(mktemp)
+              timeout -k 60s $test_duration_timeout o2-testworkflows-datasampling-benchmark $common_args --payload-size $payload_size --producers $nb_producers --dispatchers $nb_dispatchers --sampling-fraction $fraction > $log_file
+              pkill -9 -f o2-testworkflows-datasampling-benchmark
+
               metrics=
               mapfile -t metrics < \
-                <( timeout -k 60s $test_duration_timeout o2-testworkflows-datasampling-benchmark $common_args --payload-size $payload_size --producers $nb_producers --dispatchers $nb_dispatchers --sampling-fraction $fraction \
-                 | grep -o 'Dispatcher_messages_evaluated,[0-9] [0-9]\{1,\}' \
+                <( grep -o 'Dispatcher_messages_evaluated,[0-9] [0-9]\{1,\}' $log_file \
                  | sed -e 's/Dispatcher_messages_evaluated,[0-9]\{1,\} //'   \
                  | tail -n +$((warm_up_cycles * nb_dispatchers + 1)) )
-
-              pkill -9 -f o2-testworkflows-datasampling-benchmark
+              bytes=
+              mapfile -t bytes < \
+                <( grep -o 'Dispatcher_bytes_passed,[0-9] [0-9]\{1,\}' $log_file \
+                 | sed -e 's/Dispatcher_bytes_passed,[0-9]\{1,\} //'   \
+                 | tail -n +$((warm_up_cycles * nb_dispatchers + 1)) )
+              rm -f $log_file
 
               if [ ${#metrics[@]} -ge $(( 2 * nb_dispatchers )) ]; then
 
@@ -134,9 +141,26 @@ function benchmark() {
               else
                 messages_per_second='error'
               fi
+
+              sampled_gbps=0
+              if [ ${#bytes[@]} -ge $(( 2 * nb_dispatchers )) ]; then
+                bytes_start=0
+                for ((i = 0; i < nb_dispatchers; i++))
+                do
+                  (( bytes_start+=bytes[i] ))
+                done
+                bytes_end=0
+                for ((i = 1; i < $((1 + nb_dispatchers)); i++))
+                do
+                  (( bytes_end+=bytes[-i] ))
+                done
+                # metrics are sent every 10s
+                sampled_gbps=$(awk "BEGIN { printf \"%.3f\", ($bytes_end - $bytes_start) / ((${#bytes[@]} / $nb_dispatchers - 1) * 10) / 1e9 }")
+              fi
             done
 
-            printf "%20s" "$messages_per_second" >> $results_filename
+            printf "%20s," "$messages_per_second" >> $results_filename
+            printf "%14s" "$sampled_gbps" >> $results_filename
             printf "\n" >> $results_filename
 
             echo "Dispatcher_messages_evaluated metrics:"
@@ -146,6 +170,7 @@ function benchmark() {
               echo $metrics
             fi
             printf 'Messages per second: %s\n' "${messages_per_second}"
+            printf 'Sampled GB/s: %s\n' "${sampled_gbps}"
           done
         done
       done
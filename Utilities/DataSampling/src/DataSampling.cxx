@@ -16,6 +16,7 @@
 
 #include "DataSampling/DataSampling.h"
 #include "DataSampling/DataSamplingPolicy.h"
+#include "DataSampling/DataSamplingTap.h"
 #include "DataSampling/Dispatcher.h"
 #include "Framework/CompletionPolicyHelpers.h"
 #include "Framework/DataSpecUtils.h"
@@ -24,6 +25,9 @@
 #include <Configuration/ConfigurationInterface.h>
 #include <Configuration/ConfigurationFactory.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 using namespace o2::configuration;
 using namespace o2::framework;
 using SubSpecificationType = o2::header::DataHeader::SubSpecificationType;
@@ -58,13 +62,16 @@ void DataSampling::DoGenerateInfrastructure(Dispatcher& dispatcher, WorkflowSpec
 {
   LOG(DEBUG) << "Generating Data Sampling infrastructure...";
 
+  // Policies evaluated by the data producers, per data processor.
+  std::unordered_map<std::string, std::vector<std::shared_ptr<DataSamplingPolicy>>> taps;
+
   for (auto&& policyConfig : policiesTree) {
 
     std::unique_ptr<DataSamplingPolicy> policy;
 
     // We don't want the Dispatcher to exit due to one faulty Policy
     try {
-      dispatcher.registerPolicy(std::make_unique<DataSamplingPolicy>(DataSamplingPolicy::fromConfiguration(policyConfig.second)));
+      policy = std::make_unique<DataSamplingPolicy>(DataSamplingPolicy::fromConfiguration(policyConfig.second));
     } catch (const std::exception& ex) {
       LOG(WARN) << "Could not load the Data Sampling Policy '"
                 << policyConfig.second.get_optional<std::string>("id").value_or("") << "', because: " << ex.what();
@@ -74,6 +81,49 @@ void DataSampling::DoGenerateInfrastructure(Dispatcher& dispatcher, WorkflowSpec
                 << policyConfig.second.get_optional<std::string>("id").value_or("") << "'";
       continue;
     }
+
+    if (policy->getSampleOnProducer() && !policy->isStateless()) {
+      LOG(WARN) << "The Data Sampling Policy '" << policy->getName() << "' has conditions which cannot be evaluated by "
+                << "the data producers, it will be handled by the Dispatcher.";
+    } else if (policy->getSampleOnProducer()) {
+      std::vector<DataProcessorSpec*> producers;
+      for (auto& spec : workflow) {
+        for (const auto& [input, _output] : policy->getPathMap()) {
+          (void)_output;
+          auto produces = [&input = input](const OutputSpec& output) { return DataSpecUtils::match(input, output); };
+          if (std::any_of(spec.outputs.begin(), spec.outputs.end(), produces)) {
+            producers.push_back(&spec);
+            break;
+          }
+        }
+      }
+      if (producers.empty()) {
+        LOG(WARN) << "No data processor produces the data of the Data Sampling Policy '" << policy->getName()
+                  << "', it will be handled by the Dispatcher.";
+      } else {
+        std::shared_ptr<DataSamplingPolicy> shared = std::move(policy);
+        for (auto* producer : producers) {
+          // The producer sends the samples by itself, so it needs the outputs of the policy.
+          for (const auto& [input, output] : shared->getPathMap()) {
+            auto produces = [&input = input](const OutputSpec& spec) { return DataSpecUtils::match(input, spec); };
+            auto declared = [&output = output](const OutputSpec& spec) { return DataSpecUtils::match(output, spec); };
+            if (std::any_of(producer->outputs.begin(), producer->outputs.end(), produces) &&
+                std::none_of(producer->outputs.begin(), producer->outputs.end(), declared)) {
+              producer->outputs.push_back(output);
+            }
+          }
+          taps[producer->name].push_back(shared);
+        }
+        continue;
+      }
+    }
+    dispatcher.registerPolicy(std::move(policy));
+  }
+
+  for (auto& spec : workflow) {
+    if (auto tap = taps.find(spec.name); tap != taps.end()) {
+      spec.requiredServices.push_back(DataSamplingTap::serviceSpec(std::make_shared<DataSamplingTap>(tap->second)));
+    }
   }
 
   if (dispatcher.numberOfPolicies() > 0) {
@@ -58,6 +58,8 @@ class DataSamplingConditionNConsecutive : public DataSamplingCondition
     return dpHeader->startTime % mCycleSize < mSamplesNumber;
   }
 
+  bool isStateless() const override { return true; }
+
  private:
   size_t mSamplesNumber;
   size_t mCycleSize;
@@ -55,6 +55,8 @@ class DataSamplingConditionPayloadSize : public DataSamplingCondition
     return header->payloadSize >= mLowerLimit && header->payloadSize <= mUpperLimit;
   }
 
+  bool isStateless() const override { return true; }
+
  private:
   size_t mLowerLimit;
   size_t mUpperLimit;
@@ -38,9 +38,7 @@ class DataSamplingConditionRandom : public DataSamplingCondition
   /// \brief Constructor.
   DataSamplingConditionRandom() : DataSamplingCondition(),
                                   mThreshold(0),
-                                  mGenerator(0),
-                                  mCurrentTimesliceID(0),
-                                  mLastDecision(false){};
+                                  mGenerator(0){};
   /// \brief Default destructor
   ~DataSamplingConditionRandom() override = default;
 
@@ -49,35 +47,25 @@ class DataSamplingConditionRandom : public DataSamplingCondition
   {
     mThreshold = static_cast<uint32_t>(config.get<double>("fraction") * std::numeric_limits<uint32_t>::max());
     mGenerator.seed(config.get<uint64_t>("seed"));
-    mCurrentTimesliceID = 0;
-    mLastDecision = false;
   };
   /// \brief Makes pseudo-random, deterministic decision based on TimesliceID.
   /// The reason behind using TimesliceID is to ensure, that data of the same events is sampled even on different FLPs.
+  /// The decision is the TimesliceID-th number of the sequence, the generator is advanced on a copy, in O(log(TimesliceID)).
   bool decide(const o2::framework::DataRef& dataRef) override
   {
     const auto* dpHeader = get<DataProcessingHeader*>(dataRef.header);
     assert(dpHeader);
 
-    int64_t diff = dpHeader->startTime - mCurrentTimesliceID;
-    if (diff == -1) {
-      return mLastDecision;
-    } else if (diff < -1) {
-      mGenerator.backstep(static_cast<uint64_t>(-diff));
-    } else if (diff > 0) {
-      mGenerator.advance(static_cast<uint64_t>(diff));
-    }
-
-    mLastDecision = mGenerator() < mThreshold;
-    mCurrentTimesliceID = dpHeader->startTime + 1;
-    return mLastDecision;
+    auto generator = mGenerator;
+    generator.advance(dpHeader->startTime);
+    return generator() < mThreshold;
   }
 
+  bool isStateless() const override { return true; }
+
  private:
   uint32_t mThreshold;
   pcg32_fast mGenerator;
-  bool mLastDecision;
-  DataProcessingHeader::StartTime mCurrentTimesliceID;
 };
 
 std::unique_ptr<DataSamplingCondition> DataSamplingConditionFactory::createDataSamplingConditionRandom()
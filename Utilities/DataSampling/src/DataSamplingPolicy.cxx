@@ -49,6 +49,11 @@ void DataSamplingPolicy::setFairMQOutputChannel(std::string channel)
   mFairMQOutputChannel = std::move(channel);
 }
 
+void DataSamplingPolicy::setSampleOnProducer(bool sampleOnProducer)
+{
+  mSampleOnProducer = sampleOnProducer;
+}
+
 DataSamplingPolicy DataSamplingPolicy::fromConfiguration(const ptree& config)
 {
   auto name = config.get<std::string>("id");
@@ -99,6 +104,7 @@ DataSamplingPolicy DataSamplingPolicy::fromConfiguration(const ptree& config)
   }
 
   policy.setFairMQOutputChannel(config.get_optional<std::string>("fairMQOutput").value_or(""));
+  policy.setSampleOnProducer(config.get<bool>("sampleOnProducer", false));
 
   return policy;
 }
@@ -121,6 +127,14 @@ bool DataSamplingPolicy::decide(const o2::framework::DataRef& dataRef)
   return decision;
 }
 
+bool DataSamplingPolicy::isStateless() const
+{
+  return std::all_of(mConditions.begin(), mConditions.end(),
+                     [](const std::unique_ptr<DataSamplingCondition>& condition) {
+                       return condition->isStateless();
+                     });
+}
+
 Output DataSamplingPolicy::prepareOutput(const ConcreteDataMatcher& input, Lifetime lifetime) const
 {
   auto result = mPaths.find(input);
@@ -155,6 +169,11 @@ std::string DataSamplingPolicy::getFairMQOutputChannelName() const
   return name;
 }
 
+bool DataSamplingPolicy::getSampleOnProducer() const
+{
+  return mSampleOnProducer;
+}
+
 uint32_t DataSamplingPolicy::getTotalAcceptedMessages() const
 {
   return mTotalAcceptedMessages;
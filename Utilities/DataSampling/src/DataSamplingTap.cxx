@@ -0,0 +1,140 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DataSamplingTap.cxx
+/// \brief Implementation of DataSamplingTap
+
+#include "DataSampling/DataSamplingTap.h"
+#include "DataSampling/DataSamplingHeader.h"
+#include "DataSampling/DataSamplingPolicy.h"
+#include "DataSampling/Dispatcher.h"
+#include "Framework/CommonServices.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/DeviceSpec.h"
+#include "Framework/Logger.h"
+#include "Framework/MessageContext.h"
+#include "Framework/ProcessingContext.h"
+#include "Framework/ServiceRegistry.h"
+#include "Framework/TypeIdHelpers.h"
+#include "Headers/Stack.h"
+#include "MemoryResources/MemoryResources.h"
+
+#include <fairmq/FairMQTransportFactory.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace o2::framework;
+
+namespace o2::utilities
+{
+
+DataSamplingTap::DataSamplingTap(std::vector<std::shared_ptr<DataSamplingPolicy>> policies)
+  : mPolicies(std::move(policies))
+{
+}
+
+void DataSamplingTap::sample(MessageContext& context, const DeviceSpec& spec,
+                             FairMQMessage& header, FairMQMessage& payload, Outputs& outputs)
+{
+  const auto* inputHeaderStack = static_cast<const char*>(header.GetData());
+  const auto* dh = header::get<header::DataHeader*>(inputHeaderStack);
+  const auto* dph = header::get<DataProcessingHeader*>(inputHeaderStack);
+  if (dh == nullptr || dph == nullptr) {
+    return;
+  }
+  ConcreteDataMatcher matcher{dh->dataOrigin, dh->dataDescription, dh->subSpecification};
+  DataRef ref{nullptr, inputHeaderStack, static_cast<const char*>(payload.GetData())};
+
+  for (auto& policy : mPolicies) {
+    if (!policy->match(matcher) || !policy->decide(ref)) {
+      continue;
+    }
+    Output output = policy->prepareOutput(matcher);
+    auto route = std::find_if(spec.outputs.begin(), spec.outputs.end(), [&output, dph](const OutputRoute& route) {
+      return DataSpecUtils::match(route.matcher, output.origin, output.description, output.subSpec) &&
+             (dph->startTime % route.maxTimeslices) == route.timeslice;
+    });
+    if (route == spec.outputs.end()) {
+      LOG(ERROR) << "The Data Sampling Policy '" << policy->getName() << "' has no output route in the device " << spec.id;
+      continue;
+    }
+
+    // Same header as the sampled message, apart from the data type, plus the DataSamplingHeader.
+    header::DataHeader sampleHeader{*dh};
+    sampleHeader.dataOrigin = output.origin;
+    sampleHeader.dataDescription = output.description;
+    sampleHeader.subSpecification = output.subSpec;
+    sampleHeader.payloadSize = payload.GetSize();
+
+    auto* transport = context.proxy().getTransport(route->channel);
+    auto headerMessage = o2::pmr::getMessage(header::Stack{o2::pmr::getTransportAllocator(transport),
+                                                           sampleHeader, *dph,
+                                                           Dispatcher::extractAdditionalHeaders(inputHeaderStack),
+                                                           Dispatcher::prepareDataSamplingHeader(*policy, spec)});
+    FairMQMessagePtr payloadMessage;
+    if (payload.GetType() == transport->GetType()) {
+      payloadMessage = transport->CreateMessage();
+      payloadMessage->Copy(payload);
+    } else {
+      payloadMessage = transport->CreateMessage(payload.GetSize(), fair::mq::Alignment{64});
+      std::memcpy(payloadMessage->GetData(), payload.GetData(), payload.GetSize());
+    }
+
+    auto& parts = outputs[&context.getChannelRef(route->channel)];
+    parts.AddPart(std::move(headerMessage));
+    parts.AddPart(std::move(payloadMessage));
+  }
+}
+
+ServiceSpec DataSamplingTap::serviceSpec(std::shared_ptr<DataSamplingTap> tap)
+{
+  return ServiceSpec{"data-sampling-tap",
+                     [tap](ServiceRegistry&, DeviceState&, fair::mq::ProgOptions&) -> ServiceHandle {
+                       return ServiceHandle{TypeIdHelpers::uniqueId<DataSamplingTap>(), tap.get(), ServiceKind::Global};
+                     },
+                     CommonServices::noConfiguration(),
+                     // Each processing stream has its own MessageContext.
+                     [](ProcessingContext& ctx, void* service) {
+                       auto& context = ctx.services().get<MessageContext>();
+                       if (context.tap()) {
+                         return;
+                       }
+                       auto* tap = reinterpret_cast<DataSamplingTap*>(service);
+                       auto& spec = ctx.services().get<DeviceSpec const>();
+                       context.setTap([tap, &context, &spec](FairMQMessage& header, FairMQMessage& payload, Outputs& outputs) {
+                         tap->sample(context, spec, header, payload, outputs);
+                       });
+                     },
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     ServiceKind::Global};
+}
+
+const std::vector<std::shared_ptr<DataSamplingPolicy>>& DataSamplingTap::getPolicies() const
+{
+  return mPolicies;
+}
+
+} // namespace o2::utilities
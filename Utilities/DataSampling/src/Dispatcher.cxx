@@ -27,6 +27,8 @@
 #include <Configuration/ConfigurationInterface.h>
 #include <Configuration/ConfigurationFactory.h>
 
+#include <unordered_set>
+
 using namespace o2::configuration;
 using namespace o2::monitoring;
 using namespace o2::framework;
@@ -46,6 +48,12 @@ void Dispatcher::init(InitContext& ctx)
   LOG(DEBUG) << "Reading Data Sampling Policies...";
 
   boost::property_tree::ptree policiesTree;
+  // Only the policies declared during workflow init have their inputs and outputs in the topology,
+  // the others are sampled by their data producers, if at all.
+  std::unordered_set<std::string> declaredPolicies;
+  for (const auto& policy : mPolicies) {
+    declaredPolicies.insert(policy->getName());
+  }
 
   if (mReconfigurationSource.empty() == false) {
     std::unique_ptr<ConfigurationInterface> cfg = ConfigurationFactory::getConfiguration(mReconfigurationSource);
@@ -59,6 +67,9 @@ void Dispatcher::init(InitContext& ctx)
   }
 
   for (auto&& policyConfig : policiesTree) {
+    if (declaredPolicies.count(policyConfig.second.get<std::string>("id", "")) == 0) {
+      continue;
+    }
     // we don't want the Dispatcher to exit due to one faulty Policy
     try {
       mPolicies.emplace_back(std::make_shared<DataSamplingPolicy>(DataSamplingPolicy::fromConfiguration(policyConfig.second)));
@@ -115,6 +126,7 @@ void Dispatcher::reportStats(Monitoring& monitoring) const
 
   monitoring.send({dispatcherTotalEvaluatedMessages, "Dispatcher_messages_evaluated"});
   monitoring.send({dispatcherTotalAcceptedMessages, "Dispatcher_messages_passed"});
+  monitoring.send({mTotalSentBytes, "Dispatcher_bytes_passed"});
 }
 
 DataSamplingHeader Dispatcher::prepareDataSamplingHeader(const DataSamplingPolicy& policy, const DeviceSpec& spec)
@@ -131,7 +143,7 @@ DataSamplingHeader Dispatcher::prepareDataSamplingHeader(const DataSamplingPolic
     id};
 }
 
-header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack) const
+header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack)
 {
   header::Stack headerStack;
 
@@ -146,10 +158,13 @@ header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack)
   return headerStack;
 }
 
-void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, Output&& output) const
+void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, Output&& output)
 {
+  // Only the header stack is new, the payload is shared with the input
+  // whenever the transport allows it.
   const auto* inputHeader = header::get<header::DataHeader*>(inputData.header);
-  dataAllocator.snapshot(output, inputData.payload, inputHeader->payloadSize, inputHeader->payloadSerializationMethod);
+  dataAllocator.forwardPayload(output, inputData);
+  mTotalSentBytes += inputHeader->payloadSize;
 }
 
 void Dispatcher::registerPolicy(std::unique_ptr<DataSamplingPolicy>&& policy)
@@ -16,12 +16,25 @@
 
 #include "DataSampling/DataSampling.h"
 #include "DataSampling/Dispatcher.h"
+#include "DataSampling/DataSamplingHeader.h"
 #include "DataSampling/DataSamplingPolicy.h"
+#include "DataSampling/DataSamplingTap.h"
+#include "Framework/DataProcessingHeader.h"
 #include "Framework/DataSpecUtils.h"
+#include "Framework/DeviceSpec.h"
+#include "Framework/FairMQDeviceProxy.h"
+#include "Framework/MessageContext.h"
 
 #include "Headers/DataHeader.h"
+#include "Headers/Stack.h"
+#include "MemoryResources/MemoryResources.h"
 
 #include <Configuration/ConfigurationFactory.h>
+#include <boost/property_tree/ptree.hpp>
+#include <fairmq/FairMQDevice.h>
+#include <fairmq/FairMQTransportFactory.h>
+
+#include <cstring>
 
 using namespace o2::framework;
 using namespace o2::utilities;
@@ -169,6 +182,114 @@ BOOST_AUTO_TEST_CASE(DataSamplingTimePipelineFlow)
   BOOST_CHECK_EQUAL(disp->maxInputTimeslices, 3);
 }
 
+BOOST_AUTO_TEST_CASE(DataSamplingOnProducer)
+{
+  WorkflowSpec workflow{
+    {"producer",
+     Inputs{},
+     Outputs{{"TPC", "CLUSTERS"}}},
+    {"processingStage",
+     Inputs{{"dataTPC", "TPC", "CLUSTERS"}},
+     Outputs{{"TPC", "CLUSTERS_P"}}}};
+  auto servicesCount = workflow[0].requiredServices.size();
+
+  auto addPolicy = [](boost::property_tree::ptree& policies, std::string id, std::string query) {
+    boost::property_tree::ptree policy;
+    policy.put("id", id);
+    policy.put("query", query);
+    policy.put("sampleOnProducer", "true");
+    boost::property_tree::ptree conditionConfig;
+    conditionConfig.put("condition", "random");
+    conditionConfig.put("fraction", "0.1");
+    conditionConfig.put("seed", "1234");
+    boost::property_tree::ptree conditions;
+    conditions.push_back(std::make_pair("", conditionConfig));
+    policy.add_child("samplingConditions", conditions);
+    policies.push_back(std::make_pair("", policy));
+  };
+  boost::property_tree::ptree policies;
+  // evaluated by the producer
+  addPolicy(policies, "random", "clusters:TPC/CLUSTERS");
+  // no such producer, falls back to the Dispatcher
+  addPolicy(policies, "missing", "raw:TPC/RAWDATA");
+
+  DataSampling::GenerateInfrastructure(workflow, policies);
+
+  BOOST_REQUIRE_EQUAL(workflow.size(), 3);
+  auto& producer = workflow[0];
+  BOOST_CHECK(std::any_of(producer.outputs.begin(), producer.outputs.end(), [](const OutputSpec& out) {
+    return DataSpecUtils::match(out, ConcreteDataTypeMatcher{"DS", "random0"});
+  }));
+  BOOST_REQUIRE_EQUAL(producer.requiredServices.size(), servicesCount + 1);
+  BOOST_CHECK_EQUAL(producer.requiredServices.back().name, "data-sampling-tap");
+  BOOST_CHECK_EQUAL(workflow[1].requiredServices.size(), servicesCount);
+
+  auto& disp = workflow[2];
+  BOOST_CHECK(disp.name.find("Dispatcher") != std::string::npos);
+  BOOST_CHECK_EQUAL(disp.outputs.size(), 1);
+  BOOST_CHECK(DataSpecUtils::match(disp.outputs[0], ConcreteDataTypeMatcher{"DS", "missing0"}));
+}
+
+BOOST_AUTO_TEST_CASE(DataSamplingTapSample)
+{
+  auto makePolicy = [](std::string id, size_t lowerLimit) {
+    boost::property_tree::ptree config;
+    config.put("id", id);
+    config.put("query", "clusters:TPC/CLUSTERS/0");
+    config.put("sampleOnProducer", "true");
+    boost::property_tree::ptree conditionConfig;
+    conditionConfig.put("condition", "payloadSize");
+    conditionConfig.put("lowerLimit", std::to_string(lowerLimit));
+    conditionConfig.put("upperLimit", "1000");
+    boost::property_tree::ptree conditions;
+    conditions.push_back(std::make_pair("", conditionConfig));
+    config.add_child("samplingConditions", conditions);
+    return std::make_shared<DataSamplingPolicy>(DataSamplingPolicy::fromConfiguration(config));
+  };
+  // Only the first one accepts the message
+  DataSamplingTap tap{{makePolicy("accepted", 0), makePolicy("rejected", 100)}};
+
+  auto transport = FairMQTransportFactory::CreateTransportFactory("zeromq");
+  FairMQDevice device;
+  device.fChannels["from_producer_to_sampler"].emplace_back("from_producer_to_sampler", "push", transport);
+  MessageContext context{FairMQDeviceProxy{&device}};
+  DeviceSpec spec;
+  spec.id = "producer";
+  spec.outputs.push_back(OutputRoute{0, 1, OutputSpec{"DS", "accepted0", 0}, "from_producer_to_sampler"});
+
+  DataHeader dh{"CLUSTERS", "TPC", 0, 16};
+  DataProcessingHeader dph{42, 1};
+  auto header = o2::pmr::getMessage(o2::header::Stack{o2::pmr::getTransportAllocator(transport.get()), dh, dph});
+  auto payload = transport->CreateMessage(16);
+  std::memset(payload->GetData(), 7, 16);
+
+  DataSamplingTap::Outputs outputs;
+  tap.sample(context, spec, *header, *payload, outputs);
+
+  BOOST_REQUIRE_EQUAL(outputs.size(), 1);
+  auto& parts = outputs.begin()->second;
+  BOOST_CHECK_EQUAL(*outputs.begin()->first, "from_producer_to_sampler");
+  BOOST_REQUIRE_EQUAL(parts.Size(), 2);
+  auto sampleDh = o2::header::get<DataHeader*>(parts.At(0)->GetData());
+  BOOST_REQUIRE(sampleDh != nullptr);
+  BOOST_CHECK(sampleDh->dataOrigin == DataOrigin("DS"));
+  BOOST_CHECK(sampleDh->dataDescription == DataDescription("accepted0"));
+  BOOST_CHECK_EQUAL(sampleDh->payloadSize, 16);
+  auto sampleDph = o2::header::get<DataProcessingHeader*>(parts.At(0)->GetData());
+  BOOST_REQUIRE(sampleDph != nullptr);
+  BOOST_CHECK_EQUAL(sampleDph->startTime, 42);
+  auto dsh = o2::header::get<DataSamplingHeader*>(parts.At(0)->GetData());
+  BOOST_REQUIRE(dsh != nullptr);
+  BOOST_CHECK(dsh->deviceID == DataSamplingHeader::DeviceIDType("producer"));
+  BOOST_REQUIRE_EQUAL(parts.At(1)->GetSize(), 16);
+  BOOST_CHECK_EQUAL(static_cast<char*>(parts.At(1)->GetData())[15], 7);
+
+  // The sampled message is left untouched
+  auto originalDh = o2::header::get<DataHeader*>(header->GetData());
+  BOOST_CHECK(originalDh->dataDescription == DataDescription("CLUSTERS"));
+  BOOST_CHECK_EQUAL(payload->GetSize(), 16);
+}
+
 BOOST_AUTO_TEST_CASE(InputSpecsForPolicy)
 {
   std::string configFilePath = "json:/" + std::string(getenv("O2_ROOT")) + "/share/tests/test_DataSampling.json";
@@ -35,6 +35,7 @@ BOOST_AUTO_TEST_CASE(DataSamplingConditionRandom)
   config.put("fraction", "0.5");
   config.put("seed", "943753948");
   conditionRandom->configure(config);
+  BOOST_CHECK(conditionRandom->isStateless());
 
   // PRNG should behave the same every time and on every machine.
   // Of course, the test does not cover full range of timesliceIDs, but at least gives an idea about its determinism.
@@ -0,0 +1,81 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_HISTOGRAMDELTA_H
+#define O2_HISTOGRAMDELTA_H
+
+/// \file HistogramDelta.h
+/// \brief Sparse difference of a histogram between two publications
+
+#include <TObject.h>
+#include "Mergers/MergeInterface.h"
+
+#include <string>
+#include <vector>
+
+class TH1;
+
+namespace o2::mergers
+{
+
+/// \brief Changed bins of a TH1/TH2/TH3 since the previous publication.
+///
+/// A source keeps its histogram and the copy it published last, and sends
+/// HistogramDelta(current, &previous) instead of the whole histogram. Only the
+/// bins which changed are stored, as sorted global bin indices with their
+/// content (and sum of squared weights) differences. Mergers merge deltas
+/// natively by joining the bin lists, without going through TH1::Merge, and
+/// publish the merged delta. A consumer applies it to its own copy of the
+/// histogram with applyTo().
+class HistogramDelta : public TObject, public MergeInterface
+{
+ public:
+  HistogramDelta() = default;
+  /// \brief Creates the difference between current and previous. If previous is nullptr, all non-empty bins are taken.
+  HistogramDelta(const TH1& current, const TH1* previous = nullptr);
+  ~HistogramDelta() override = default;
+
+  /// \brief Adds the bins of the other delta, which should describe a histogram with the same binning.
+  void merge(MergeInterface* const other) override;
+
+  /// \brief Adds the delta to the target histogram, including its statistics and number of entries.
+  void applyTo(TH1& target) const;
+
+  const char* GetName() const override
+  {
+    return mName.c_str();
+  }
+
+  size_t getNChangedBins() const
+  {
+    return mBins.size();
+  }
+
+  int getNCells() const
+  {
+    return mNCells;
+  }
+
+ private:
+  std::string mName;
+  int mNCells = 0;
+  double mEntries = 0;
+  std::vector<int> mBins;
+  std::vector<double> mContents;
+  std::vector<double> mSumw2; // empty if the histogram does not store the sum of squared weights
+  std::vector<double> mStats;
+
+  ClassDefOverride(HistogramDelta, 1);
+};
+
+} // namespace o2::mergers
+
+#endif //O2_HISTOGRAMDELTA_H
@@ -0,0 +1,160 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file HistogramDelta.cxx
+/// \brief Implementation of HistogramDelta
+
+#include "Mergers/HistogramDelta.h"
+
+#include <TH1.h>
+
+#include <stdexcept>
+
+namespace o2::mergers
+{
+
+namespace
+{
+// TH1::GetStats fills at most this many values (for TH3)
+constexpr int maxStats = 13;
+} // namespace
+
+HistogramDelta::HistogramDelta(const TH1& current, const TH1* previous)
+  : TObject(), MergeInterface(), mName(current.GetName()), mNCells(current.GetNcells())
+{
+  if (previous != nullptr && previous->GetNcells() != mNCells) {
+    throw std::runtime_error(std::string("Cannot create a delta of histogram '") + current.GetName() + "', the previous version has a different binning.");
+  }
+  bool hasSumw2 = current.GetSumw2N() > 0;
+  bool previousHasSumw2 = previous != nullptr && previous->GetSumw2N() > 0;
+  const double* sumw2 = hasSumw2 ? current.GetSumw2()->GetArray() : nullptr;
+  const double* previousSumw2 = previousHasSumw2 ? previous->GetSumw2()->GetArray() : nullptr;
+
+  for (int bin = 0; bin < mNCells; ++bin) {
+    double content = current.GetBinContent(bin) - (previous ? previous->GetBinContent(bin) : 0);
+    double error = 0;
+    if (hasSumw2 && previous != nullptr) {
+      // a previous version without Sumw2 was filled without weights, thus its sumw2 equals its content
+      error = sumw2[bin] - (previousSumw2 ? previousSumw2[bin] : previous->GetBinContent(bin));
+    } else if (hasSumw2) {
+      error = sumw2[bin];
+    }
+    if (content != 0 || error != 0) {
+      mBins.push_back(bin);
+      mContents.push_back(content);
+      if (hasSumw2) {
+        mSumw2.push_back(error);
+      }
+    }
+  }
+
+  mStats.resize(maxStats, 0);
+  current.GetStats(mStats.data());
+  mEntries = current.GetEntries();
+  if (previous != nullptr) {
+    std::vector<double> previousStats(maxStats, 0);
+    previous->GetStats(previousStats.data());
+    for (int i = 0; i < maxStats; ++i) {
+      mStats[i] -= previousStats[i];
+    }
+    mEntries -= previous->GetEntries();
+  }
+}
+
+void HistogramDelta::merge(MergeInterface* const other)
+{
+  auto otherDelta = dynamic_cast<const HistogramDelta*>(other);
+  if (otherDelta == nullptr) {
+    throw std::runtime_error(std::string("Cannot merge HistogramDelta '") + mName + "' with an object of another type.");
+  }
+  if (otherDelta->mNCells != mNCells) {
+    throw std::runtime_error(std::string("Cannot merge HistogramDelta '") + mName + "', the deltas describe different binnings.");
+  }
+  bool withSumw2 = !mSumw2.empty() || !otherDelta->mSumw2.empty();
+  auto sumw2At = [](const HistogramDelta& d, size_t i) {
+    return d.mSumw2.empty() ? d.mContents[i] : d.mSumw2[i]; // unweighted fills: sumw2 equals the content
+  };
+
+  // both bin lists are sorted, so they are joined in one pass
+  std::vector<int> bins;
+  std::vector<double> contents;
+  std::vector<double> sumw2;
+  bins.reserve(mBins.size() + otherDelta->mBins.size());
+  contents.reserve(bins.capacity());
+  if (withSumw2) {
+    sumw2.reserve(bins.capacity());
+  }
+  size_t i = 0, j = 0;
+  while (i < mBins.size() || j < otherDelta->mBins.size()) {
+    if (j == otherDelta->mBins.size() || (i < mBins.size() && mBins[i] < otherDelta->mBins[j])) {
+      bins.push_back(mBins[i]);
+      contents.push_back(mContents[i]);
+      if (withSumw2) {
+        sumw2.push_back(sumw2At(*this, i));
+      }
+      ++i;
+    } else if (i == mBins.size() || otherDelta->mBins[j] < mBins[i]) {
+      bins.push_back(otherDelta->mBins[j]);
+      contents.push_back(otherDelta->mContents[j]);
+      if (withSumw2) {
+        sumw2.push_back(sumw2At(*otherDelta, j));
+      }
+      ++j;
+    } else {
+      bins.push_back(mBins[i]);
+      contents.push_back(mContents[i] + otherDelta->mContents[j]);
+      if (withSumw2) {
+        sumw2.push_back(sumw2At(*this, i) + sumw2At(*otherDelta, j));
+      }
+      ++i;
+      ++j;
+    }
+  }
+  mBins.swap(bins);
+  mContents.swap(contents);
+  mSumw2.swap(sumw2);
+
+  mStats.resize(maxStats, 0);
+  for (size_t s = 0; s < otherDelta->mStats.size() && s < maxStats; ++s) {
+    mStats[s] += otherDelta->mStats[s];
+  }
+  mEntries += otherDelta->mEntries;
+}
+
+void HistogramDelta::applyTo(TH1& target) const
+{
+  if (target.GetNcells() != mNCells) {
+    throw std::runtime_error(std::string("Cannot apply HistogramDelta '") + mName + "' to '" + target.GetName() + "', which has a different binning.");
+  }
+  if (!mSumw2.empty() && target.GetSumw2N() == 0) {
+    target.Sumw2();
+  }
+  // get the statistics before modifying the bins, since they might be recomputed from the contents
+  std::vector<double> stats(maxStats, 0);
+  target.GetStats(stats.data());
+  double entries = target.GetEntries();
+
+  double* targetSumw2 = target.GetSumw2N() > 0 ? target.GetSumw2()->GetArray() : nullptr;
+  for (size_t i = 0; i < mBins.size(); ++i) {
+    target.AddBinContent(mBins[i], mContents[i]);
+    if (targetSumw2 != nullptr) {
+      targetSumw2[mBins[i]] += mSumw2.empty() ? mContents[i] : mSumw2[i];
+    }
+  }
+
+  for (size_t s = 0; s < mStats.size() && s < maxStats; ++s) {
+    stats[s] += mStats[s];
+  }
+  target.PutStats(stats.data());
+  target.SetEntries(entries + mEntries);
+}
+
+} // namespace o2::mergers
@@ -24,6 +24,8 @@
 #include <chrono>
 #include <ctime>
 
+#include "Mergers/HistogramDelta.h"
+
 const size_t entriesInDiff = 50;
 const size_t entriesInFull = 5000;
 const size_t collectionSize = 100;
@@ -248,6 +250,39 @@ static void BM_MergingTTree(benchmark::State& state)
   delete merged;
 }
 
+// Merging sparse deltas of a TH2I in a cycle of collectionSize sources against the full objects.
+// The argument is the number of bins per axis, so that the merge rate can be followed against the object size.
+static void BM_MergingHistogramDeltas(benchmark::State& state)
+{
+  const size_t bins = state.range(0);
+
+  std::vector<std::unique_ptr<o2::mergers::HistogramDelta>> deltas;
+  TF2* uni = new TF2("uni", "1", 0, 1000000, 0, 1000000);
+  for (size_t i = 0; i < collectionSize; i++) {
+    TH2I h(("test" + std::to_string(i)).c_str(), "test", bins, 0, 1000000, bins, 0, 1000000);
+    h.FillRandom("uni", entriesInDiff);
+    deltas.emplace_back(std::make_unique<o2::mergers::HistogramDelta>(h));
+  }
+
+  for (auto _ : state) {
+    TH2I empty("merged", "merged", bins, 0, 1000000, bins, 0, 1000000);
+    o2::mergers::HistogramDelta merged(empty);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto& delta : deltas) {
+      merged.merge(delta.get());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto elapsed_seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+  state.SetItemsProcessed(state.iterations() * collectionSize);
+  state.SetLabel(std::to_string(bins * bins * sizeof(Int_t) / 1024) + "kB objects");
+
+  delete uni;
+}
+
 BENCHMARK(BM_MergingTH1I)->Arg(DIFF_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTH1I)->Arg(FULL_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTH2I)->Arg(DIFF_OBJECTS)->UseManualTime();
@@ -258,5 +293,6 @@ BENCHMARK(BM_MergingTHnSparse)->Arg(DIFF_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTHnSparse)->Arg(FULL_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTTree)->Arg(DIFF_OBJECTS)->UseManualTime();
 BENCHMARK(BM_MergingTTree)->Arg(FULL_OBJECTS)->UseManualTime();
+BENCHMARK(BM_MergingHistogramDeltas)->RangeMultiplier(4)->Range(64, 4096)->UseManualTime();
 
 BENCHMARK_MAIN();
\ No newline at end of file
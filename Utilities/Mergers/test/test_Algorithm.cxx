@@ -23,6 +23,7 @@
 #include "Mergers/MergerAlgorithm.h"
 #include "Mergers/CustomMergeableTObject.h"
 #include "Mergers/CustomMergeableObject.h"
+#include "Mergers/HistogramDelta.h"
 
 #include <TObjArray.h>
 #include <TObjString.h>
@@ -36,6 +37,8 @@
 #include <TGraph.h>
 #include <TProfile.h>
 
+#include <cmath>
+
 //using namespace o2::framework;
 using namespace o2::mergers;
 
@@ -300,6 +303,84 @@ BOOST_AUTO_TEST_CASE(MergerCollection)
   delete target;
 }
 
+BOOST_AUTO_TEST_CASE(MergerHistogramDeltas)
+{
+  // two sources publish deltas of their histograms since the previous cycle
+  TH2I* sourceA = new TH2I("histo 2d", "histo 2d", bins, min, max, bins, min, max);
+  TH2I* sourceB = new TH2I("histo 2d", "histo 2d", bins, min, max, bins, min, max);
+  sourceA->Fill(1, 1);
+  sourceA->Fill(2, 2);
+  auto* previousA = dynamic_cast<TH2I*>(sourceA->Clone());
+  sourceA->Fill(2, 2);
+  sourceA->Fill(3, 7);
+  sourceB->Fill(3, 7);
+  sourceB->Fill(8, 8);
+
+  HistogramDelta* target = new HistogramDelta(*sourceA, previousA);
+  HistogramDelta* other = new HistogramDelta(*sourceB);
+  BOOST_CHECK_EQUAL(target->getNChangedBins(), 2);
+  BOOST_CHECK_EQUAL(other->getNChangedBins(), 2);
+
+  // merged through the generic algorithm, as the Mergers do
+  BOOST_CHECK_NO_THROW(algorithm::merge(target, other));
+  BOOST_CHECK_EQUAL(target->getNChangedBins(), 3);
+
+  // a consumer applies the merged delta to what it received before
+  TH2I* consumer = dynamic_cast<TH2I*>(previousA->Clone());
+  target->applyTo(*consumer);
+  BOOST_CHECK_EQUAL(consumer->GetBinContent(consumer->FindBin(1, 1)), 1);
+  BOOST_CHECK_EQUAL(consumer->GetBinContent(consumer->FindBin(2, 2)), 2);
+  BOOST_CHECK_EQUAL(consumer->GetBinContent(consumer->FindBin(3, 7)), 2);
+  BOOST_CHECK_EQUAL(consumer->GetBinContent(consumer->FindBin(8, 8)), 1);
+  BOOST_CHECK_EQUAL(consumer->GetEntries(), 6);
+  BOOST_CHECK_CLOSE(consumer->GetMean(1), (1 + 2 + 2 + 3 + 3 + 8) / 6.0, 0.001);
+
+  // deltas of different binnings cannot be merged
+  TH1I* histo1D = new TH1I("histo 1d", "histo 1d", bins, min, max);
+  HistogramDelta* wrongBinning = new HistogramDelta(*histo1D);
+  BOOST_CHECK_THROW(algorithm::merge(target, wrongBinning), std::runtime_error);
+  BOOST_CHECK_THROW(target->merge(nullptr), std::runtime_error);
+
+  delete sourceA;
+  delete sourceB;
+  delete previousA;
+  delete target;
+  delete other;
+  delete consumer;
+  delete histo1D;
+  delete wrongBinning;
+}
+
+BOOST_AUTO_TEST_CASE(MergerHistogramDeltasMixedSumw2)
+{
+  // the source enables Sumw2 only after the previous version was published
+  TH1D* source = new TH1D("histo 1d", "histo 1d", bins, min, max);
+  source->Fill(1);
+  source->Fill(1);
+  source->Fill(5);
+  auto* previous = dynamic_cast<TH1D*>(source->Clone());
+  BOOST_REQUIRE_EQUAL(previous->GetSumw2N(), 0);
+  source->Sumw2();
+  source->Fill(1, 3);
+  source->Fill(7, 2);
+
+  HistogramDelta* delta = new HistogramDelta(*source, previous);
+  BOOST_CHECK_EQUAL(delta->getNChangedBins(), 2);
+
+  TH1D* consumer = dynamic_cast<TH1D*>(previous->Clone());
+  delta->applyTo(*consumer);
+  for (int bin = 0; bin < source->GetNcells(); ++bin) {
+    BOOST_CHECK_EQUAL(consumer->GetBinContent(bin), source->GetBinContent(bin));
+    BOOST_CHECK_CLOSE(consumer->GetBinError(bin), source->GetBinError(bin), 0.001);
+  }
+  BOOST_CHECK_CLOSE(consumer->GetBinError(consumer->FindBin(1)), std::sqrt(1 + 1 + 9.0), 0.001);
+
+  delete source;
+  delete previous;
+  delete delta;
+  delete consumer;
+}
+
 BOOST_AUTO_TEST_CASE(Deleting)
 {
   TObjArray* main = new TObjArray();
@@ -187,6 +187,14 @@ if [ "$doreco" == "1" ]; then
   echo "Return status of ZDC reconstruction: $?"
 
   echo "Producing AOD"
-  taskwrapper aod.log o2-aod-producer-workflow --aod-writer-keep dangling --aod-writer-resfile "AO2D" --aod-writer-resmode UPDATE --aod-timeframe-id 1
+  taskwrapper aod.log o2-aod-producer-workflow --aod-writer-keep dangling --aod-writer-resfile "AO2D" --aod-writer-resmode UPDATE --aod-timeframe-id 1 --threads 2
   echo "Return status of AOD production: $?"
+
+  echo "Producing AOD serially, to check that the tables do not depend on the threads"
+  taskwrapper aod_serial.log o2-aod-producer-workflow --aod-writer-keep dangling --aod-writer-resfile "AO2D_serial" --aod-writer-resmode UPDATE --aod-timeframe-id 1 --threads 1
+  taskwrapper aod_compare.log root -b -q -l $O2_ROOT/share/macro/compareAODs.C
+  if grep -q "The AODs differ" aod_compare.log; then
+    echo "The AOD tables depend on the number of threads"
+    exit 1
+  fi
 fi